@@ -0,0 +1,74 @@
+/**
+ * \file	crc.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_CRC_H_
+#define LIB_ATLAS_IO_CRC_H_
+
+#include <lib_atlas/macros.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace atlas {
+
+/**
+ * Compute the CRC-16/CCITT-FALSE of a buffer (polynomial 0x1021, initial
+ * value 0xFFFF, no reflection, no final xor).
+ *
+ * The computation can be done in several steps by passing the result of the
+ * previous step as the initial value.
+ *
+ * For more informations:
+ * http://reveng.sourceforge.net/crc-catalogue/16.htm
+ *
+ * \param data The data to compute the CRC of.
+ * \param size The number of bytes in data.
+ * \param crc The initial value, or the CRC of the previous data.
+ * \return The CRC of the data.
+ */
+uint16_t Crc16(const uint8_t *data, size_t size,
+               uint16_t crc = 0xFFFF) ATLAS_NOEXCEPT;
+
+/**
+ * Compute the CRC-32 of a buffer, as used by Ethernet, zlib and PNG
+ * (reflected polynomial 0xEDB88320).
+ *
+ * This processes eight bytes per iteration with the slice-by-8 algorithm.
+ *
+ * The computation can be done in several steps by passing the result of the
+ * previous step as the initial value.
+ *
+ * \param data The data to compute the CRC of.
+ * \param size The number of bytes in data.
+ * \param crc Zero, or the CRC of the previous data.
+ * \return The CRC of the data.
+ */
+uint32_t Crc32(const uint8_t *data, size_t size,
+               uint32_t crc = 0) ATLAS_NOEXCEPT;
+
+}  // namespace atlas
+
+#include <lib_atlas/io/crc_inl.h>
+
+#endif  // LIB_ATLAS_IO_CRC_H_
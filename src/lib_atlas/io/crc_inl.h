@@ -0,0 +1,131 @@
+/**
+ * \file	crc_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_CRC_H_
+#error This file may only be included from crc.h
+#endif
+
+namespace atlas {
+
+namespace details {
+
+//------------------------------------------------------------------------------
+//
+struct Crc16Table {
+  uint16_t values[256];
+
+  Crc16Table() ATLAS_NOEXCEPT {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint16_t crc = static_cast<uint16_t>(i << 8);
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021
+                                                   : (crc << 1));
+      }
+      values[i] = crc;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+//
+struct Crc32Tables {
+  // values[k][i] is the CRC of the byte i followed by k zero bytes.
+  uint32_t values[8][256];
+
+  Crc32Tables() ATLAS_NOEXCEPT {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+      }
+      values[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+      for (int k = 1; k < 8; ++k) {
+        uint32_t previous = values[k - 1][i];
+        values[k][i] = (previous >> 8) ^ values[0][previous & 0xFF];
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE const Crc16Table &GetCrc16Table() ATLAS_NOEXCEPT {
+  static const Crc16Table table;
+  return table;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE const Crc32Tables &GetCrc32Tables() ATLAS_NOEXCEPT {
+  static const Crc32Tables tables;
+  return tables;
+}
+
+}  // namespace details
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint16_t Crc16(const uint8_t *data, size_t size,
+                            uint16_t crc) ATLAS_NOEXCEPT {
+  const uint16_t *table = details::GetCrc16Table().values;
+  for (size_t i = 0; i < size; ++i) {
+    crc = static_cast<uint16_t>((crc << 8) ^ table[(crc >> 8) ^ data[i]]);
+  }
+  return crc;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint32_t Crc32(const uint8_t *data, size_t size,
+                            uint32_t crc) ATLAS_NOEXCEPT {
+  const uint32_t(*table)[256] = details::GetCrc32Tables().values;
+  crc = ~crc;
+  // The words are assembled byte by byte so this works on any endianness,
+  // the compiler turns it into a single load on little endian targets.
+  while (size >= 8) {
+    uint32_t low = crc ^ (static_cast<uint32_t>(data[0]) |
+                          static_cast<uint32_t>(data[1]) << 8 |
+                          static_cast<uint32_t>(data[2]) << 16 |
+                          static_cast<uint32_t>(data[3]) << 24);
+    uint32_t high = static_cast<uint32_t>(data[4]) |
+                    static_cast<uint32_t>(data[5]) << 8 |
+                    static_cast<uint32_t>(data[6]) << 16 |
+                    static_cast<uint32_t>(data[7]) << 24;
+    crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^
+          table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24] ^
+          table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF] ^
+          table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+    data += 8;
+    size -= 8;
+  }
+  while (size-- != 0) {
+    crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+  }
+  return ~crc;
+}
+
+}  // namespace atlas
@@ -0,0 +1,100 @@
+/**
+ * \file	chunk_timestamps.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_CHUNK_TIMESTAMPS_H_
+#define LIB_ATLAS_IO_DETAILS_CHUNK_TIMESTAMPS_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <deque>
+
+namespace atlas {
+
+/**
+ * The reception time of the chunks of a byte stream that sits in a buffer.
+ *
+ * The bytes are identified by their position in the stream since the
+ * creation or the last Clear(), so the owner of the buffer can move them
+ * around freely. Knowing the position of the first byte of a line or a
+ * frame gives the time it arrived.
+ */
+class ChunkTimestamps {
+ public:
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  ChunkTimestamps() ATLAS_NOEXCEPT;
+
+  ~ChunkTimestamps() ATLAS_NOEXCEPT = default;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Append a chunk of size bytes received at the given time.
+   *
+   * The chunk is merged with the previous one if they have the same
+   * timestamp, e.g. 0 when the timestamps are not available.
+   */
+  void Push(size_t size, int64_t timestamp_ns);
+
+  /**
+   * Find when the byte at the given position arrived, and forget the chunks
+   * before it. The positions must thus be queried in increasing order.
+   *
+   * \return The timestamp of the chunk, 0 if the position is not known.
+   */
+  int64_t Find(uint64_t position) ATLAS_NOEXCEPT;
+
+  /**
+   * \return The position following the last byte pushed.
+   */
+  uint64_t GetEndPosition() const ATLAS_NOEXCEPT;
+
+  void Clear() ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Chunk {
+    /** The position following the last byte of the chunk. */
+    uint64_t end_position;
+    int64_t timestamp_ns;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::deque<Chunk> chunks_;
+
+  uint64_t end_position_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/details/chunk_timestamps_inl.h>
+
+#endif  // LIB_ATLAS_IO_DETAILS_CHUNK_TIMESTAMPS_H_
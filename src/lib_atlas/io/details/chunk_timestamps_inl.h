@@ -0,0 +1,82 @@
+/**
+ * \file	chunk_timestamps_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_CHUNK_TIMESTAMPS_H_
+#error This file may only be included from chunk_timestamps.h
+#endif
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ChunkTimestamps::ChunkTimestamps() ATLAS_NOEXCEPT
+    : chunks_(),
+      end_position_(0) {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ChunkTimestamps::Push(size_t size, int64_t timestamp_ns) {
+  if (size == 0) {
+    return;
+  }
+  end_position_ += size;
+  // Without timestamps, everything ends up in a single chunk that is never
+  // allocated again.
+  if (!chunks_.empty() && chunks_.back().timestamp_ns == timestamp_ns) {
+    chunks_.back().end_position = end_position_;
+  } else {
+    chunks_.push_back(Chunk{end_position_, timestamp_ns});
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t ChunkTimestamps::Find(uint64_t position) ATLAS_NOEXCEPT {
+  while (!chunks_.empty() && chunks_.front().end_position <= position) {
+    chunks_.pop_front();
+  }
+  return chunks_.empty() ? 0 : chunks_.front().timestamp_ns;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t ChunkTimestamps::GetEndPosition() const ATLAS_NOEXCEPT {
+  return end_position_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ChunkTimestamps::Clear() ATLAS_NOEXCEPT {
+  chunks_.clear();
+  end_position_ = 0;
+}
+
+}  // namespace atlas
@@ -0,0 +1,95 @@
+/**
+ * \file	deadline.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_DEADLINE_H_
+#define LIB_ATLAS_IO_DETAILS_DEADLINE_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <time.h>
+
+namespace atlas {
+
+/**
+ * A point in time after which an operation must give up.
+ *
+ * The deadline is kept as integer nanoseconds of CLOCK_MONOTONIC, so it is
+ * not affected when the wall clock is stepped by NTP or by a GPS fix, and
+ * computing the remaining time does not involve any floating point
+ * arithmetic nor allocation.
+ */
+class Deadline {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  static const int64_t kNanosecondsPerMillisecond = 1000000;
+
+  static const int64_t kNanosecondsPerSecond = 1000000000;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param timeout_ns The time from now until the deadline.
+   */
+  explicit Deadline(int64_t timeout_ns) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  static Deadline FromMilliseconds(int64_t timeout_ms) ATLAS_NOEXCEPT;
+
+  /**
+   * \return The current time of CLOCK_MONOTONIC in nanoseconds.
+   */
+  static int64_t Now() ATLAS_NOEXCEPT;
+
+  static timespec ToTimeSpec(int64_t ns) ATLAS_NOEXCEPT;
+
+  /**
+   * \return The time left until the deadline, 0 if it is passed.
+   */
+  int64_t RemainingNs() const ATLAS_NOEXCEPT;
+
+  bool IsExpired() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The deadline in nanoseconds of CLOCK_MONOTONIC.
+   */
+  int64_t GetTime() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  int64_t deadline_ns_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/details/deadline_inl.h>
+
+#endif  // LIB_ATLAS_IO_DETAILS_DEADLINE_H_
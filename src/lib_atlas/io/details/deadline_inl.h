@@ -0,0 +1,87 @@
+/**
+ * \file	deadline_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_DEADLINE_H_
+#error This file may only be included from deadline.h
+#endif
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Deadline::Deadline(int64_t timeout_ns) ATLAS_NOEXCEPT
+    : deadline_ns_(Now() + timeout_ns) {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE Deadline
+Deadline::FromMilliseconds(int64_t timeout_ms) ATLAS_NOEXCEPT {
+  return Deadline(timeout_ms * kNanosecondsPerMillisecond);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE int64_t Deadline::Now() ATLAS_NOEXCEPT {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * kNanosecondsPerSecond +
+         now.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE timespec Deadline::ToTimeSpec(int64_t ns) ATLAS_NOEXCEPT {
+  timespec time;
+  time.tv_sec = static_cast<time_t>(ns / kNanosecondsPerSecond);
+  time.tv_nsec = static_cast<long>(ns % kNanosecondsPerSecond);
+  return time;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE int64_t Deadline::RemainingNs() const ATLAS_NOEXCEPT {
+  int64_t remaining = deadline_ns_ - Now();
+  return remaining > 0 ? remaining : 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE bool Deadline::IsExpired() const ATLAS_NOEXCEPT {
+  return RemainingNs() == 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE int64_t Deadline::GetTime() const ATLAS_NOEXCEPT {
+  return deadline_ns_;
+}
+
+}  // namespace atlas
@@ -0,0 +1,202 @@
+/**
+ * \file	frame_prefetcher.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_FRAME_PREFETCHER_H_
+#define LIB_ATLAS_IO_DETAILS_FRAME_PREFETCHER_H_
+
+#include <lib_atlas/io/frame_pool.h>
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <lib_atlas/sys/latency_histogram.h>
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <opencv2/core/core.hpp>
+
+namespace atlas {
+
+/**
+ * The decoding counters of a file capture.
+ */
+struct DecodeStats {
+  /** The number of frames decoded. */
+  uint64_t frame_count;
+
+  /** The frames decoded per second of wall time, all threads together. */
+  double throughput;
+
+  /**
+   * The number of frames the capture asked for before they were decoded,
+   * 0 if the decoding keeps up with the capture.
+   */
+  uint64_t stall_count;
+};
+
+/**
+ * Decode the frames of a file a given number of frames ahead of the one
+ * read, on a pool of threads.
+ *
+ * The frames are decoded by a function that takes the index of the frame.
+ * With several threads the frames are decoded out of order, so the function
+ * must be able to decode any frame. With a single thread, it is called with
+ * the indexes in increasing order and may read a stream sequentially.
+ *
+ * The frames are still returned in order by Next().
+ *
+ * The frames are decoded in the buffers of a FramePool, created with the
+ * geometry of the first frame, so a replay does not allocate an image per
+ * frame once the pool is warm.
+ */
+class FramePrefetcher {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  /**
+   * Decode the frame of the given index in the given image. The image holds
+   * the buffer of an older frame, to decode into when the geometry is the
+   * same. Returns false past the end of the sequence.
+   */
+  using DecodeFunction = std::function<bool(size_t, cv::Mat &)>;
+
+  /**
+   * The number of frames of the pool beside the ones decoded ahead, for the
+   * frames held by the capture and its observers.
+   */
+  static const size_t kSpareFrameCount = 4;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param decode The function decoding a frame.
+   * \param depth The number of frames decoded ahead.
+   * \param thread_count The number of decoding threads.
+   *
+   * \throw std::invalid_argument if the depth or the thread count is 0.
+   */
+  FramePrefetcher(DecodeFunction decode, size_t depth, size_t thread_count);
+
+  /**
+   * Wait for the frames being decoded.
+   */
+  ~FramePrefetcher() ATLAS_NOEXCEPT;
+
+  FramePrefetcher(const FramePrefetcher &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  FramePrefetcher &operator=(const FramePrefetcher &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Wait for the next frame if it is not decoded yet, and start the decoding
+   * of the one after the prefetched ones.
+   *
+   * \return The next frame, null at the end of the sequence.
+   */
+  FramePool::Frame Next();
+
+  /**
+   * \return True once Next() returned the end of the sequence.
+   */
+  bool IsAtEnd() const ATLAS_NOEXCEPT;
+
+  DecodeStats GetStats() const;
+
+  /**
+   * \return The distribution of the decoding time of one frame.
+   */
+  const LatencyHistogram &GetDecodeLatency() const ATLAS_NOEXCEPT;
+
+  void ResetStats() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The pool of the decoded frames, null until a frame is decoded.
+   */
+  FramePool::Ptr GetFramePool() const;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /** Start the decoding of the frames up to the prefetch depth. */
+  void Schedule();
+
+  /** Decode a frame on a thread of the pool and update the counters. */
+  FramePool::Frame Decode(size_t index);
+
+  /** A frame of the pool, or a new one before the pool is created. */
+  FramePool::Frame AcquireFrame();
+
+  /** Create the pool with the geometry of a decoded frame. */
+  void CreateFramePool(const cv::Mat &frame);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  DecodeFunction decode_;
+
+  const size_t depth_;
+
+  /** The frames being decoded, in the order of the sequence. */
+  std::deque<std::future<FramePool::Frame>> pending_;
+
+  /** The index of the next frame to decode. */
+  size_t next_index_;
+
+  /** Written by Next(), read by IsAtEnd() from any thread. */
+  std::atomic<bool> at_end_;
+
+  LatencyHistogram decode_latency_;
+
+  std::atomic<uint64_t> frame_count_;
+
+  std::atomic<uint64_t> stall_count_;
+
+  /** The first decoding since the creation or the last ResetStats(). */
+  std::atomic<int64_t> first_decode_ns_;
+
+  std::atomic<int64_t> last_decode_ns_;
+
+  mutable std::mutex frame_pool_mutex_;
+
+  FramePool::Ptr frame_pool_;
+
+  /** Last, so the threads stop before the members they use are destroyed. */
+  ThreadPool pool_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/details/frame_prefetcher_inl.h>
+
+#endif  // LIB_ATLAS_IO_DETAILS_FRAME_PREFETCHER_H_
@@ -0,0 +1,191 @@
+/**
+ * \file	frame_prefetcher_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_FRAME_PREFETCHER_H_
+#error This file may only be included from frame_prefetcher.h
+#endif
+
+#include <lib_atlas/io/details/deadline.h>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePrefetcher::FramePrefetcher(DecodeFunction decode,
+                                              size_t depth,
+                                              size_t thread_count)
+    : decode_(std::move(decode)),
+      depth_(depth),
+      pending_(),
+      next_index_(0),
+      at_end_(false),
+      decode_latency_(),
+      frame_count_(0),
+      stall_count_(0),
+      first_decode_ns_(0),
+      last_decode_ns_(0),
+      frame_pool_mutex_(),
+      frame_pool_(),
+      pool_(thread_count) {
+  if (depth == 0 || thread_count == 0) {
+    throw std::invalid_argument(
+        "The depth and the thread count must be greater than 0.");
+  }
+  Schedule();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePrefetcher::~FramePrefetcher() ATLAS_NOEXCEPT {
+  for (std::future<FramePool::Frame> &frame : pending_) {
+    frame.wait();
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePool::Frame FramePrefetcher::Next() {
+  if (at_end_ || pending_.empty()) {
+    return nullptr;
+  }
+  std::future<FramePool::Frame> next = std::move(pending_.front());
+  pending_.pop_front();
+  if (next.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    ++stall_count_;
+  }
+  FramePool::Frame frame = next.get();
+  if (frame == nullptr) {
+    // The frames after the end are empty as well.
+    at_end_ = true;
+    return frame;
+  }
+  Schedule();
+  return frame;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePrefetcher::Schedule() {
+  while (pending_.size() < depth_) {
+    pending_.push_back(
+        pool_.Enqueue(&FramePrefetcher::Decode, this, next_index_++));
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePool::Frame FramePrefetcher::Decode(size_t index) {
+  int64_t start_ns = Deadline::Now();
+  int64_t first_ns = 0;
+  first_decode_ns_.compare_exchange_strong(first_ns, start_ns);
+  FramePool::Frame frame = AcquireFrame();
+  if (!decode_(index, *frame) || frame->empty()) {
+    return nullptr;
+  }
+  int64_t end_ns = Deadline::Now();
+  decode_latency_.Record(end_ns - start_ns);
+  ++frame_count_;
+  last_decode_ns_ = end_ns;
+  CreateFramePool(*frame);
+  return frame;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePool::Frame FramePrefetcher::AcquireFrame() {
+  FramePool::Ptr frame_pool = GetFramePool();
+  if (frame_pool == nullptr) {
+    return std::make_shared<cv::Mat>();
+  }
+  return frame_pool->Acquire();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePrefetcher::CreateFramePool(const cv::Mat &frame) {
+  std::lock_guard<std::mutex> lock(frame_pool_mutex_);
+  // Only once, a sequence whose geometry changes reallocates the buffers of
+  // the frames that do not match rather than recreating the pool.
+  if (frame_pool_ == nullptr) {
+    const size_t capacity = depth_ + kSpareFrameCount;
+    frame_pool_ =
+        std::make_shared<FramePool>(frame.size(), frame.type(), capacity);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePool::Ptr FramePrefetcher::GetFramePool() const {
+  std::lock_guard<std::mutex> lock(frame_pool_mutex_);
+  return frame_pool_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FramePrefetcher::IsAtEnd() const ATLAS_NOEXCEPT {
+  return at_end_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE DecodeStats FramePrefetcher::GetStats() const {
+  DecodeStats stats;
+  stats.frame_count = frame_count_;
+  stats.stall_count = stall_count_;
+  int64_t elapsed_ns = last_decode_ns_ - first_decode_ns_;
+  stats.throughput = elapsed_ns <= 0
+                         ? 0.0
+                         : static_cast<double>(stats.frame_count) *
+                               Deadline::kNanosecondsPerSecond / elapsed_ns;
+  return stats;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const LatencyHistogram &FramePrefetcher::GetDecodeLatency() const
+    ATLAS_NOEXCEPT {
+  return decode_latency_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePrefetcher::ResetStats() ATLAS_NOEXCEPT {
+  decode_latency_.Reset();
+  frame_count_ = 0;
+  stall_count_ = 0;
+  first_decode_ns_ = 0;
+  last_decode_ns_ = 0;
+}
+
+}  // namespace atlas
@@ -0,0 +1,183 @@
+/**
+ * \file	serial_async_writer.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_SERIAL_ASYNC_WRITER_H_
+#define LIB_ATLAS_IO_DETAILS_SERIAL_ASYNC_WRITER_H_
+
+#include <lib_atlas/pattern/lock_free_queue.h>
+#include <lib_atlas/pattern/queue_policy.h>
+#include <lib_atlas/pattern/runnable.h>
+#include <sys/uio.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace atlas {
+
+class Serial;
+
+/**
+ * The thread writing the buffers queued with Serial::WriteAsync().
+ *
+ * The producers push their buffers in a lock free queue. The writer pops all
+ * the buffers available and sends them with a single writev, so a burst of
+ * small commands costs a single system call. The producers only take a lock
+ * when the writer is sleeping and must be woken up, or when they have to
+ * wait for room with the BLOCK policy.
+ */
+class Serial::AsyncWriter : public Runnable {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<Serial::AsyncWriter>;
+
+  /** The maximum number of buffers sent in a single writev. */
+  static const size_t kMaxBatchSize = 64;
+
+  /** The longest the writer sleeps without checking the queue. */
+  static const int kIdleCheckPeriodMs = 100;
+
+  /** The written buffers up to this capacity are kept for the next pushes,
+   * the larger ones are freed so a single large write does not pin memory.
+   */
+  static const size_t kMaxRecycledCapacity = 4096;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  AsyncWriter(Serial &serial, size_t capacity, QueuePolicy policy);
+
+  /**
+   * Write the buffers still in the queue, then stop the thread.
+   */
+  virtual ~AsyncWriter() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Queue a buffer, applying the policy if the queue is full.
+   *
+   * \return False if the buffer was refused by the FAIL policy.
+   */
+  bool Push(std::vector<uint8_t> &&data);
+
+  /**
+   * Copy the data in a buffer already written when there is one, so the
+   * steady state does not allocate, and queue it.
+   */
+  bool Push(const uint8_t *data, size_t size);
+
+  /**
+   * Wait until all the buffers queued have been written or dropped.
+   *
+   * \return False if the timeout expired first.
+   */
+  bool WaitIdle(uint32_t timeout_ms);
+
+  size_t QueueDepth() const ATLAS_NOEXCEPT;
+
+  uint64_t DropCount() const ATLAS_NOEXCEPT;
+
+  uint64_t ErrorCount() const ATLAS_NOEXCEPT;
+
+  uint64_t WriteCallCount() const ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void Run() override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Pop the available buffers and write them.
+   *
+   * \return False if the queue was empty.
+   */
+  bool WriteBatch();
+
+  void WakeUpWriter();
+
+  /** Account for buffers that left the queue, written or not. */
+  void Complete(uint64_t count);
+
+  /** Keep a buffer that left the queue for a later Push(). */
+  void Recycle(std::vector<uint8_t> &&buffer);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  Serial &serial_;
+
+  QueuePolicy policy_;
+
+  LockFreeQueue<std::vector<uint8_t>> queue_;
+
+  /** Empty buffers with their capacity, given back by the writer. */
+  LockFreeQueue<std::vector<uint8_t>> free_buffers_;
+
+  /** The buffers being written and their iovec, only used by the writer. */
+  std::vector<std::vector<uint8_t>> batch_;
+  std::vector<iovec> iov_;
+
+  std::mutex mutex_;
+
+  /** Wakes up the writer when a buffer is pushed. */
+  std::condition_variable data_condition_;
+
+  /** Wakes up the producers blocked on a full queue. */
+  std::condition_variable space_condition_;
+
+  /** Wakes up the callers of WaitIdle(). */
+  std::condition_variable idle_condition_;
+
+  std::atomic<bool> writer_sleeping_;
+
+  std::atomic<bool> stopping_;
+
+  std::atomic<int> blocked_producers_;
+
+  std::atomic<uint64_t> pushed_count_;
+
+  std::atomic<uint64_t> completed_count_;
+
+  std::atomic<uint64_t> drop_count_;
+
+  std::atomic<uint64_t> error_count_;
+
+  std::atomic<uint64_t> write_call_count_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/details/serial_async_writer_inl.h>
+
+#endif  // LIB_ATLAS_IO_DETAILS_SERIAL_ASYNC_WRITER_H_
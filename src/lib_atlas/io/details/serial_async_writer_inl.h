@@ -0,0 +1,268 @@
+/**
+ * \file	serial_async_writer_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_DETAILS_SERIAL_ASYNC_WRITER_H_
+#error This file may only be included from serial_async_writer.h
+#endif
+
+#include <chrono>
+#include <exception>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Serial::AsyncWriter::AsyncWriter(Serial &serial, size_t capacity,
+                                              QueuePolicy policy)
+    : serial_(serial),
+      policy_(policy),
+      queue_(capacity),
+      free_buffers_(capacity),
+      batch_(),
+      iov_(),
+      mutex_(),
+      data_condition_(),
+      space_condition_(),
+      idle_condition_(),
+      writer_sleeping_(false),
+      stopping_(false),
+      blocked_producers_(0),
+      pushed_count_(0),
+      completed_count_(0),
+      drop_count_(0),
+      error_count_(0),
+      write_call_count_(0) {
+  batch_.reserve(kMaxBatchSize);
+  iov_.reserve(kMaxBatchSize);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE Serial::AsyncWriter::~AsyncWriter() ATLAS_NOEXCEPT {
+  if (IsRunning()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    data_condition_.notify_one();
+    Stop();
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::AsyncWriter::Push(std::vector<uint8_t> &&data) {
+  // Counted before it is visible to the writer so the completed count never
+  // gets ahead of it.
+  ++pushed_count_;
+  if (policy_ == QueuePolicy::KEEP_LATEST) {
+    std::vector<uint8_t> stale;
+    while (queue_.TryPop(stale)) {
+      ++drop_count_;
+      Complete(1);
+      Recycle(std::move(stale));
+    }
+  }
+  while (!queue_.TryPush(std::move(data))) {
+    if (policy_ == QueuePolicy::FAIL || policy_ == QueuePolicy::DROP_NEWEST) {
+      --pushed_count_;
+      ++drop_count_;
+      Complete(0);
+      return false;
+    } else if (policy_ == QueuePolicy::DROP_OLDEST ||
+               policy_ == QueuePolicy::KEEP_LATEST) {
+      std::vector<uint8_t> oldest;
+      if (queue_.TryPop(oldest)) {
+        ++drop_count_;
+        Complete(1);
+        Recycle(std::move(oldest));
+      }
+    } else {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ++blocked_producers_;
+      // The timeout only guards against a wake up sent right before we
+      // started to wait, the writer notifies as soon as it pops buffers.
+      space_condition_.wait_for(lock, std::chrono::milliseconds(1), [this] {
+        return queue_.Size() < queue_.Capacity();
+      });
+      --blocked_producers_;
+    }
+  }
+  WakeUpWriter();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::AsyncWriter::Push(const uint8_t *data,
+                                            size_t size) {
+  std::vector<uint8_t> buffer;
+  free_buffers_.TryPop(buffer);
+  buffer.assign(data, data + size);
+  return Push(std::move(buffer));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::AsyncWriter::WaitIdle(uint32_t timeout_ms) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return idle_condition_.wait_for(
+      lock, std::chrono::milliseconds(timeout_ms),
+      [this] { return completed_count_ == pushed_count_; });
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::AsyncWriter::QueueDepth() const ATLAS_NOEXCEPT {
+  return queue_.Size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t Serial::AsyncWriter::DropCount() const ATLAS_NOEXCEPT {
+  return drop_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t Serial::AsyncWriter::ErrorCount() const ATLAS_NOEXCEPT {
+  return error_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t Serial::AsyncWriter::WriteCallCount() const
+    ATLAS_NOEXCEPT {
+  return write_call_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::AsyncWriter::Run() {
+  while (true) {
+    if (WriteBatch()) {
+      continue;
+    }
+    // The queue is only left once it is empty, so nothing pushed before
+    // the destruction is lost.
+    if (stopping_ || MustStop()) {
+      break;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    writer_sleeping_ = true;
+    // Pairs with the fence of WakeUpWriter(): either the producer sees that
+    // we sleep, or we see its buffer.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (queue_.IsEmpty() && !stopping_) {
+      // Read by value, the constant has no definition the constructor of
+      // the duration could bind its reference to.
+      const int period_ms = kIdleCheckPeriodMs;
+      data_condition_.wait_for(lock, std::chrono::milliseconds(period_ms));
+    }
+    writer_sleeping_ = false;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::AsyncWriter::WriteBatch() {
+  batch_.clear();
+  iov_.clear();
+  std::vector<uint8_t> data;
+  while (batch_.size() < kMaxBatchSize && queue_.TryPop(data)) {
+    batch_.push_back(std::move(data));
+  }
+  if (batch_.empty()) {
+    return false;
+  }
+  if (blocked_producers_ > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    space_condition_.notify_all();
+  }
+
+  size_t length = 0;
+  for (std::vector<uint8_t> &buffer : batch_) {
+    if (!buffer.empty()) {
+      iov_.push_back(iovec{buffer.data(), buffer.size()});
+      length += buffer.size();
+    }
+  }
+  if (!iov_.empty()) {
+    try {
+      ++write_call_count_;
+      if (serial_.writev_(iov_.data(), static_cast<int>(iov_.size())) <
+          length) {
+        ++error_count_;  // The write timeout expired.
+      }
+    } catch (const std::exception &) {
+      // There is nobody to report to, the error is counted and the writer
+      // carries on with the next buffers.
+      ++error_count_;
+    }
+  }
+  // Recycled first, a producer woken up by the completion finds them.
+  const size_t count = batch_.size();
+  for (std::vector<uint8_t> &buffer : batch_) {
+    Recycle(std::move(buffer));
+  }
+  Complete(count);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::AsyncWriter::WakeUpWriter() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (writer_sleeping_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    data_condition_.notify_one();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::AsyncWriter::Complete(uint64_t count) {
+  if ((completed_count_ += count) == pushed_count_) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_condition_.notify_all();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::AsyncWriter::Recycle(std::vector<uint8_t> &&buffer) {
+  if (buffer.capacity() != 0 && buffer.capacity() <= kMaxRecycledCapacity) {
+    buffer.clear();
+    free_buffers_.TryPush(std::move(buffer));
+  }
+}
+
+}  // namespace atlas
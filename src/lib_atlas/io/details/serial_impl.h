@@ -31,7 +31,7 @@
  * \section DESCRIPTION
  *
  * This provides a unix based pimpl for the Serial class. This implementation is
- * based off termios.h and uses select for multiplexing the IO ports.
+ * based off termios.h and uses poll for multiplexing the IO ports.
  *
  */
 
@@ -40,7 +40,10 @@
 
 #include <lib_atlas/exceptions.h>
 #include <pthread.h>
+#include <sys/uio.h>
+#include <atomic>
 #include <memory>
+#include <vector>
 
 namespace atlas {
 
@@ -71,6 +74,8 @@ class Serial::SerialImpl {
 
   bool IsOpen() const;
 
+  int GetFileDescriptor() const;
+
   size_t Available();
 
   bool WaitReadable(uint32_t timeout);
@@ -79,8 +84,53 @@ class Serial::SerialImpl {
 
   size_t Read(uint8_t *buf, size_t size = 1);
 
+  size_t ReadSome(uint8_t *buf, size_t size, uint32_t timeout);
+
   size_t Write(const uint8_t *data, size_t length);
 
+  /**
+   * The non throwing versions of the above, the throwing ones are built on
+   * them. The errors cost no allocation.
+   */
+  IOResult TryAvailable();
+
+  IOResult TryWaitReadable(uint32_t timeout);
+
+  IOResult TryRead(uint8_t *buf, size_t size);
+
+  IOResult TryWrite(const uint8_t *data, size_t length);
+
+  /**
+   * Throw the exception matching the status of a failed operation.
+   *
+   * \param operation The name of the operation, e.g. "read".
+   *
+   * \return The number of bytes transferred if the operation succeeded or
+   *         timed out.
+   */
+  static size_t ThrowOnError(const IOResult &result, const char *operation);
+
+  void SetTimestamping(bool enabled);
+
+  bool IsTimestamping() const;
+
+  /**
+   * \return The CLOCK_MONOTONIC time at which the first byte of the last
+   *         Read() or ReadSome() was received, 0 if nothing was read or the
+   *         timestamping is disabled.
+   */
+  int64_t GetReadTimestamp() const;
+
+  /**
+   * Write the buffers in order with writev, with the timeout of a Write of
+   * all of them.
+   *
+   * The buffer written in part is cut in place for the next call and
+   * restored right after it, the array is unchanged on return. This saves
+   * a copy of the array on each call.
+   */
+  size_t WriteV(iovec *iov, int count);
+
   void Flush();
 
   void FlushInput();
@@ -133,6 +183,10 @@ class Serial::SerialImpl {
 
   flowcontrol_t GetFlowcontrol() const;
 
+  void SetLatency(latency_t latency);
+
+  latency_t GetLatency() const;
+
   void ReadLock();
 
   void ReadUnlock();
@@ -147,6 +201,17 @@ class Serial::SerialImpl {
 
   void ReconfigurePort();
 
+  /**
+   * Wait with ppoll for the given events on the port.
+   *
+   * \param wakeup_ns If not null, set to the time the port was seen ready,
+   *        the read path uses it as the arrival time of the data.
+   * \return status_ok if the port is ready, status_timeout on a timeout or
+   *         an interruption, status_io_error with errno set on a failure.
+   */
+  status_t Poll(short events, int64_t timeout_ns,
+                int64_t *wakeup_ns = nullptr);
+
  private:
   //============================================================================
   // P R I V A T E   M E M B E R S
@@ -166,6 +231,12 @@ class Serial::SerialImpl {
   bytesize_t bytesize_;        // Size of the bytes
   stopbits_t stopbits_;        // Stop Bits
   flowcontrol_t flowcontrol_;  // Flow Control
+  latency_t latency_;          // Latency profile
+  bool driver_low_latency_;    // We set ASYNC_LOW_LATENCY on the driver
+
+  // Timestamp the received data, set without the read lock
+  std::atomic<bool> timestamping_;
+  int64_t read_timestamp_ns_;  // When the first byte of the last read came
 
   // TODO: Use the mutex from mutex.h
   // Mutex used to lock the read functions
@@ -35,6 +35,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <lib_atlas/exceptions.h>
 #include <paths.h>
 #include <pthread.h>
@@ -46,13 +47,14 @@
 #include <sysexits.h>
 #include <termios.h>
 #include <unistd.h>
+#include <algorithm>
 #include <sstream>
 
 #if defined(__linux__)
 #include <linux/serial.h>
 #endif
 
-#include <sys/select.h>
+#include <poll.h>
 #include <sys/time.h>
 #include <time.h>
 #ifdef __MACH__
@@ -61,7 +63,7 @@
 #include <mach/mach.h>
 #endif
 
-#include <lib_atlas/sys/timer.h>
+#include <lib_atlas/io/details/deadline.h>
 
 #ifndef TIOCINQ
 #ifdef FIONREAD
@@ -95,7 +97,11 @@ ATLAS_INLINE Serial::SerialImpl::SerialImpl(
       parity_(parity),
       bytesize_(bytesize),
       stopbits_(stopbits),
-      flowcontrol_(flowcontrol) {
+      flowcontrol_(flowcontrol),
+      latency_(latency_default),
+      driver_low_latency_(false),
+      timestamping_(false),
+      read_timestamp_ns_(0) {
   pthread_mutex_init(&read_mutex, NULL);
   pthread_mutex_init(&write_mutex, NULL);
   if (port_.empty() == false) {
@@ -499,11 +505,32 @@ ATLAS_INLINE void Serial::SerialImpl::ReconfigurePort() {
 
   // http://www.unixwiz.net/techtips/termios-vmin-vtime.html
   // this basically sets the read call up to be a polling read,
-  // but we are using select to ensure there is data available
+  // but we are using poll to ensure there is data available
   // to read before each call, so we should never needlessly poll
   options.c_cc[VMIN] = 0;
   options.c_cc[VTIME] = 0;
 
+#if defined(__linux__) && defined(ASYNC_LOW_LATENCY)
+  // Only touch the flag if we own it, it may have been set with setserial.
+  if (latency_ == latency_low || driver_low_latency_) {
+    struct serial_struct ser;
+    // The pseudo terminals and some adapters do not support this, the
+    // profile then only changes the way we read.
+    if (ioctl(fd_, TIOCGSERIAL, &ser) != -1) {
+      bool was_set = (ser.flags & ASYNC_LOW_LATENCY) != 0;
+      if (latency_ == latency_low) {
+        ser.flags |= ASYNC_LOW_LATENCY;
+      } else {
+        ser.flags &= ~ASYNC_LOW_LATENCY;
+      }
+      if (ioctl(fd_, TIOCSSERIAL, &ser) != -1) {
+        driver_low_latency_ =
+            latency_ == latency_low && (!was_set || driver_low_latency_);
+      }
+    }
+  }
+#endif
+
   // activate settings
   ::tcsetattr(fd_, TCSANOW, &options);
 
@@ -539,65 +566,123 @@ ATLAS_INLINE void Serial::SerialImpl::Close() {
 //
 ATLAS_INLINE bool Serial::SerialImpl::IsOpen() const { return is_open_; }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int Serial::SerialImpl::GetFileDescriptor() const { return fd_; }
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::SerialImpl::Available() {
   if (!is_open_) {
     return 0;
   }
+  return ThrowOnError(TryAvailable(), "available");
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::SerialImpl::TryAvailable() {
+  if (!is_open_) {
+    return IOResult{status_not_open, 0, 0};
+  }
   int count = 0;
   if (-1 == ioctl(fd_, TIOCINQ, &count)) {
-    ATLAS_THROW(IOException, errno);
-  } else {
-    return static_cast<size_t>(count);
+    return IOResult{status_io_error, 0, errno};
   }
+  return IOResult{status_ok, static_cast<size_t>(count), 0};
 }
 
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE bool Serial::SerialImpl::WaitReadable(uint32_t timeout) {
-  // Setup a select call to block for serial data or a timeout
-  fd_set readfds;
-  FD_ZERO(&readfds);
-  FD_SET(fd_, &readfds);
-  timespec timeout_ts(MilliTimer::TimeSpecFromMs(timeout));
-  int r = pselect(fd_ + 1, &readfds, NULL, NULL, &timeout_ts, NULL);
+  IOResult result = TryWaitReadable(timeout);
+  ThrowOnError(result, "waitReadable");
+  return result.status == status_ok;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::SerialImpl::TryWaitReadable(uint32_t timeout) {
+  if (!is_open_) {
+    return IOResult{status_not_open, 0, 0};
+  }
+  status_t status =
+      Poll(POLLIN, timeout * Deadline::kNanosecondsPerMillisecond);
+  return IOResult{status, 0, status == status_io_error ? errno : 0};
+}
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE status_t Serial::SerialImpl::Poll(short events,
+                                               int64_t timeout_ns,
+                                               int64_t *wakeup_ns) {
+  pollfd descriptor = {fd_, events, 0};
+#if defined(__linux__)
+  timespec timeout = Deadline::ToTimeSpec(timeout_ns);
+  int r = ppoll(&descriptor, 1, &timeout, NULL);
+#else
+  // Round up so the caller never wakes up before its deadline.
+  int r = poll(&descriptor, 1,
+               static_cast<int>((timeout_ns + 999999) /
+                                Deadline::kNanosecondsPerMillisecond));
+#endif
   if (r < 0) {
-    // Select was interrupted
-    if (errno == EINTR) {
-      return false;
-    }
-    // Otherwise there was some error
-    ATLAS_THROW(IOException, errno);
+    // Interrupted, the caller checks its deadline and calls again.
+    return errno == EINTR ? status_timeout : status_io_error;
   }
-  // Timeout occurred
   if (r == 0) {
-    return false;
+    return status_timeout;
   }
-  // This shouldn't happen, if r > 0 our fd has to be in the list!
-  if (!FD_ISSET(fd_, &readfds)) {
-    ATLAS_THROW(IOException,
-                "select reports ready to read, but our fd isn't"
-                " in the list, this shouldn't happen!");
+  if (wakeup_ns != nullptr) {
+    // As close as we can get to the arrival of the data.
+    *wakeup_ns = Deadline::Now();
   }
-  // Data available to read.
-  return true;
+  // An error or a hang up is reported as ready, the following read or
+  // write fails and reports it.
+  return status_ok;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::ThrowOnError(const IOResult &result,
+                                                     const char *operation) {
+  switch (result.status) {
+    case status_ok:
+    case status_timeout:
+      break;
+    case status_not_open:
+      throw PortNotOpenedException(
+          (std::string("Serial::") + operation).c_str());
+    case status_disconnected:
+      throw SerialException((std::string("device reports readiness to ") +
+                             operation +
+                             " but returned no data (device disconnected?)")
+                                .c_str());
+    case status_io_error:
+      ATLAS_THROW(IOException, result.error);
+  }
+  return result.bytes;
 }
 
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE void Serial::SerialImpl::WaitByteTimes(size_t count) {
-  timespec wait_time = {0, static_cast<long>(byte_time_ns_ * count)};
-  pselect(0, NULL, NULL, NULL, &wait_time, NULL);
+  timespec wait_time =
+      Deadline::ToTimeSpec(static_cast<int64_t>(byte_time_ns_) * count);
+  nanosleep(&wait_time, NULL);
 }
 
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
-  // If the port is not open, throw
+  return ThrowOnError(TryRead(buf, size), "read");
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::SerialImpl::TryRead(uint8_t *buf, size_t size) {
   if (!is_open_) {
-    throw PortNotOpenedException("Serial::read");
+    return IOResult{status_not_open, 0, 0};
   }
   size_t bytes_read = 0;
 
@@ -605,157 +690,256 @@ ATLAS_INLINE size_t Serial::SerialImpl::Read(uint8_t *buf, size_t size) {
   long total_timeout_ms = timeout_.read_timeout_constant;
   total_timeout_ms +=
       timeout_.read_timeout_multiplier * static_cast<long>(size);
-  MilliTimer total_timeout(total_timeout_ms);
+  Deadline deadline = Deadline::FromMilliseconds(total_timeout_ms);
+  const int64_t inter_byte_timeout_ns =
+      static_cast<int64_t>(timeout_.inter_byte_timeout) *
+      Deadline::kNanosecondsPerMillisecond;
+
+  read_timestamp_ns_ = 0;
+  const bool timestamping = timestamping_;
+  int64_t wakeup_ns = 0;
 
   // Pre-fill buffer with available bytes
   {
     ssize_t bytes_read_now = ::read(fd_, buf, size);
     if (bytes_read_now > 0) {
       bytes_read = bytes_read_now;
+      if (timestamping) {
+        // Nobody was waiting, the data arrived at some point before.
+        read_timestamp_ns_ = Deadline::Now();
+      }
     }
   }
 
   while (bytes_read < size) {
-    int64_t timeout_remaining_ms = total_timeout.Remaining();
-    if (timeout_remaining_ms <= 0) {
+    int64_t timeout_remaining_ns = deadline.RemainingNs();
+    if (timeout_remaining_ns <= 0) {
       // Timed out
-      break;
+      return IOResult{status_timeout, bytes_read, 0};
     }
-    // Timeout for the next select is whichever is less of the remaining
+    // Timeout for the next poll is whichever is less of the remaining
     // total read timeout and the inter-byte timeout.
-    uint32_t timeout = std::min(static_cast<uint32_t>(timeout_remaining_ms),
-                                timeout_.inter_byte_timeout);
+    int64_t timeout_ns = std::min(timeout_remaining_ns, inter_byte_timeout_ns);
     // Wait for the device to be readable, and then attempt to read.
-    if (WaitReadable(timeout)) {
-      // If it's a fixed-length multi-byte read, insert a wait here so that
-      // we can attempt to grab the whole thing in a single IO call. Skip
-      // this wait if a non-max inter_byte_timeout is specified.
-      if (size > 1 && timeout_.inter_byte_timeout == Timeout::max()) {
-        size_t bytes_available = Available();
-        if (bytes_available + bytes_read < size) {
-          WaitByteTimes(size - (bytes_available + bytes_read));
-        }
-      }
-      // This should be non-blocking returning only what is available now
-      //  Then returning so that select can block again.
-      ssize_t bytes_read_now = ::read(fd_, buf + bytes_read, size - bytes_read);
-      // read should always return some data as select reported it was
-      // ready to read when we get to this point.
-      if (bytes_read_now < 1) {
-        // Disconnected devices, at least on Linux, show the
-        // behavior that they are always ready to read immediately
-        // but reading returns nothing.
-        throw SerialException(
-            "device reports readiness to read but "
-            "returned no data (device disconnected?)");
-      }
-      // Update bytes_read
-      bytes_read += static_cast<size_t>(bytes_read_now);
-      // If bytes_read == size then we have read everything we need
-      if (bytes_read == size) {
-        break;
-      }
-      // If bytes_read < size then we have more to read
-      if (bytes_read < size) {
-        continue;
-      }
-      // If bytes_read > size then we have over read, which shouldn't happen
-      if (bytes_read > size) {
-        throw SerialException(
-            "read over read, too many bytes where "
-            "read, this shouldn't happen, might be "
-            "a logical error!");
+    status_t status =
+        Poll(POLLIN, timeout_ns, timestamping ? &wakeup_ns : nullptr);
+    if (status == status_io_error) {
+      return IOResult{status, bytes_read, errno};
+    }
+    if (status != status_ok) {
+      continue;
+    }
+    // If it's a fixed-length multi-byte read, insert a wait here so that
+    // we can attempt to grab the whole thing in a single IO call. Skip
+    // this wait if a non-max inter_byte_timeout is specified, or if the
+    // latency matters more than the number of calls.
+    if (size > 1 && timeout_.inter_byte_timeout == Timeout::max() &&
+        latency_ != latency_low) {
+      int count = 0;
+      if (ioctl(fd_, TIOCINQ, &count) != -1 &&
+          static_cast<size_t>(count) + bytes_read < size) {
+        WaitByteTimes(size - (count + bytes_read));
       }
     }
+    // This should be non-blocking returning only what is available now
+    //  Then returning so that poll can block again.
+    ssize_t bytes_read_now = ::read(fd_, buf + bytes_read, size - bytes_read);
+    // read should always return some data as poll reported it was
+    // ready to read when we get to this point.
+    if (bytes_read_now < 1) {
+      // Disconnected devices, at least on Linux, show the
+      // behavior that they are always ready to read immediately
+      // but reading returns nothing.
+      return IOResult{status_disconnected, bytes_read, 0};
+    }
+    if (bytes_read == 0 && timestamping) {
+      read_timestamp_ns_ = wakeup_ns;
+    }
+    bytes_read += static_cast<size_t>(bytes_read_now);
   }
-  return bytes_read;
+  return IOResult{status_ok, bytes_read, 0};
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::ReadSome(uint8_t *buf, size_t size,
+                                                 uint32_t timeout) {
+  if (!is_open_) {
+    throw PortNotOpenedException("Serial::readSome");
+  }
+  read_timestamp_ns_ = 0;
+  if (size == 0) {
+    return 0;
+  }
+  const bool timestamping = timestamping_;
+  // Try first without waiting, the data are often already there.
+  ssize_t bytes_read = ::read(fd_, buf, size);
+  if (bytes_read > 0) {
+    if (timestamping) {
+      read_timestamp_ns_ = Deadline::Now();
+    }
+    return static_cast<size_t>(bytes_read);
+  }
+  if (timeout == 0) {
+    return 0;
+  }
+  int64_t wakeup_ns = 0;
+  status_t status = Poll(POLLIN, timeout * Deadline::kNanosecondsPerMillisecond,
+                         timestamping ? &wakeup_ns : nullptr);
+  ThrowOnError(IOResult{status, 0, status == status_io_error ? errno : 0},
+               "waitReadable");
+  if (status != status_ok) {
+    return 0;
+  }
+  bytes_read = ::read(fd_, buf, size);
+  if (bytes_read < 1) {
+    if (bytes_read == -1 && (errno == EAGAIN || errno == EINTR)) {
+      return 0;
+    }
+    // Disconnected devices, at least on Linux, show the
+    // behavior that they are always ready to read immediately
+    // but reading returns nothing.
+    throw SerialException(
+        "device reports readiness to read but "
+        "returned no data (device disconnected?)");
+  }
+  if (timestamping) {
+    read_timestamp_ns_ = wakeup_ns;
+  }
+  return static_cast<size_t>(bytes_read);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::SetTimestamping(bool enabled) {
+  timestamping_ = enabled;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::SerialImpl::IsTimestamping() const {
+  return timestamping_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t Serial::SerialImpl::GetReadTimestamp() const {
+  return read_timestamp_ns_;
 }
 
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::SerialImpl::Write(const uint8_t *data,
                                               size_t length) {
+  return ThrowOnError(TryWrite(data, length), "write");
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::SerialImpl::TryWrite(const uint8_t *data,
+                                                   size_t length) {
   if (is_open_ == false) {
-    throw PortNotOpenedException("Serial::write");
+    return IOResult{status_not_open, 0, 0};
   }
-  fd_set writefds;
   size_t bytes_written = 0;
 
   // Calculate total timeout in milliseconds t_c + (t_m * N)
   long total_timeout_ms = timeout_.write_timeout_constant;
   total_timeout_ms +=
       timeout_.write_timeout_multiplier * static_cast<long>(length);
-  MilliTimer total_timeout(total_timeout_ms);
+  Deadline deadline = Deadline::FromMilliseconds(total_timeout_ms);
 
   while (bytes_written < length) {
-    int64_t timeout_remaining_ms = total_timeout.Remaining();
-    if (timeout_remaining_ms <= 0) {
+    int64_t timeout_remaining_ns = deadline.RemainingNs();
+    if (timeout_remaining_ns <= 0) {
       // Timed out
-      break;
+      return IOResult{status_timeout, bytes_written, 0};
+    }
+    // Wait for the port to be writable. On a timeout or an interruption,
+    // the deadline is checked again.
+    status_t status = Poll(POLLOUT, timeout_remaining_ns);
+    if (status == status_io_error) {
+      return IOResult{status, bytes_written, errno};
+    }
+    if (status != status_ok) {
+      continue;
     }
-    timespec timeout(MilliTimer::TimeSpecFromMs(timeout_remaining_ms));
+    // This will write some
+    ssize_t bytes_written_now =
+        ::write(fd_, data + bytes_written, length - bytes_written);
+    // write should always return some data as poll reported it was
+    // ready to write when we get to this point.
+    if (bytes_written_now < 1) {
+      // Disconnected devices, at least on Linux, show the
+      // behavior that they are always ready to write immediately
+      // but writing returns nothing.
+      return IOResult{status_disconnected, bytes_written, 0};
+    }
+    bytes_written += static_cast<size_t>(bytes_written_now);
+  }
+  return IOResult{status_ok, bytes_written, 0};
+}
 
-    FD_ZERO(&writefds);
-    FD_SET(fd_, &writefds);
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::SerialImpl::WriteV(iovec *iov, int count) {
+  if (is_open_ == false) {
+    throw PortNotOpenedException("Serial::writev");
+  }
+  size_t length = 0;
+  for (int i = 0; i < count; ++i) {
+    length += iov[i].iov_len;
+  }
+  size_t bytes_written = 0;
+  int first = 0;
+  // The bytes of iov[first] that are already written.
+  size_t offset = 0;
 
-    // Do the select
-    int r = pselect(fd_ + 1, NULL, &writefds, NULL, &timeout, NULL);
+  // Same timeout as a single Write of all the buffers.
+  long total_timeout_ms = timeout_.write_timeout_constant;
+  total_timeout_ms +=
+      timeout_.write_timeout_multiplier * static_cast<long>(length);
+  Deadline deadline = Deadline::FromMilliseconds(total_timeout_ms);
 
-    // Figure out what happened by looking at select's response 'r'
-    /** Error **/
-    if (r < 0) {
-      // Select was interrupted, try again
+  while (bytes_written < length) {
+    // Try first without waiting, the port is writable most of the time.
+    iovec &partial = iov[first];
+    const iovec whole = partial;
+    partial.iov_base = static_cast<uint8_t *>(partial.iov_base) + offset;
+    partial.iov_len -= offset;
+    ssize_t bytes_written_now =
+        ::writev(fd_, iov + first, std::min(count - first, IOV_MAX));
+    partial = whole;
+    if (bytes_written_now < 0) {
       if (errno == EINTR) {
         continue;
       }
-      // Otherwise there was some error
-      ATLAS_THROW(IOException, errno);
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        ATLAS_THROW(IOException, errno);
+      }
+      int64_t timeout_remaining_ns = deadline.RemainingNs();
+      if (timeout_remaining_ns <= 0) {
+        break;
+      }
+      if (Poll(POLLOUT, timeout_remaining_ns) == status_io_error) {
+        ATLAS_THROW(IOException, errno);
+      }
+      continue;
     }
-    /** Timeout **/
-    if (r == 0) {
-      break;
+    if (bytes_written_now == 0) {
+      throw SerialException(
+          "device reports readiness to write but "
+          "returned no data (device disconnected?)");
     }
-    /** Port ready to write **/
-    if (r > 0) {
-      // Make sure our file descriptor is in the ready to write list
-      if (FD_ISSET(fd_, &writefds)) {
-        // This will write some
-        ssize_t bytes_written_now =
-            ::write(fd_, data + bytes_written, length - bytes_written);
-        // write should always return some data as select reported it was
-        // ready to write when we get to this point.
-        if (bytes_written_now < 1) {
-          // Disconnected devices, at least on Linux, show the
-          // behavior that they are always ready to write immediately
-          // but writing returns nothing.
-          throw SerialException(
-              "device reports readiness to write but "
-              "returned no data (device disconnected?)");
-        }
-        // Update bytes_written
-        bytes_written += static_cast<size_t>(bytes_written_now);
-        // If bytes_written == size then we have written everything we need to
-        if (bytes_written == length) {
-          break;
-        }
-        // If bytes_written < size then we have more to write
-        if (bytes_written < length) {
-          continue;
-        }
-        // If bytes_written > size then we have over written, which shouldn't
-        // happen
-        if (bytes_written > length) {
-          throw SerialException(
-              "write over wrote, too many bytes where "
-              "written, this shouldn't happen, might be "
-              "a logical error!");
-        }
-      }
-      // This shouldn't happen, if r > 0 our fd has to be in the list!
-      ATLAS_THROW(IOException,
-                  "select reports ready to write, but our fd isn't"
-                  " in the list, this shouldn't happen!");
+    bytes_written += static_cast<size_t>(bytes_written_now);
+    // Skip the buffers that are complete, the next call cuts the partial
+    // one.
+    size_t consumed = offset + static_cast<size_t>(bytes_written_now);
+    while (first < count && consumed >= iov[first].iov_len) {
+      consumed -= iov[first].iov_len;
+      ++first;
     }
+    offset = consumed;
   }
   return bytes_written;
 }
@@ -844,6 +1028,19 @@ ATLAS_INLINE flowcontrol_t Serial::SerialImpl::GetFlowcontrol() const {
   return flowcontrol_;
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SerialImpl::SetLatency(latency_t latency) {
+  latency_ = latency;
+  if (is_open_) ReconfigurePort();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE latency_t Serial::SerialImpl::GetLatency() const {
+  return latency_;
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE void Serial::SerialImpl::Flush() {
@@ -0,0 +1,156 @@
+/**
+ * \file	file_capture.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FILE_CAPTURE_H_
+#define LIB_ATLAS_IO_FILE_CAPTURE_H_
+
+#include <lib_atlas/io/details/frame_prefetcher.h>
+#include <lib_atlas/io/image_sequence_capture.h>
+#include <lib_atlas/macros.h>
+#include <memory>
+#include <opencv2/core/core.hpp>
+
+namespace atlas {
+
+enum class PlaybackMode {
+  /** Stream the frames at the framerate of the recording. */
+  REAL_TIME = 0,
+
+  /** Stream the frames as soon as they are decoded. */
+  AS_FAST_AS_POSSIBLE
+};
+
+/**
+ * A capture that replays recorded frames, e.g. the images of a dive.
+ *
+ * The frames are decoded ahead on other threads by a FramePrefetcher, so the
+ * capture runs at the speed of the decoding rather than waiting for the disk
+ * and the decoder on every frame. They are decoded in the buffers of a
+ * FramePool that the frames sent hold, see ImageFrame::buffer.
+ *
+ * When the recording is over, the capture leaves the streaming mode, the
+ * observers get no empty image. GetImage() returns an empty image then.
+ */
+class FileCapture : public ImageSequenceCapture {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<FileCapture>;
+
+  static const size_t kDefaultPrefetchDepth = 8;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  virtual ~FileCapture() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Choose between the framerate of the recording and the one of the
+   * decoding, this sets the max framerate of the capture.
+   */
+  void SetPlaybackMode(PlaybackMode mode);
+
+  PlaybackMode GetPlaybackMode() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The framerate of the recording.
+   */
+  double GetRecordingFramerate() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return True once all the frames were sent.
+   */
+  bool IsAtEnd() const ATLAS_NOEXCEPT;
+
+  DecodeStats GetDecodeStats() const;
+
+  /**
+   * \return The distribution of the decoding time of one frame.
+   */
+  const LatencyHistogram &GetDecodeLatency() const ATLAS_NOEXCEPT;
+
+  void ResetDecodeStats() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The pool of the decoded frames, null until a frame is decoded.
+   */
+  FramePool::Ptr GetFramePool() const;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   C / D T O R S
+
+  /**
+   * \param framerate The framerate of the recording.
+   */
+  FileCapture(double framerate, PlaybackMode mode);
+
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  /**
+   * Start decoding the frames, the derived classes call this from their
+   * constructor.
+   *
+   * The decode function runs on the threads of the prefetcher, it must not
+   * use the members of the derived class, which are destroyed before the
+   * prefetcher.
+   */
+  void StartPrefetch(FramePrefetcher::DecodeFunction decode, size_t depth,
+                     size_t thread_count);
+
+  const cv::Mat &GetNextImage() const override;
+
+  FramePool::Frame GetImageBuffer() const override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  const double framerate_;
+
+  PlaybackMode mode_;
+
+  std::unique_ptr<FramePrefetcher> prefetcher_;
+
+  /** The frame given to the streaming thread, null at the end. */
+  mutable FramePool::Frame current_;
+
+  /** Returned by GetNextImage() at the end of the recording. */
+  const cv::Mat end_image_;
+
+  /** Returned by GetDecodeLatency() when there is no prefetcher. */
+  const LatencyHistogram empty_latency_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/file_capture_inl.h>
+
+#endif  // LIB_ATLAS_IO_FILE_CAPTURE_H_
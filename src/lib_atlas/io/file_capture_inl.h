@@ -0,0 +1,149 @@
+/**
+ * \file	file_capture_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FILE_CAPTURE_H_
+#error This file may only be included from file_capture.h
+#endif
+
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FileCapture::FileCapture(double framerate, PlaybackMode mode)
+    : ImageSequenceCapture(),
+      framerate_(framerate),
+      mode_(mode),
+      prefetcher_(),
+      current_(),
+      end_image_(),
+      empty_latency_() {
+  SetPlaybackMode(mode);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FileCapture::~FileCapture() ATLAS_NOEXCEPT {
+  // The streaming thread calls GetNextImage().
+  Stop();
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FileCapture::StartPrefetch(
+    FramePrefetcher::DecodeFunction decode, size_t depth,
+    size_t thread_count) {
+  prefetcher_.reset(
+      new FramePrefetcher(std::move(decode), depth, thread_count));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const cv::Mat &FileCapture::GetNextImage() const {
+  // The previous frame goes back to the pool once the observers release it.
+  current_ = prefetcher_ == nullptr ? nullptr : prefetcher_->Next();
+  if (current_ == nullptr) {
+    if (IsStreaming()) {
+      // The streaming thread does not hold the lock while it gets the image.
+      const_cast<FileCapture *>(this)->SetStreamingMode(false);
+    }
+    return end_image_;
+  }
+  return *current_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePool::Frame FileCapture::GetImageBuffer() const {
+  return current_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FileCapture::SetPlaybackMode(PlaybackMode mode) {
+  mode_ = mode;
+  SetMaxFramerate(mode == PlaybackMode::REAL_TIME ? framerate_ : 0);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE PlaybackMode FileCapture::GetPlaybackMode() const ATLAS_NOEXCEPT {
+  return mode_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE double FileCapture::GetRecordingFramerate() const ATLAS_NOEXCEPT {
+  return framerate_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FileCapture::IsAtEnd() const ATLAS_NOEXCEPT {
+  return prefetcher_ == nullptr || prefetcher_->IsAtEnd();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE DecodeStats FileCapture::GetDecodeStats() const {
+  if (prefetcher_ == nullptr) {
+    return DecodeStats();
+  }
+  return prefetcher_->GetStats();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const LatencyHistogram &FileCapture::GetDecodeLatency() const
+    ATLAS_NOEXCEPT {
+  if (prefetcher_ == nullptr) {
+    return empty_latency_;
+  }
+  return prefetcher_->GetDecodeLatency();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FileCapture::ResetDecodeStats() ATLAS_NOEXCEPT {
+  if (prefetcher_ != nullptr) {
+    prefetcher_->ResetStats();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePool::Ptr FileCapture::GetFramePool() const {
+  return prefetcher_ == nullptr ? nullptr : prefetcher_->GetFramePool();
+}
+
+}  // namespace atlas
@@ -0,0 +1,187 @@
+/**
+ * \file	frame_pool.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FRAME_POOL_H_
+#define LIB_ATLAS_IO_FRAME_POOL_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <opencv2/core/core.hpp>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * A set of preallocated images of the same geometry that are reused from
+ * one frame to the next.
+ *
+ * An image source acquires a frame, fills it and sends it down the pipeline.
+ * The frame goes back to the pool when the last consumer releases it, so at
+ * steady state no image is allocated, and the memory is not given back to
+ * the system only to be faulted in again on the next frame.
+ *
+ * The frames are reference counted with a shared_ptr whose deleter puts the
+ * frame back in the free list of the pool, under its mutex, so a frame is
+ * only handed out again once every reference to it has been released. The
+ * consumers must keep the Frame rather than a copy of the cv::Mat header:
+ * the pool does not see the references held through a cv::Mat, and it would
+ * overwrite the buffer while it is still in use. A frame whose geometry is
+ * changed gets a new buffer, which it keeps when it goes back to the pool.
+ *
+ * The frames may outlive the pool, they are then freed on their release.
+ *
+ * When every frame is in use, Acquire() allocates a frame that is not part
+ * of the pool rather than blocking the source, and counts a miss.
+ *
+ * Sample usage:
+ *
+ *   atlas::FramePool pool(cv::Size(1920, 1080), CV_8UC3, 8);
+ *   atlas::FramePool::Frame frame = pool.Acquire();
+ *   camera.Retrieve(*frame);
+ *   Notify(frame);
+ */
+class FramePool {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<FramePool>;
+
+  using Frame = std::shared_ptr<cv::Mat>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Allocate all the frames of the pool.
+   *
+   * \param size The size of the images.
+   * \param type The OpenCV type of the images, e.g. CV_8UC3.
+   * \param capacity The number of frames in the pool, it should be the
+   *        number of frames that can be in the pipeline at the same time.
+   *
+   * \throw std::invalid_argument if the capacity is 0.
+   */
+  FramePool(const cv::Size &size, int type, size_t capacity);
+
+  ~FramePool() ATLAS_NOEXCEPT = default;
+
+  FramePool(const FramePool &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  FramePool &operator=(const FramePool &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Get a frame that nobody uses, its content is the one of the last image
+   * it held.
+   *
+   * This can be called from any thread, and the frames can be released from
+   * any thread.
+   */
+  Frame Acquire();
+
+  /**
+   * \return True if the frames of the pool have the given geometry.
+   */
+  bool Matches(const cv::Size &size, int type) const ATLAS_NOEXCEPT;
+
+  cv::Size GetSize() const ATLAS_NOEXCEPT;
+
+  int GetType() const ATLAS_NOEXCEPT;
+
+  size_t Capacity() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of frames of the pool currently in use.
+   */
+  size_t OutstandingCount() const;
+
+  /**
+   * \return The number of Acquire() served by the pool.
+   */
+  uint64_t HitCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of Acquire() that had to allocate a frame.
+   */
+  uint64_t MissCount() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  /**
+   * The frames of the pool, shared with the deleters of the frames in use so
+   * they can be released after the destruction of the pool.
+   */
+  struct Storage {
+    std::mutex mutex;
+
+    std::vector<std::unique_ptr<cv::Mat>> frames;
+
+    /** The frames nobody uses, the last released is reused first. */
+    std::vector<cv::Mat *> free_frames;
+  };
+
+  /** The deleter of the frames of the pool, it gives them back. */
+  class Releaser {
+   public:
+    explicit Releaser(std::shared_ptr<Storage> storage);
+
+    void operator()(cv::Mat *frame) const ATLAS_NOEXCEPT;
+
+   private:
+    std::shared_ptr<Storage> storage_;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  cv::Size size_;
+
+  int type_;
+
+  size_t capacity_;
+
+  std::shared_ptr<Storage> storage_;
+
+  std::atomic<uint64_t> hit_count_;
+
+  std::atomic<uint64_t> miss_count_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/frame_pool_inl.h>
+
+#endif  // LIB_ATLAS_IO_FRAME_POOL_H_
@@ -0,0 +1,138 @@
+/**
+ * \file	frame_pool_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FRAME_POOL_H_
+#error This file may only be included from frame_pool.h
+#endif
+
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePool::FramePool(const cv::Size &size, int type,
+                                  size_t capacity)
+    : size_(size),
+      type_(type),
+      capacity_(capacity),
+      storage_(std::make_shared<Storage>()),
+      hit_count_(0),
+      miss_count_(0) {
+  if (capacity == 0) {
+    throw std::invalid_argument("The capacity must be greater than 0.");
+  }
+  storage_->frames.reserve(capacity);
+  storage_->free_frames.reserve(capacity);
+  for (size_t i = 0; i < capacity; ++i) {
+    storage_->frames.emplace_back(new cv::Mat(size_, type_));
+    storage_->free_frames.push_back(storage_->frames.back().get());
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePool::Releaser::Releaser(std::shared_ptr<Storage> storage)
+    : storage_(std::move(storage)) {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FramePool::Releaser::operator()(cv::Mat *frame) const
+    ATLAS_NOEXCEPT {
+  // The storage owns the frame, it is freed with the storage once the pool
+  // is destroyed and every frame is released.
+  std::lock_guard<std::mutex> lock(storage_->mutex);
+  storage_->free_frames.push_back(frame);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePool::Frame FramePool::Acquire() {
+  cv::Mat *frame = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(storage_->mutex);
+    if (!storage_->free_frames.empty()) {
+      frame = storage_->free_frames.back();
+      storage_->free_frames.pop_back();
+    }
+  }
+  if (frame == nullptr) {
+    ++miss_count_;
+    return std::make_shared<cv::Mat>(size_, type_);
+  }
+  ++hit_count_;
+  return Frame(frame, Releaser(storage_));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FramePool::Matches(const cv::Size &size, int type) const
+    ATLAS_NOEXCEPT {
+  return size == size_ && type == type_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE cv::Size FramePool::GetSize() const ATLAS_NOEXCEPT {
+  return size_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int FramePool::GetType() const ATLAS_NOEXCEPT { return type_; }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t FramePool::Capacity() const ATLAS_NOEXCEPT {
+  return capacity_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t FramePool::OutstandingCount() const {
+  std::lock_guard<std::mutex> lock(storage_->mutex);
+  return capacity_ - storage_->free_frames.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t FramePool::HitCount() const ATLAS_NOEXCEPT {
+  return hit_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t FramePool::MissCount() const ATLAS_NOEXCEPT {
+  return miss_count_;
+}
+
+}  // namespace atlas
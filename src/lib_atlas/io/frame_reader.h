@@ -0,0 +1,293 @@
+/**
+ * \file	frame_reader.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FRAME_READER_H_
+#define LIB_ATLAS_IO_FRAME_READER_H_
+
+#include <lib_atlas/exceptions/corrupted_data_exception.h>
+#include <lib_atlas/io/crc.h>
+#include <lib_atlas/io/details/chunk_timestamps.h>
+#include <lib_atlas/io/serial.h>
+#include <lib_atlas/macros.h>
+#include <memory>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * The encodings of the binary frames supported by the FrameReader.
+ */
+enum class FrameFormat {
+  /**
+   * Consistent Overhead Byte Stuffing, each frame is terminated by a 0x00.
+   */
+  COBS = 0,
+
+  /**
+   * RFC 1055 SLIP, each frame is terminated by a 0xC0 (END) and the END and
+   * ESC bytes of the payload are escaped. Empty frames are ignored.
+   */
+  SLIP,
+
+  /**
+   * 0xA5 | size (uint16 LE) | payload | CRC-16/CCITT-FALSE (uint16 LE), the
+   * CRC is computed on the size and the payload.
+   */
+  LENGTH_CRC16,
+
+  /**
+   * 0xA5 | size (uint16 LE) | payload | CRC-32 (uint32 LE), the CRC is
+   * computed on the size and the payload.
+   */
+  LENGTH_CRC32
+};
+
+/**
+ * A complete frame payload, pointing inside of the buffer of the FrameReader
+ * that returned it.
+ */
+struct FrameView {
+  const uint8_t *data;
+  size_t size;
+  /**
+   * The CLOCK_MONOTONIC time at which the first byte of the frame arrived,
+   * 0 if unknown. See Serial::SetTimestamping().
+   */
+  int64_t timestamp_ns;
+};
+
+/**
+ * Extract the binary frames sent by a device.
+ *
+ * The bytes are accumulated in an internal buffer, either read from a serial
+ * port with Next() or given with Feed(), and the frames are decoded in place.
+ * The frames are thus returned without any copy, but a FrameView is only
+ * valid until the next call to Next(), Feed() or Reset().
+ *
+ * When a frame is invalid (bad CRC, bad stuffing or too long), the reader
+ * resynchronizes on the next frame. Depending on the construction, it either
+ * counts the error and silently carries on, or throws a
+ * CorruptedDataException. In both cases the reader can continue to be used
+ * after the error.
+ *
+ * Sample usage:
+ *
+ *   atlas::FrameReader reader(imu_port, atlas::FrameFormat::COBS);
+ *   atlas::FrameView frame;
+ *   while (reader.Next(frame, 100)) {
+ *     ParseImuMessage(frame.data, frame.size);
+ *   }
+ */
+class FrameReader {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<FrameReader>;
+
+  /** The first byte of the length prefixed frames. */
+  static const uint8_t kLengthFrameStart = 0xA5;
+
+  /** The minimum number of bytes requested to the port by Next(). */
+  static const size_t kReadSize = 1024;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Create a reader that is only given its bytes with Feed(), this is
+   * typically the case when the port is read by a SerialReactor.
+   *
+   * \param format The encoding of the frames.
+   * \param max_frame_size The maximum size of a decoded payload, the longer
+   *        frames are rejected.
+   * \param throw_on_error Throw a CorruptedDataException on the invalid
+   *        frames instead of only counting them.
+   */
+  explicit FrameReader(FrameFormat format, size_t max_frame_size = 1024,
+                       bool throw_on_error = false);
+
+  /**
+   * Create a reader that read its bytes on a serial port with Next().
+   *
+   * The serial port must outlive the reader.
+   */
+  FrameReader(Serial &serial, FrameFormat format,
+              size_t max_frame_size = 1024, bool throw_on_error = false);
+
+  ~FrameReader() ATLAS_NOEXCEPT = default;
+
+  FrameReader(const FrameReader &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  FrameReader &operator=(const FrameReader &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Get the next complete frame, reading the serial port as needed.
+   *
+   * \param frame The view on the payload of the frame.
+   * \param timeout_ms The maximum time to wait for a complete frame.
+   *
+   * \return True if a frame was found, false if the timeout expired.
+   *
+   * \throw std::logic_error if the reader was not created with a port.
+   * \throw CorruptedDataException if an invalid frame is received and the
+   *        reader throws on errors.
+   * \throw SerialException if the device has been disconnected.
+   */
+  bool Next(FrameView &frame, uint32_t timeout_ms);
+
+  /**
+   * Append received bytes to the buffer of the reader.
+   *
+   * This invalidates the frames previously returned.
+   *
+   * \param timestamp_ns The arrival time of the bytes, it is given back with
+   *        the frames that start in them. 0 if unknown.
+   */
+  void Feed(const uint8_t *data, size_t size, int64_t timestamp_ns = 0);
+
+  /**
+   * Get the next complete frame from the bytes that have been received,
+   * without reading the port.
+   *
+   * \return True if a frame was found, false if more bytes are needed.
+   *
+   * \throw CorruptedDataException if an invalid frame is received and the
+   *        reader throws on errors.
+   */
+  bool Parse(FrameView &frame);
+
+  /**
+   * Drop all the bytes received and restart on the next frame.
+   *
+   * The statistics are not reset.
+   */
+  void Reset() ATLAS_NOEXCEPT;
+
+  FrameFormat GetFormat() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of valid frames that have been returned.
+   */
+  uint64_t FrameCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of invalid frames that have been rejected.
+   */
+  uint64_t ErrorCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of received bytes that were not part of a valid frame.
+   */
+  uint64_t DiscardedBytes() const ATLAS_NOEXCEPT;
+
+  /**
+   * Encode a payload in a frame of the given format.
+   *
+   * \param output The frame is appended to this vector.
+   *
+   * \throw std::invalid_argument if the payload is too long for the format.
+   */
+  static void Encode(FrameFormat format, const uint8_t *data, size_t size,
+                     std::vector<uint8_t> &output);
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Make sure that at least size bytes can be appended to the buffer,
+   * moving the pending bytes to the front of the buffer first.
+   */
+  void Reserve(size_t size);
+
+  bool ParseDelimited(FrameView &frame, uint8_t delimiter);
+
+  bool ParseLengthPrefixed(FrameView &frame, size_t crc_size);
+
+  /**
+   * Count an invalid frame of the given size that has already been removed
+   * from the buffer and throw if required.
+   */
+  void Reject(size_t size, const char *reason);
+
+  /** \return The arrival time of the byte at the given index of the buffer. */
+  int64_t GetTimestamp(size_t index) ATLAS_NOEXCEPT;
+
+  /** \return The decoded size, or -1 if the frame is invalid. */
+  static ssize_t DecodeCobs(uint8_t *data, size_t size) ATLAS_NOEXCEPT;
+
+  /** \return The decoded size, or -1 if the frame is invalid. */
+  static ssize_t DecodeSlip(uint8_t *data, size_t size) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  Serial *serial_;
+
+  FrameFormat format_;
+
+  size_t max_frame_size_;
+
+  bool throw_on_error_;
+
+  /**
+   * The received bytes are in [begin_, end_). The buffer is linear rather
+   * than circular so a frame is always contiguous and can be decoded in
+   * place, the pending bytes are moved to the front when more room is needed.
+   */
+  std::vector<uint8_t> buffer_;
+
+  size_t begin_;
+
+  size_t end_;
+
+  /** The arrival time of the bytes that went through the buffer. */
+  ChunkTimestamps timestamps_;
+
+  /** Where the search of the next delimiter has to resume. */
+  size_t scan_;
+
+  /** The current frame is too long and must be dropped until its end. */
+  bool resync_;
+
+  uint64_t frame_count_;
+
+  uint64_t error_count_;
+
+  uint64_t discarded_bytes_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/frame_reader_inl.h>
+
+#endif  // LIB_ATLAS_IO_FRAME_READER_H_
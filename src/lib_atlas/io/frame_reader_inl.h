@@ -0,0 +1,431 @@
+/**
+ * \file	frame_reader_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FRAME_READER_H_
+#error This file may only be included from frame_reader.h
+#endif
+
+#include <lib_atlas/io/details/deadline.h>
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FrameReader::FrameReader(FrameFormat format,
+                                      size_t max_frame_size,
+                                      bool throw_on_error)
+    : serial_(nullptr),
+      format_(format),
+      max_frame_size_(max_frame_size),
+      throw_on_error_(throw_on_error),
+      // Room for two frames of the worst encoded size, SLIP doubles the size.
+      buffer_(std::max(static_cast<size_t>(kReadSize),
+                       4 * max_frame_size + 16)),
+      begin_(0),
+      end_(0),
+      timestamps_(),
+      scan_(0),
+      resync_(false),
+      frame_count_(0),
+      error_count_(0),
+      discarded_bytes_(0) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FrameReader::FrameReader(Serial &serial, FrameFormat format,
+                                      size_t max_frame_size,
+                                      bool throw_on_error)
+    : FrameReader(format, max_frame_size, throw_on_error) {
+  serial_ = &serial;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FrameReader::Next(FrameView &frame, uint32_t timeout_ms) {
+  if (serial_ == nullptr) {
+    throw std::logic_error("The frame reader has no serial port.");
+  }
+  if (Parse(frame)) {
+    return true;
+  }
+  Deadline deadline = Deadline::FromMilliseconds(timeout_ms);
+  while (true) {
+    // Rounded up, a read with a timeout of 0 would not wait for the last
+    // fraction of a millisecond.
+    uint32_t remaining = static_cast<uint32_t>(
+        (deadline.RemainingNs() + Deadline::kNanosecondsPerMillisecond - 1) /
+        Deadline::kNanosecondsPerMillisecond);
+    Reserve(kReadSize);
+    size_t bytes_read = serial_->ReadSome(
+        buffer_.data() + end_, buffer_.size() - end_, remaining);
+    timestamps_.Push(bytes_read, serial_->GetLastReadTimestamp());
+    end_ += bytes_read;
+    if (Parse(frame)) {
+      return true;
+    }
+    if (remaining == 0) {
+      return false;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameReader::Feed(const uint8_t *data, size_t size,
+                                     int64_t timestamp_ns) {
+  Reserve(size);
+  memcpy(buffer_.data() + end_, data, size);
+  timestamps_.Push(size, timestamp_ns);
+  end_ += size;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FrameReader::Parse(FrameView &frame) {
+  switch (format_) {
+    case FrameFormat::COBS:
+      return ParseDelimited(frame, 0x00);
+    case FrameFormat::SLIP:
+      return ParseDelimited(frame, 0xC0);
+    case FrameFormat::LENGTH_CRC16:
+      return ParseLengthPrefixed(frame, sizeof(uint16_t));
+    case FrameFormat::LENGTH_CRC32:
+      return ParseLengthPrefixed(frame, sizeof(uint32_t));
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameReader::Reset() ATLAS_NOEXCEPT {
+  discarded_bytes_ += end_ - begin_;
+  begin_ = end_ = scan_ = 0;
+  timestamps_.Clear();
+  resync_ = false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FrameFormat FrameReader::GetFormat() const ATLAS_NOEXCEPT {
+  return format_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t FrameReader::FrameCount() const ATLAS_NOEXCEPT {
+  return frame_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t FrameReader::ErrorCount() const ATLAS_NOEXCEPT {
+  return error_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t FrameReader::DiscardedBytes() const ATLAS_NOEXCEPT {
+  return discarded_bytes_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameReader::Encode(FrameFormat format, const uint8_t *data,
+                                      size_t size,
+                                      std::vector<uint8_t> &output) {
+  switch (format) {
+    case FrameFormat::COBS: {
+      size_t code_index = output.size();
+      output.push_back(0);
+      uint8_t code = 1;
+      for (size_t i = 0; i < size; ++i) {
+        if (data[i] != 0) {
+          output.push_back(data[i]);
+          ++code;
+        }
+        if (data[i] == 0 || code == 0xFF) {
+          output[code_index] = code;
+          code = 1;
+          code_index = output.size();
+          // A full block at the end of the data does not need a new code.
+          if (data[i] == 0 || i + 1 < size) {
+            output.push_back(0);
+          }
+        }
+      }
+      if (code_index < output.size()) {
+        output[code_index] = code;
+      }
+      output.push_back(0x00);
+      break;
+    }
+    case FrameFormat::SLIP: {
+      // The leading END flushes the line noise received before the frame.
+      output.push_back(0xC0);
+      for (size_t i = 0; i < size; ++i) {
+        if (data[i] == 0xC0) {
+          output.push_back(0xDB);
+          output.push_back(0xDC);
+        } else if (data[i] == 0xDB) {
+          output.push_back(0xDB);
+          output.push_back(0xDD);
+        } else {
+          output.push_back(data[i]);
+        }
+      }
+      output.push_back(0xC0);
+      break;
+    }
+    case FrameFormat::LENGTH_CRC16:
+    case FrameFormat::LENGTH_CRC32: {
+      if (size > 0xFFFF) {
+        throw std::invalid_argument("The payload is too long for the frame.");
+      }
+      output.push_back(static_cast<uint8_t>(kLengthFrameStart));
+      size_t header = output.size();
+      output.push_back(static_cast<uint8_t>(size & 0xFF));
+      output.push_back(static_cast<uint8_t>(size >> 8));
+      output.insert(output.end(), data, data + size);
+      const uint8_t *checked = output.data() + header;
+      if (format == FrameFormat::LENGTH_CRC16) {
+        uint16_t crc = Crc16(checked, size + 2);
+        output.push_back(static_cast<uint8_t>(crc & 0xFF));
+        output.push_back(static_cast<uint8_t>(crc >> 8));
+      } else {
+        uint32_t crc = Crc32(checked, size + 2);
+        for (int i = 0; i < 4; ++i) {
+          output.push_back(static_cast<uint8_t>(crc >> (8 * i)));
+        }
+      }
+      break;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameReader::Reserve(size_t size) {
+  if (buffer_.size() - end_ >= size) {
+    return;
+  }
+  if (begin_ > 0) {
+    memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+    end_ -= begin_;
+    scan_ -= std::min(scan_, begin_);
+    begin_ = 0;
+  }
+  if (buffer_.size() - end_ < size) {
+    buffer_.resize(std::max(end_ + size, buffer_.size() * 2));
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FrameReader::ParseDelimited(FrameView &frame,
+                                              uint8_t delimiter) {
+  // The longest frame allowed once encoded, SLIP may double every byte.
+  const size_t max_encoded_size =
+      format_ == FrameFormat::SLIP
+          ? 2 * max_frame_size_
+          : max_frame_size_ + max_frame_size_ / 254 + 1;
+  while (true) {
+    scan_ = std::max(scan_, begin_);
+    const uint8_t *start = buffer_.data() + begin_;
+    const void *found = memchr(buffer_.data() + scan_, delimiter, end_ - scan_);
+    if (found == nullptr) {
+      scan_ = end_;
+      size_t pending = end_ - begin_;
+      if (pending > max_encoded_size) {
+        // Drop the beginning of the frame now so the buffer does not grow,
+        // the rest is dropped when the delimiter arrives.
+        begin_ = scan_ = end_;
+        if (resync_) {
+          discarded_bytes_ += pending;
+        } else {
+          resync_ = true;
+          Reject(pending, "FrameReader: frame too long");
+        }
+      }
+      return false;
+    }
+
+    uint8_t *encoded = buffer_.data() + begin_;
+    size_t encoded_size = static_cast<const uint8_t *>(found) - start;
+    begin_ += encoded_size + 1;
+    scan_ = begin_;
+    if (resync_) {
+      resync_ = false;
+      discarded_bytes_ += encoded_size + 1;
+      continue;
+    }
+    if (encoded_size == 0) {
+      continue;  // Consecutive delimiters, there is no frame in between.
+    }
+    ssize_t size = format_ == FrameFormat::COBS
+                       ? DecodeCobs(encoded, encoded_size)
+                       : DecodeSlip(encoded, encoded_size);
+    if (size < 0 || static_cast<size_t>(size) > max_frame_size_) {
+      Reject(encoded_size + 1, size < 0 ? "FrameReader: invalid byte stuffing"
+                                        : "FrameReader: frame too long");
+      continue;
+    }
+    frame.data = encoded;
+    frame.size = static_cast<size_t>(size);
+    frame.timestamp_ns = GetTimestamp(encoded - buffer_.data());
+    ++frame_count_;
+    return true;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FrameReader::ParseLengthPrefixed(FrameView &frame,
+                                                   size_t crc_size) {
+  while (true) {
+    const uint8_t *start = buffer_.data() + begin_;
+    const void *found = memchr(start, kLengthFrameStart, end_ - begin_);
+    if (found == nullptr) {
+      discarded_bytes_ += end_ - begin_;
+      begin_ = end_;
+      return false;
+    }
+    size_t garbage = static_cast<const uint8_t *>(found) - start;
+    discarded_bytes_ += garbage;
+    begin_ += garbage;
+
+    if (end_ - begin_ < 3) {
+      return false;
+    }
+    const uint8_t *header = buffer_.data() + begin_ + 1;
+    size_t size = header[0] | static_cast<size_t>(header[1]) << 8;
+    bool valid = size <= max_frame_size_;
+    if (valid) {
+      if (end_ - begin_ < 3 + size + crc_size) {
+        return false;
+      }
+      const uint8_t *crc = header + 2 + size;
+      if (crc_size == sizeof(uint16_t)) {
+        uint16_t expected = crc[0] | static_cast<uint16_t>(crc[1]) << 8;
+        valid = Crc16(header, size + 2) == expected;
+      } else {
+        uint32_t expected = crc[0] | static_cast<uint32_t>(crc[1]) << 8 |
+                            static_cast<uint32_t>(crc[2]) << 16 |
+                            static_cast<uint32_t>(crc[3]) << 24;
+        valid = Crc32(header, size + 2) == expected;
+      }
+    }
+    if (!valid) {
+      // The start byte may have been a payload byte, look for the next one.
+      begin_ += 1;
+      if (resync_) {
+        discarded_bytes_ += 1;
+      } else {
+        resync_ = true;
+        Reject(1, "FrameReader: invalid frame size or CRC");
+      }
+      continue;
+    }
+    resync_ = false;
+    frame.data = header + 2;
+    frame.size = size;
+    frame.timestamp_ns = GetTimestamp(begin_);
+    begin_ += 3 + size + crc_size;
+    ++frame_count_;
+    return true;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameReader::Reject(size_t size, const char *reason) {
+  discarded_bytes_ += size;
+  ++error_count_;
+  if (throw_on_error_) {
+    throw CorruptedDataException(reason);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t FrameReader::GetTimestamp(size_t index) ATLAS_NOEXCEPT {
+  // The bytes in the buffer are the last ones that went through it.
+  return timestamps_.Find(timestamps_.GetEndPosition() - (end_ - index));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ssize_t FrameReader::DecodeCobs(uint8_t *data,
+                                             size_t size) ATLAS_NOEXCEPT {
+  // The decoded bytes are always behind the encoded ones, so the frame can
+  // be decoded in place.
+  size_t in = 0;
+  size_t out = 0;
+  while (in < size) {
+    uint8_t code = data[in++];
+    size_t run = static_cast<size_t>(code) - 1;
+    if (code == 0 || in + run > size) {
+      return -1;
+    }
+    memmove(data + out, data + in, run);
+    out += run;
+    in += run;
+    if (code != 0xFF && in < size) {
+      data[out++] = 0;
+    }
+  }
+  return static_cast<ssize_t>(out);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ssize_t FrameReader::DecodeSlip(uint8_t *data,
+                                             size_t size) ATLAS_NOEXCEPT {
+  size_t out = 0;
+  for (size_t in = 0; in < size; ++in) {
+    if (data[in] != 0xDB) {
+      data[out++] = data[in];
+    } else if (in + 1 < size && data[in + 1] == 0xDC) {
+      data[out++] = 0xC0;
+      ++in;
+    } else if (in + 1 < size && data[in + 1] == 0xDD) {
+      data[out++] = 0xDB;
+      ++in;
+    } else {
+      return -1;
+    }
+  }
+  return static_cast<ssize_t>(out);
+}
+
+}  // namespace atlas
@@ -0,0 +1,183 @@
+/**
+ * \file	frame_sampler.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FRAME_SAMPLER_H_
+#define LIB_ATLAS_IO_FRAME_SAMPLER_H_
+
+#include <lib_atlas/io/image_frame.h>
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/pattern/subject.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <opencv2/core/core.hpp>
+
+namespace atlas {
+
+/**
+ * Forward a reduced version of the frames of a capture to the consumers
+ * that do not need all of it, e.g. a preview or a low resolution detector.
+ *
+ * The sampler observes a capture, or an ImagePipeline, and its observers
+ * only receive the frames it keeps:
+ *
+ *   atlas::FrameSampler preview;
+ *   preview.SetMaxFramerate(5);
+ *   preview.SetPyramidLevel(2);
+ *   preview.Observe(camera);
+ *   preview_publisher.Observe(preview);
+ *
+ * The frames are first decimated, by count or by capture time, then
+ * downscaled by a power of two, then cropped. The downscale comes from the
+ * pyramid of the frame, so the samplers that ask for the same level of a
+ * frame share one computation. The crop is a view on the downscaled image,
+ * it does not copy the pixels.
+ *
+ * The sampler runs on the thread of the capture, put it behind the bounded
+ * queue of a writer or a pipeline if the downscale is too slow for it.
+ */
+class FrameSampler : public Observer<ImageFrame>, public Subject<ImageFrame> {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<FrameSampler>;
+
+  static const size_t kMaxPyramidLevel = 16;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  FrameSampler() ATLAS_NOEXCEPT;
+
+  ~FrameSampler() ATLAS_NOEXCEPT = default;
+
+  FrameSampler(const FrameSampler &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  FrameSampler &operator=(const FrameSampler &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Keep one frame out of every_nth, 1 keeps them all.
+   *
+   * \throw std::invalid_argument if every_nth is 0.
+   */
+  void SetDecimation(uint32_t every_nth);
+
+  uint32_t GetDecimation() const;
+
+  /**
+   * Keep at most the given number of frames per second of capture time, 0
+   * removes the limit.
+   *
+   * The frames are kept on a fixed schedule, so a capture whose framerate is
+   * not a multiple of this one does not make the output framerate drift.
+   *
+   * \throw std::invalid_argument if the framerate is negative.
+   */
+  void SetMaxFramerate(double framerate);
+
+  double GetMaxFramerate() const;
+
+  /**
+   * Downscale the frames by 2^level, 0 keeps the full resolution.
+   *
+   * \throw std::invalid_argument if the level is above kMaxPyramidLevel.
+   */
+  void SetPyramidLevel(size_t level);
+
+  size_t GetPyramidLevel() const;
+
+  /**
+   * Crop the frames, a frame that does not intersect the region is dropped.
+   *
+   * \param roi The region in pixels of the full resolution image, whatever
+   *        the pyramid level. An empty rectangle keeps the whole image.
+   *
+   * \throw std::invalid_argument if the rectangle has negative coordinates.
+   */
+  void SetRegionOfInterest(const cv::Rect &roi);
+
+  cv::Rect GetRegionOfInterest() const;
+
+  /**
+   * \return The number of frames notified to the sampler.
+   */
+  uint64_t GetReceivedCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of frames the sampler notified to its observers.
+   */
+  uint64_t GetForwardedCount() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void OnSubjectNotify(Subject<ImageFrame> &subject,
+                       const ImageFrame &frame) ATLAS_NOEXCEPT override;
+
+  /**
+   * \return False if the frame must be dropped, the mutex must be held.
+   */
+  bool Decimate(int64_t capture_ns) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /** Protects the configuration and the decimation state. */
+  mutable std::mutex mutex_;
+
+  uint32_t decimation_;
+
+  double max_framerate_;
+
+  size_t pyramid_level_;
+
+  cv::Rect roi_;
+
+  /** The index of the next frame in the groups of decimation_ frames. */
+  uint32_t decimation_index_;
+
+  /** The capture time at which the next frame may be kept. */
+  int64_t next_frame_ns_;
+
+  std::atomic<uint64_t> received_count_;
+
+  std::atomic<uint64_t> forwarded_count_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/frame_sampler_inl.h>
+
+#endif  // LIB_ATLAS_IO_FRAME_SAMPLER_H_
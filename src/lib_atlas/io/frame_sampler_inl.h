@@ -0,0 +1,211 @@
+/**
+ * \file	frame_sampler_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_FRAME_SAMPLER_H_
+#error This file may only be included from frame_sampler.h
+#endif
+
+#include <lib_atlas/io/details/deadline.h>
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FrameSampler::FrameSampler() ATLAS_NOEXCEPT
+    : Observer<ImageFrame>(),
+      Subject<ImageFrame>(),
+      mutex_(),
+      decimation_(1),
+      max_framerate_(0),
+      pyramid_level_(0),
+      roi_(),
+      decimation_index_(0),
+      next_frame_ns_(0),
+      received_count_(0),
+      forwarded_count_(0) {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameSampler::SetDecimation(uint32_t every_nth) {
+  if (every_nth == 0) {
+    throw std::invalid_argument("The decimation must not be 0.");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  decimation_ = every_nth;
+  decimation_index_ = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint32_t FrameSampler::GetDecimation() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return decimation_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameSampler::SetMaxFramerate(double framerate) {
+  if (framerate < 0) {
+    throw std::invalid_argument("The framerate cannot be negative.");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_framerate_ = framerate;
+  next_frame_ns_ = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE double FrameSampler::GetMaxFramerate() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_framerate_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameSampler::SetPyramidLevel(size_t level) {
+  if (level > kMaxPyramidLevel) {
+    throw std::invalid_argument("The pyramid level is too high.");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  pyramid_level_ = level;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t FrameSampler::GetPyramidLevel() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pyramid_level_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameSampler::SetRegionOfInterest(const cv::Rect &roi) {
+  if (roi.x < 0 || roi.y < 0 || roi.width < 0 || roi.height < 0) {
+    throw std::invalid_argument("The region of interest cannot be negative.");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  roi_ = roi;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE cv::Rect FrameSampler::GetRegionOfInterest() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return roi_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t FrameSampler::GetReceivedCount() const ATLAS_NOEXCEPT {
+  return received_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t FrameSampler::GetForwardedCount() const ATLAS_NOEXCEPT {
+  return forwarded_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool FrameSampler::Decimate(int64_t capture_ns) ATLAS_NOEXCEPT {
+  bool keep = decimation_index_ == 0;
+  decimation_index_ = (decimation_index_ + 1) % decimation_;
+  if (!keep || max_framerate_ <= 0) {
+    return keep;
+  }
+  if (next_frame_ns_ != 0 && capture_ns < next_frame_ns_) {
+    return false;
+  }
+  const int64_t period_ns = static_cast<int64_t>(
+      Deadline::kNanosecondsPerSecond / max_framerate_);
+  // A fixed schedule: a frame kept a bit late does not delay the next ones.
+  next_frame_ns_ =
+      (next_frame_ns_ == 0 ? capture_ns : next_frame_ns_) + period_ns;
+  if (next_frame_ns_ <= capture_ns) {
+    // After a pause of the capture, do not keep a burst of frames.
+    next_frame_ns_ = capture_ns + period_ns;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void FrameSampler::OnSubjectNotify(Subject<ImageFrame> &subject,
+                                                const ImageFrame &frame)
+    ATLAS_NOEXCEPT {
+  ++received_count_;
+  size_t level;
+  cv::Rect roi;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!Decimate(frame.capture_ns)) {
+      return;
+    }
+    level = pyramid_level_;
+    roi = roi_;
+  }
+
+  if (level == 0 && roi.area() == 0) {
+    ++forwarded_count_;
+    Notify(frame);
+    return;
+  }
+
+  ImageFrame sampled = frame;
+  if (level != 0) {
+    if (sampled.pyramid == nullptr) {
+      sampled.pyramid = std::make_shared<ImagePyramid>(sampled.image);
+    }
+    sampled.image = sampled.pyramid->GetLevel(level);
+  }
+  if (roi.area() > 0) {
+    // Round outwards, so the region keeps all the pixels it covers.
+    const int scale = 1 << level;
+    const int x = roi.x / scale;
+    const int y = roi.y / scale;
+    cv::Rect scaled(x, y, (roi.x + roi.width + scale - 1) / scale - x,
+                    (roi.y + roi.height + scale - 1) / scale - y);
+    scaled = scaled & cv::Rect(0, 0, sampled.image.cols, sampled.image.rows);
+    if (scaled.area() == 0) {
+      return;
+    }
+    sampled.image = sampled.image(scaled);
+  }
+  // The pyramid of the original image does not apply to this one.
+  sampled.pyramid = std::make_shared<ImagePyramid>(sampled.image);
+  ++forwarded_count_;
+  Notify(sampled);
+}
+
+}  // namespace atlas
@@ -0,0 +1,112 @@
+/**
+ * \file	image_directory_capture.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_DIRECTORY_CAPTURE_H_
+#define LIB_ATLAS_IO_IMAGE_DIRECTORY_CAPTURE_H_
+
+#include <lib_atlas/io/file_capture.h>
+#include <lib_atlas/macros.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Replay the images of a directory in the order of their names.
+ *
+ * The images are independent, so they are decoded by several threads at the
+ * same time.
+ */
+class ImageDirectoryCapture : public FileCapture {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<ImageDirectoryCapture>;
+
+  static const size_t kDefaultThreadCount = 2;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param directory The directory holding the images, the files that do
+   *        not have the extension of an image are ignored.
+   * \param framerate The framerate at which the images were recorded.
+   * \param mode The playback mode, see SetPlaybackMode().
+   * \param prefetch_depth The number of images decoded ahead.
+   * \param thread_count The number of decoding threads.
+   *
+   * \throw IOException if the directory cannot be read.
+   * \throw std::invalid_argument if the depth or the thread count is 0.
+   */
+  ImageDirectoryCapture(const std::string &directory, double framerate,
+                        PlaybackMode mode = PlaybackMode::REAL_TIME,
+                        size_t prefetch_depth = kDefaultPrefetchDepth,
+                        size_t thread_count = kDefaultThreadCount);
+
+  ~ImageDirectoryCapture() ATLAS_NOEXCEPT = default;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \return The paths of the images, in the order they are replayed.
+   */
+  const std::vector<std::string> &GetFiles() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return True if the file name has the extension of an image OpenCV can
+   *         read.
+   */
+  static bool IsImageFile(const std::string &name);
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  static std::vector<std::string> ListImages(const std::string &directory);
+
+  /**
+   * Decode an image file in the given image, reusing its buffer when the
+   * geometry is the same.
+   *
+   * \return False if the file cannot be read or decoded.
+   */
+  static bool ReadImage(const std::string &path, cv::Mat &image);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /** Shared with the decoding threads. */
+  std::shared_ptr<const std::vector<std::string>> files_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/image_directory_capture_inl.h>
+
+#endif  // LIB_ATLAS_IO_IMAGE_DIRECTORY_CAPTURE_H_
@@ -0,0 +1,131 @@
+/**
+ * \file	image_directory_capture_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_DIRECTORY_CAPTURE_H_
+#error This file may only be included from image_directory_capture.h
+#endif
+
+#include <dirent.h>
+#include <errno.h>
+#include <string.h>
+#include <lib_atlas/exceptions/io_exception.h>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <opencv2/highgui/highgui.hpp>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageDirectoryCapture::ImageDirectoryCapture(
+    const std::string &directory, double framerate, PlaybackMode mode,
+    size_t prefetch_depth, size_t thread_count)
+    : FileCapture(framerate, mode),
+      files_(std::make_shared<const std::vector<std::string>>(
+          ListImages(directory))) {
+  std::shared_ptr<const std::vector<std::string>> files = files_;
+  StartPrefetch(
+      [files](size_t index, cv::Mat &image) {
+        return index < files->size() && ReadImage((*files)[index], image);
+      },
+      prefetch_depth, thread_count);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const std::vector<std::string> &ImageDirectoryCapture::GetFiles()
+    const ATLAS_NOEXCEPT {
+  return *files_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageDirectoryCapture::IsImageFile(const std::string &name) {
+  static const char *kExtensions[] = {".jpg", ".jpeg", ".png", ".bmp",
+                                      ".tif", ".tiff", ".ppm", ".pgm"};
+  size_t dot = name.rfind('.');
+  if (dot == std::string::npos) {
+    return false;
+  }
+  std::string extension = name.substr(dot);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](char c) { return static_cast<char>(std::tolower(c)); });
+  for (const char *image_extension : kExtensions) {
+    if (extension == image_extension) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::vector<std::string> ImageDirectoryCapture::ListImages(
+    const std::string &directory) {
+  DIR *dir = opendir(directory.c_str());
+  if (dir == nullptr) {
+    ATLAS_THROW(IOException, "Cannot open " << directory << ": "
+                                             << strerror(errno));
+  }
+  std::vector<std::string> files;
+  for (dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+    std::string name(entry->d_name);
+    if (IsImageFile(name)) {
+      files.push_back(directory + "/" + name);
+    }
+  }
+  closedir(dir);
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageDirectoryCapture::ReadImage(const std::string &path,
+                                                   cv::Mat &image) {
+  // Unlike imread, imdecode decodes in the given image. The file is read in
+  // a buffer kept by the decoding thread, so neither allocates per frame.
+  static thread_local std::vector<uchar> bytes;
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  bytes.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  if (bytes.empty() ||
+      !file.read(reinterpret_cast<char *>(bytes.data()), bytes.size())) {
+    return false;
+  }
+  return !cv::imdecode(bytes, cv::IMREAD_COLOR, &image).empty();
+}
+
+}  // namespace atlas
@@ -0,0 +1,94 @@
+/**
+ * \file	image_frame.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_FRAME_H_
+#define LIB_ATLAS_IO_IMAGE_FRAME_H_
+
+#include <lib_atlas/io/frame_pool.h>
+#include <lib_atlas/io/image_pyramid.h>
+#include <stdint.h>
+#include <opencv2/core/core.hpp>
+#include <utility>
+
+namespace atlas {
+
+/**
+ * An image and where it comes from, as notified by an ImageSequenceCapture
+ * and carried through ImagePipeline and ImageSequenceWriter.
+ *
+ * Copying a frame does not copy the pixels, the cv::Mat shares them. When
+ * the pixels are in a buffer of a FramePool, the frame holds the buffer so
+ * it goes back to the pool only once the last copy of the frame is gone.
+ * The consumers that keep the image after their notification must keep the
+ * frame, or clone the image if the buffer is null.
+ */
+struct ImageFrame {
+  ImageFrame()
+      : image(),
+        capture_ns(0),
+        sequence(0),
+        source_id(0),
+        pyramid(),
+        buffer() {}
+
+  ImageFrame(cv::Mat frame_image, int64_t frame_capture_ns,
+             uint64_t frame_sequence, uint32_t frame_source_id)
+      : image(std::move(frame_image)),
+        capture_ns(frame_capture_ns),
+        sequence(frame_sequence),
+        source_id(frame_source_id),
+        pyramid(),
+        buffer() {}
+
+  cv::Mat image;
+
+  /** CLOCK_MONOTONIC when the image was captured, from Deadline::Now(). */
+  int64_t capture_ns;
+
+  /**
+   * The number of the frame in the sequence of its capture, a gap means the
+   * frames in between were dropped.
+   */
+  uint64_t sequence;
+
+  /** The identifier of the capture, see ImageSequenceCapture::SetSourceId. */
+  uint32_t source_id;
+
+  /**
+   * The downscaled versions of the image, shared by all the copies of the
+   * frame. The captures always set it, it may be null otherwise.
+   */
+  ImagePyramid::Ptr pyramid;
+
+  /**
+   * The pooled buffer holding the pixels of the image, null if the image
+   * does not come from a FramePool and may be reused by its source.
+   */
+  FramePool::Frame buffer;
+};
+
+}  // namespace atlas
+
+#endif  // LIB_ATLAS_IO_IMAGE_FRAME_H_
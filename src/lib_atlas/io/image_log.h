@@ -0,0 +1,197 @@
+/**
+ * \file	image_log.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_LOG_H_
+#define LIB_ATLAS_IO_IMAGE_LOG_H_
+
+#include <lib_atlas/exceptions.h>
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <memory>
+#include <opencv2/core/core.hpp>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * The header of an image log, the file written by ImageRecorder.
+ *
+ * The header is followed by the frames, each one in a block aligned on the
+ * alignment of the log: an ImageLogEntry padded to kImageLogEntrySize, then
+ * the pixels, row after row without padding. The index, the array of all the
+ * entries, is written after the last frame when the recording is closed.
+ *
+ * A log whose recording was interrupted has no index, it is rebuilt from the
+ * entries of the blocks.
+ */
+struct ImageLogHeader {
+  /** kImageLogMagic, without the terminating zero. */
+  char magic[8];
+
+  uint32_t version;
+
+  /** The offset of the first frame. */
+  uint32_t header_size;
+
+  /** CLOCK_REALTIME at the start of the recording, in nanoseconds. */
+  int64_t start_realtime_ns;
+
+  /** CLOCK_MONOTONIC at the start of the recording, in nanoseconds. */
+  int64_t start_monotonic_ns;
+
+  /** The number of entries of the index, 0 until the log is closed. */
+  uint64_t frame_count;
+
+  /** The offset of the index, 0 until the log is closed. */
+  uint64_t index_offset;
+
+  /** The alignment of the blocks of the frames. */
+  uint32_t alignment;
+
+  uint32_t reserved[3];
+};
+
+struct ImageLogEntry {
+  /** CLOCK_MONOTONIC when the image was captured. */
+  int64_t timestamp_ns;
+
+  /** The offset of the pixels in the file. */
+  uint64_t offset;
+
+  /** The size of the pixels. */
+  uint64_t size;
+
+  int32_t rows;
+
+  int32_t cols;
+
+  /** The OpenCV type of the image, e.g. CV_8UC3. */
+  int32_t type;
+
+  uint32_t reserved;
+};
+
+static_assert(sizeof(ImageLogHeader) == 64,
+              "The header of the log must not be padded.");
+static_assert(sizeof(ImageLogEntry) == 40,
+              "The entries of the index must not be padded.");
+
+const char kImageLogMagic[] = "ATLSIMG";
+
+const uint32_t kImageLogVersion = 1;
+
+/** The space taken by the entry at the start of the block of a frame. */
+const size_t kImageLogEntrySize = 64;
+
+/**
+ * Give random access to the frames of an image log.
+ *
+ * The file is mapped in memory, so the images are read on demand by the
+ * kernel and GetImage() does not copy them.
+ */
+class ImageLogReader {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<ImageLogReader>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \throw IOException if the file cannot be opened or mapped.
+   * \throw CorruptedDataException if the file is not an image log.
+   */
+  explicit ImageLogReader(const std::string &path);
+
+  ~ImageLogReader() ATLAS_NOEXCEPT;
+
+  ImageLogReader(const ImageLogReader &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  ImageLogReader &operator=(const ImageLogReader &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  const ImageLogHeader &GetHeader() const ATLAS_NOEXCEPT;
+
+  size_t GetFrameCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return True if the log had no index and it was rebuilt.
+   */
+  bool IsRecovered() const ATLAS_NOEXCEPT;
+
+  /**
+   * \throw std::out_of_range if there is no such frame.
+   */
+  const ImageLogEntry &GetEntry(size_t index) const;
+
+  /**
+   * \return The image of a frame, it uses the memory of the file and is only
+   *         valid as long as the reader exists.
+   *
+   * \throw std::out_of_range if there is no such frame.
+   */
+  cv::Mat GetImage(size_t index) const;
+
+  /**
+   * \return The index of the first frame captured at or after the given
+   *         time, GetFrameCount() if there is none.
+   */
+  size_t Find(int64_t timestamp_ns) const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /** \return False if the entry does not describe a frame of the file. */
+  bool IsValid(const ImageLogEntry &entry) const ATLAS_NOEXCEPT;
+
+  /** Read the entries of the blocks of the frames. */
+  void RebuildIndex();
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  const uint8_t *data_;
+
+  size_t size_;
+
+  std::vector<ImageLogEntry> index_;
+
+  bool recovered_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/image_log_inl.h>
+
+#endif  // LIB_ATLAS_IO_IMAGE_LOG_H_
@@ -0,0 +1,190 @@
+/**
+ * \file	image_log_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_LOG_H_
+#error This file may only be included from image_log.h
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageLogReader::ImageLogReader(const std::string &path)
+    : data_(nullptr), size_(0), index_(), recovered_(false) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    ATLAS_THROW(IOException, "open " << path << ": " << strerror(errno));
+  }
+  struct stat status;
+  if (fstat(fd, &status) == -1) {
+    int error = errno;
+    ::close(fd);
+    ATLAS_THROW(IOException, "fstat " << path << ": " << strerror(error));
+  }
+  size_ = static_cast<size_t>(status.st_size);
+  if (size_ < sizeof(ImageLogHeader)) {
+    ::close(fd);
+    throw CorruptedDataException("ImageLogReader: header");
+  }
+  void *data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping keeps the file alive.
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    ATLAS_THROW(IOException, "mmap " << path << ": " << strerror(errno));
+  }
+  data_ = static_cast<const uint8_t *>(data);
+
+  const ImageLogHeader &header = GetHeader();
+  if (memcmp(header.magic, kImageLogMagic, sizeof(header.magic)) != 0 ||
+      header.version != kImageLogVersion ||
+      header.header_size < sizeof(ImageLogHeader) ||
+      header.header_size > size_ || header.alignment == 0) {
+    munmap(data, size_);
+    throw CorruptedDataException("ImageLogReader: header");
+  }
+
+  if (header.index_offset == 0) {
+    RebuildIndex();
+    return;
+  }
+  if (header.index_offset > size_ ||
+      (size_ - header.index_offset) / sizeof(ImageLogEntry) <
+          header.frame_count) {
+    munmap(data, size_);
+    throw CorruptedDataException("ImageLogReader: index");
+  }
+  const ImageLogEntry *entries =
+      reinterpret_cast<const ImageLogEntry *>(data_ + header.index_offset);
+  index_.assign(entries, entries + header.frame_count);
+  for (const ImageLogEntry &entry : index_) {
+    if (!IsValid(entry)) {
+      munmap(data, size_);
+      throw CorruptedDataException("ImageLogReader: index");
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageLogReader::~ImageLogReader() ATLAS_NOEXCEPT {
+  munmap(const_cast<uint8_t *>(data_), size_);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const ImageLogHeader &ImageLogReader::GetHeader() const
+    ATLAS_NOEXCEPT {
+  return *reinterpret_cast<const ImageLogHeader *>(data_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ImageLogReader::GetFrameCount() const ATLAS_NOEXCEPT {
+  return index_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageLogReader::IsRecovered() const ATLAS_NOEXCEPT {
+  return recovered_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const ImageLogEntry &ImageLogReader::GetEntry(
+    size_t index) const {
+  if (index >= index_.size()) {
+    throw std::out_of_range("The log has no such frame.");
+  }
+  return index_[index];
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE cv::Mat ImageLogReader::GetImage(size_t index) const {
+  const ImageLogEntry &entry = GetEntry(index);
+  return cv::Mat(entry.rows, entry.cols, entry.type,
+                 const_cast<uint8_t *>(data_ + entry.offset));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ImageLogReader::Find(int64_t timestamp_ns) const
+    ATLAS_NOEXCEPT {
+  auto it = std::lower_bound(
+      index_.begin(), index_.end(), timestamp_ns,
+      [](const ImageLogEntry &entry, int64_t timestamp) {
+        return entry.timestamp_ns < timestamp;
+      });
+  return static_cast<size_t>(it - index_.begin());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageLogReader::IsValid(const ImageLogEntry &entry) const
+    ATLAS_NOEXCEPT {
+  if (entry.rows <= 0 || entry.cols <= 0 || entry.offset > size_ ||
+      entry.size > size_ - entry.offset) {
+    return false;
+  }
+  return entry.size == static_cast<uint64_t>(entry.rows) * entry.cols *
+                           CV_ELEM_SIZE(entry.type);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageLogReader::RebuildIndex() {
+  recovered_ = true;
+  const uint64_t alignment = GetHeader().alignment;
+  uint64_t offset = GetHeader().header_size;
+  while (offset + kImageLogEntrySize <= size_) {
+    const ImageLogEntry &entry =
+        *reinterpret_cast<const ImageLogEntry *>(data_ + offset);
+    // The preallocated space after the last frame is zeroed.
+    if (entry.offset != offset + kImageLogEntrySize || !IsValid(entry)) {
+      break;
+    }
+    index_.push_back(entry);
+    uint64_t block_size = kImageLogEntrySize + entry.size;
+    offset += (block_size + alignment - 1) / alignment * alignment;
+  }
+}
+
+}  // namespace atlas
@@ -0,0 +1,264 @@
+/**
+ * \file	image_pipeline.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_PIPELINE_H_
+#define LIB_ATLAS_IO_IMAGE_PIPELINE_H_
+
+#include <lib_atlas/io/image_frame.h>
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/bounded_queue.h>
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/pattern/subject.h>
+#include <lib_atlas/sys/latency_histogram.h>
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <opencv2/core/core.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * The counters of a stage of an ImagePipeline since the pipeline was started
+ * or its statistics reset.
+ */
+struct PipelineStageStats {
+  std::string name;
+
+  /** The number of images that went through the stage. */
+  uint64_t frame_count;
+
+  /** The number of images for which the stage threw an exception. */
+  uint64_t error_count;
+
+  /** The images the stage output per second. */
+  double throughput;
+
+  /** The images waiting in the input queue of the stage right now. */
+  size_t queue_depth;
+
+  /** The average number of waiting images when one is queued. */
+  double mean_queue_depth;
+
+  size_t max_queue_depth;
+
+  /** The images discarded by the policy of the input queue. */
+  uint64_t drop_count;
+};
+
+/**
+ * A chain of image processing stages that run at the same time, each on its
+ * own thread.
+ *
+ * The pipeline observes an ImageSequenceCapture and notifies the processed
+ * images to its own observers, typically ImageSequenceWriter:
+ *
+ *   atlas::ImagePipeline pipeline;
+ *   pipeline.AddStage("undistort", Undistort);
+ *   pipeline.AddStage("threshold", Threshold);
+ *   pipeline.Observe(camera);
+ *   publisher.Observe(pipeline);
+ *   pipeline.Start();
+ *
+ * The stages are connected by bounded queues. While a stage processes an
+ * image, the previous one already works on the next image, so the
+ * throughput is the one of the slowest stage rather than the one of the
+ * whole chain. As each stage handles its images one at a time and in the
+ * order they come, the images leave the pipeline in the order of the capture.
+ *
+ * The input queue applies the given policy, so a slow pipeline does not
+ * stall the capture by default. The queues between the stages block, an
+ * image that entered the pipeline is never dropped.
+ *
+ * A stage must output a new image rather than write in its input, the
+ * previous stages and the other observers may still use it.
+ */
+class ImagePipeline : public Observer<ImageFrame>,
+                      public Subject<ImageFrame> {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<ImagePipeline>;
+
+  /**
+   * Process an input image. A stage that throws drops the image.
+   */
+  using StageFunction = std::function<cv::Mat(const cv::Mat &)>;
+
+  static const size_t kDefaultQueueCapacity = 2;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param queue_capacity The number of images waiting before each stage.
+   * \param input_policy What to do with the captured images when the first
+   *        stage is late.
+   *
+   * \throw std::invalid_argument if the capacity is 0.
+   */
+  explicit ImagePipeline(size_t queue_capacity = kDefaultQueueCapacity,
+                         QueuePolicy input_policy = QueuePolicy::DROP_OLDEST);
+
+  ~ImagePipeline() ATLAS_NOEXCEPT;
+
+  ImagePipeline(const ImagePipeline &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  ImagePipeline &operator=(const ImagePipeline &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Add a stage at the end of the pipeline.
+   *
+   * \throw std::logic_error if the pipeline is running.
+   */
+  void AddStage(const std::string &name, StageFunction function);
+
+  size_t StageCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * Start a thread per stage.
+   *
+   * \throw std::logic_error if the pipeline has no stage.
+   */
+  void Start();
+
+  /**
+   * Process the images already in the pipeline and stop the threads.
+   */
+  void Stop() ATLAS_NOEXCEPT;
+
+  bool IsRunning() const ATLAS_NOEXCEPT;
+
+  /**
+   * \throw std::out_of_range if there is no such stage.
+   */
+  PipelineStageStats GetStageStats(size_t stage) const;
+
+  /**
+   * \return The distribution of the processing time of one image by the
+   *         stage, without the time it waited in the queue.
+   *
+   * \throw std::out_of_range if there is no such stage.
+   */
+  const LatencyHistogram &GetStageLatency(size_t stage) const;
+
+  /**
+   * \return The distribution of the time from the capture of an image to its
+   *         notification by the pipeline.
+   */
+  const LatencyHistogram &GetLatency() const ATLAS_NOEXCEPT;
+
+  void ResetStats() ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Stage {
+    Stage(const std::string &stage_name, StageFunction stage_function,
+          size_t queue_capacity, QueuePolicy policy);
+
+    std::string name;
+
+    StageFunction function;
+
+    BoundedQueue<ImageFrame> input;
+
+    std::thread thread;
+
+    LatencyHistogram latency;
+
+    std::atomic<uint64_t> frame_count;
+
+    std::atomic<uint64_t> error_count;
+
+    std::atomic<uint64_t> depth_sum;
+
+    std::atomic<uint64_t> push_count;
+
+    std::atomic<size_t> max_depth;
+
+    /** The counters do not include the drops before this one. */
+    std::atomic<uint64_t> drop_base;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Queue the image notified by the capture for the first stage.
+   */
+  void OnSubjectNotify(Subject<ImageFrame> &subject,
+                       const ImageFrame &frame) ATLAS_NOEXCEPT override;
+
+  /**
+   * Queue an image for a stage and update the occupancy of its queue.
+   */
+  void Push(Stage &stage, ImageFrame &&frame);
+
+  /**
+   * The function of the thread of a stage, it processes the images until its
+   * input queue is closed and empty, then closes the queue of the next stage.
+   */
+  void RunStage(size_t index);
+
+  const Stage &GetStage(size_t stage) const;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  const size_t queue_capacity_;
+
+  const QueuePolicy input_policy_;
+
+  std::vector<std::unique_ptr<Stage>> stages_;
+
+  std::atomic<bool> running_;
+
+  LatencyHistogram latency_;
+
+  /** When the statistics started, from Deadline::Now(). */
+  std::atomic<int64_t> stats_start_ns_;
+
+  /** Serializes Start(), Stop() and AddStage(). */
+  mutable std::mutex state_mutex_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/image_pipeline_inl.h>
+
+#endif  // LIB_ATLAS_IO_IMAGE_PIPELINE_H_
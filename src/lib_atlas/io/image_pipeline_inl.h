@@ -0,0 +1,266 @@
+/**
+ * \file	image_pipeline_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_PIPELINE_H_
+#error This file may only be included from image_pipeline.h
+#endif
+
+#include <lib_atlas/io/details/deadline.h>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImagePipeline::Stage::Stage(const std::string &stage_name,
+                                         StageFunction stage_function,
+                                         size_t queue_capacity,
+                                         QueuePolicy policy)
+    : name(stage_name),
+      function(std::move(stage_function)),
+      input(queue_capacity, policy),
+      thread(),
+      latency(),
+      frame_count(0),
+      error_count(0),
+      depth_sum(0),
+      push_count(0),
+      max_depth(0),
+      drop_base(0) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImagePipeline::ImagePipeline(size_t queue_capacity,
+                                          QueuePolicy input_policy)
+    : Observer<ImageFrame>(),
+      Subject<ImageFrame>(),
+      queue_capacity_(queue_capacity),
+      input_policy_(input_policy),
+      stages_(),
+      running_(false),
+      latency_(),
+      stats_start_ns_(Deadline::Now()),
+      state_mutex_() {
+  if (queue_capacity == 0) {
+    throw std::invalid_argument("The capacity of the queues must not be 0.");
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImagePipeline::~ImagePipeline() ATLAS_NOEXCEPT { Stop(); }
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImagePipeline::AddStage(const std::string &name,
+                                          StageFunction function) {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  if (running_) {
+    throw std::logic_error("Cannot add a stage to a running pipeline.");
+  }
+  // Only the capture may be faster than the pipeline, the stages wait for
+  // each other.
+  QueuePolicy policy = stages_.empty() ? input_policy_ : QueuePolicy::BLOCK;
+  stages_.emplace_back(
+      new Stage(name, std::move(function), queue_capacity_, policy));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ImagePipeline::StageCount() const ATLAS_NOEXCEPT {
+  return stages_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImagePipeline::Start() {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  if (running_) {
+    return;
+  }
+  if (stages_.empty()) {
+    throw std::logic_error("The pipeline has no stage.");
+  }
+  ResetStats();
+  for (size_t i = 0; i < stages_.size(); ++i) {
+    stages_[i]->input.Reopen();
+    stages_[i]->thread = std::thread(&ImagePipeline::RunStage, this, i);
+  }
+  running_ = true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImagePipeline::Stop() ATLAS_NOEXCEPT {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  if (!running_) {
+    return;
+  }
+  running_ = false;
+  // Each stage closes the queue of the next one once it is done, so the
+  // images flow to the end of the pipeline.
+  stages_.front()->input.Close();
+  for (std::unique_ptr<Stage> &stage : stages_) {
+    stage->thread.join();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImagePipeline::IsRunning() const ATLAS_NOEXCEPT {
+  return running_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImagePipeline::OnSubjectNotify(
+    Subject<ImageFrame> &subject, const ImageFrame &frame) ATLAS_NOEXCEPT {
+  if (!running_) {
+    return;
+  }
+  Push(*stages_.front(), ImageFrame(frame));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImagePipeline::Push(Stage &stage, ImageFrame &&frame) {
+  if (!stage.input.Push(std::move(frame))) {
+    return;
+  }
+  size_t depth = stage.input.Size();
+  stage.depth_sum += depth;
+  ++stage.push_count;
+  size_t max_depth = stage.max_depth;
+  while (depth > max_depth &&
+         !stage.max_depth.compare_exchange_weak(max_depth, depth)) {
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImagePipeline::RunStage(size_t index) {
+  Stage &stage = *stages_[index];
+  Stage *next = index + 1 < stages_.size() ? stages_[index + 1].get() : nullptr;
+  ImageFrame frame;
+  while (stage.input.Pop(frame)) {
+    int64_t start_ns = Deadline::Now();
+    try {
+      // The frame keeps its capture time, sequence and source.
+      frame.image = stage.function(frame.image);
+      frame.pyramid.reset();
+    } catch (const std::exception &) {
+      ++stage.error_count;
+      continue;
+    }
+    stage.latency.Record(Deadline::Now() - start_ns);
+    ++stage.frame_count;
+    if (next != nullptr) {
+      Push(*next, std::move(frame));
+    } else {
+      latency_.Record(Deadline::Now() - frame.capture_ns);
+      frame.pyramid = std::make_shared<ImagePyramid>(frame.image);
+      Notify(frame);
+    }
+    frame.image.release();
+  }
+  if (next != nullptr) {
+    next->input.Close();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const ImagePipeline::Stage &ImagePipeline::GetStage(
+    size_t stage) const {
+  if (stage >= stages_.size()) {
+    throw std::out_of_range("The pipeline has no such stage.");
+  }
+  return *stages_[stage];
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE PipelineStageStats
+ImagePipeline::GetStageStats(size_t stage) const {
+  const Stage &entry = GetStage(stage);
+  PipelineStageStats stats;
+  stats.name = entry.name;
+  stats.frame_count = entry.frame_count;
+  stats.error_count = entry.error_count;
+  int64_t elapsed_ns = Deadline::Now() - stats_start_ns_;
+  stats.throughput = elapsed_ns <= 0 ? 0.0
+                                     : static_cast<double>(stats.frame_count) *
+                                           Deadline::kNanosecondsPerSecond /
+                                           elapsed_ns;
+  stats.queue_depth = entry.input.Size();
+  uint64_t push_count = entry.push_count;
+  stats.mean_queue_depth =
+      push_count == 0 ? 0.0 : static_cast<double>(entry.depth_sum) /
+                                  static_cast<double>(push_count);
+  stats.max_queue_depth = entry.max_depth;
+  stats.drop_count = entry.input.DropCount() - entry.drop_base;
+  return stats;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const LatencyHistogram &ImagePipeline::GetStageLatency(
+    size_t stage) const {
+  return GetStage(stage).latency;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const LatencyHistogram &ImagePipeline::GetLatency() const
+    ATLAS_NOEXCEPT {
+  return latency_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImagePipeline::ResetStats() ATLAS_NOEXCEPT {
+  for (std::unique_ptr<Stage> &stage : stages_) {
+    stage->latency.Reset();
+    stage->frame_count = 0;
+    stage->error_count = 0;
+    stage->depth_sum = 0;
+    stage->push_count = 0;
+    stage->max_depth = 0;
+    stage->drop_base = stage->input.DropCount();
+  }
+  latency_.Reset();
+  stats_start_ns_ = Deadline::Now();
+}
+
+}  // namespace atlas
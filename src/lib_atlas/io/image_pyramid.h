@@ -0,0 +1,93 @@
+/**
+ * \file	image_pyramid.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_PYRAMID_H_
+#define LIB_ATLAS_IO_IMAGE_PYRAMID_H_
+
+#include <lib_atlas/macros.h>
+#include <memory>
+#include <mutex>
+#include <opencv2/core/core.hpp>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * The downscaled versions of an image, each computed once on demand.
+ *
+ * The captures put a pyramid in each ImageFrame, so the consumers that need
+ * the same resolution of a frame share one downscale instead of computing
+ * their own, see FrameSampler.
+ */
+class ImagePyramid {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<ImagePyramid>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  explicit ImagePyramid(cv::Mat image);
+
+  ImagePyramid(const ImagePyramid &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  ImagePyramid &operator=(const ImagePyramid &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * This is thread safe, the first caller that needs a level computes it
+   * from the level above with cv::pyrDown and the others wait for it.
+   *
+   * \return The image downscaled by 2^level, level 0 is the image itself.
+   *         It must not be modified, it is shared by all the callers.
+   */
+  cv::Mat GetLevel(size_t level);
+
+  /**
+   * \return The number of levels computed so far, besides the image.
+   */
+  size_t ComputedLevelCount() const;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  mutable std::mutex mutex_;
+
+  std::vector<cv::Mat> levels_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/image_pyramid_inl.h>
+
+#endif  // LIB_ATLAS_IO_IMAGE_PYRAMID_H_
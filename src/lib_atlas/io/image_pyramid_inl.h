@@ -0,0 +1,69 @@
+/**
+ * \file	image_pyramid_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_PYRAMID_H_
+#error This file may only be included from image_pyramid.h
+#endif
+
+#include <opencv2/imgproc/imgproc.hpp>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImagePyramid::ImagePyramid(cv::Mat image)
+    : mutex_(), levels_() {
+  levels_.push_back(std::move(image));
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE cv::Mat ImagePyramid::GetLevel(size_t level) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (levels_.size() <= level) {
+    cv::Mat downscaled;
+    if (!levels_.back().empty()) {
+      cv::pyrDown(levels_.back(), downscaled);
+    }
+    levels_.push_back(std::move(downscaled));
+  }
+  return levels_[level];
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ImagePyramid::ComputedLevelCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return levels_.size() - 1;
+}
+
+}  // namespace atlas
@@ -0,0 +1,211 @@
+/**
+ * \file	image_recorder.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_RECORDER_H_
+#define LIB_ATLAS_IO_IMAGE_RECORDER_H_
+
+#include <lib_atlas/io/image_log.h>
+#include <lib_atlas/io/image_sequence_writer.h>
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Record the images in an image log, to be read back with ImageLogReader.
+ *
+ * The images are not encoded: the pixels are copied in a staging buffer and
+ * written with large writes at aligned offsets, so recording sustains the
+ * bandwidth of the disk rather than the one of an encoder. The file is
+ * preallocated in large chunks to keep the file system from fragmenting it
+ * and from allocating blocks on each write.
+ *
+ * With direct_io, the file is opened with O_DIRECT and the writes do not go
+ * through the page cache, which keeps a long recording from evicting the
+ * memory of the other processes. This falls back to buffered writes on file
+ * systems that do not support it, see IsDirectIO().
+ *
+ * A failure to write the file is counted and the frames it contained are
+ * left out of the index, it does not stop the recording.
+ *
+ * Sample usage:
+ *
+ *   atlas::ImageRecorder recorder("/tmp/front.ilog");
+ *   recorder.Observe(capture);
+ *   recorder.Start();
+ *   recorder.SetStreamingMode(true);
+ */
+class ImageRecorder : public ImageSequenceWriter {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<ImageRecorder>;
+
+  static const uint32_t kAlignment = 4096;
+
+  static const size_t kDefaultBufferSize = 8 * 1024 * 1024;
+
+  static const uint64_t kDefaultPreallocationSize = 256 * 1024 * 1024;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Create the log, replacing the file if it exists.
+   *
+   * \param path The path of the log.
+   * \param queue_capacity The number of images that can wait to be written.
+   * \param policy What to do with the images when the queue is full.
+   * \param buffer_size The size of the staging buffer, rounded up to a
+   *        multiple of kAlignment.
+   * \param preallocation_size The size of the chunks allocated ahead of the
+   *        writes, 0 to let the file system allocate on each write.
+   * \param direct_io Write with O_DIRECT, bypassing the page cache.
+   *
+   * \throw IOException if the log cannot be created.
+   */
+  explicit ImageRecorder(
+      const std::string &path, size_t queue_capacity = kDefaultQueueCapacity,
+      QueuePolicy policy = QueuePolicy::DROP_OLDEST,
+      size_t buffer_size = kDefaultBufferSize,
+      uint64_t preallocation_size = kDefaultPreallocationSize,
+      bool direct_io = false);
+
+  /**
+   * Write the images still in the queue and close the log.
+   */
+  ~ImageRecorder() ATLAS_NOEXCEPT;
+
+  ImageRecorder(const ImageRecorder &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  ImageRecorder &operator=(const ImageRecorder &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Write the staging buffer to the disk.
+   *
+   * The frames written so far can then be read from the log, even if the
+   * recording is interrupted before Close().
+   */
+  void Flush();
+
+  /**
+   * Write the staging buffer and the index, and close the file.
+   *
+   * The images written afterwards are ignored. This is called by the
+   * destructor, after Stop().
+   */
+  void Close();
+
+  bool IsDirectIO() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of bytes written to the file, including the padding.
+   */
+  uint64_t GetByteCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of writes of the file that failed, the frames they
+   *         contained are lost.
+   */
+  uint64_t GetErrorCount() const ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void WriteFrame(const ImageFrame &frame) override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /** Copy data to the staging buffer, the mutex must be held. */
+  void Append(const void *data, size_t size);
+
+  /** Pad the staging buffer to the alignment, the mutex must be held. */
+  void Align();
+
+  /** Write the staging buffer to the file, the mutex must be held. */
+  void WriteBuffer();
+
+  /** Write aligned data at an aligned offset, \return False on failure. */
+  bool WriteFile(const uint8_t *data, size_t size, uint64_t offset);
+
+  /** Rewrite the header at the start of the file. */
+  bool WriteHeader();
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  int fd_;
+
+  bool direct_io_;
+
+  ImageLogHeader header_;
+
+  /** Aligned on kAlignment for O_DIRECT. */
+  std::unique_ptr<uint8_t, void (*)(void *)> buffer_;
+
+  size_t buffer_size_;
+
+  size_t buffer_used_;
+
+  /** The offset of the start of the staging buffer in the file. */
+  uint64_t file_offset_;
+
+  uint64_t preallocation_size_;
+
+  /** The end of the space allocated ahead of the writes. */
+  uint64_t allocated_size_;
+
+  /** The end of the last write that failed, the frames before are lost. */
+  uint64_t lost_offset_;
+
+  std::vector<ImageLogEntry> index_;
+
+  std::mutex mutex_;
+
+  std::atomic<uint64_t> byte_count_;
+
+  std::atomic<uint64_t> error_count_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/image_recorder_inl.h>
+
+#endif  // LIB_ATLAS_IO_IMAGE_RECORDER_H_
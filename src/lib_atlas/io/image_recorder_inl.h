@@ -0,0 +1,316 @@
+/**
+ * \file	image_recorder_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_IMAGE_RECORDER_H_
+#error This file may only be included from image_recorder.h
+#endif
+
+#include <lib_atlas/io/details/deadline.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <new>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageRecorder::ImageRecorder(const std::string &path,
+                                          size_t queue_capacity,
+                                          QueuePolicy policy,
+                                          size_t buffer_size,
+                                          uint64_t preallocation_size,
+                                          bool direct_io)
+    : ImageSequenceWriter(queue_capacity, policy),
+      fd_(-1),
+      direct_io_(direct_io),
+      header_(),
+      buffer_(nullptr, &free),
+      buffer_size_(0),
+      buffer_used_(0),
+      file_offset_(kAlignment),
+      preallocation_size_(preallocation_size),
+      allocated_size_(0),
+      lost_offset_(0),
+      index_(),
+      mutex_(),
+      byte_count_(0),
+      error_count_(0) {
+  const size_t alignment = kAlignment;
+  buffer_size_ = (std::max(buffer_size, alignment) + alignment - 1) /
+                 alignment * alignment;
+  void *memory = nullptr;
+  if (posix_memalign(&memory, alignment, buffer_size_) != 0) {
+    throw std::bad_alloc();
+  }
+  buffer_.reset(static_cast<uint8_t *>(memory));
+
+  memcpy(header_.magic, kImageLogMagic, sizeof(header_.magic));
+  header_.version = kImageLogVersion;
+  header_.header_size = kAlignment;
+  timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  header_.start_realtime_ns =
+      static_cast<int64_t>(now.tv_sec) * Deadline::kNanosecondsPerSecond +
+      now.tv_nsec;
+  header_.start_monotonic_ns = Deadline::Now();
+  header_.alignment = kAlignment;
+
+  const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+  if (direct_io_) {
+    fd_ = ::open(path.c_str(), flags | O_DIRECT, 0644);
+    // Some file systems, e.g. tmpfs, refuse O_DIRECT either when opening or
+    // when writing.
+    if (fd_ != -1 && !WriteHeader()) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+    direct_io_ = fd_ != -1;
+  }
+  if (fd_ == -1) {
+    fd_ = ::open(path.c_str(), flags, 0644);
+    if (fd_ == -1) {
+      ATLAS_THROW(IOException, "open " << path << ": " << strerror(errno));
+    }
+    if (!WriteHeader()) {
+      int error = errno;
+      ::close(fd_);
+      ATLAS_THROW(IOException, "write " << path << ": " << strerror(error));
+    }
+  }
+  byte_count_ = kAlignment;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageRecorder::~ImageRecorder() ATLAS_NOEXCEPT {
+  Stop();
+  Close();
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageRecorder::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ == -1) {
+    return;
+  }
+  WriteBuffer();
+  fdatasync(fd_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageRecorder::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ == -1) {
+    return;
+  }
+  WriteBuffer();
+
+  // A failed write removes entries from index_, do not copy from it.
+  std::vector<ImageLogEntry> index;
+  index.swap(index_);
+  const uint64_t index_offset = file_offset_;
+  const uint64_t error_count = error_count_;
+  Append(index.data(), index.size() * sizeof(ImageLogEntry));
+  Align();
+  WriteBuffer();
+  uint64_t file_size = file_offset_;
+  if (error_count_ == error_count) {
+    // Without the index, the reader rebuilds it from the frames.
+    header_.frame_count = index.size();
+    header_.index_offset = index_offset;
+    file_size = index_offset + index.size() * sizeof(ImageLogEntry);
+    if (!WriteHeader()) {
+      ++error_count_;
+    }
+  }
+  // Give the preallocated space that was not used back.
+  if (ftruncate(fd_, static_cast<off_t>(file_size)) == -1) {
+    ++error_count_;
+  }
+  fdatasync(fd_);
+  ::close(fd_);
+  fd_ = -1;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageRecorder::IsDirectIO() const ATLAS_NOEXCEPT {
+  return direct_io_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t ImageRecorder::GetByteCount() const ATLAS_NOEXCEPT {
+  return byte_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t ImageRecorder::GetErrorCount() const ATLAS_NOEXCEPT {
+  return error_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageRecorder::WriteFrame(const ImageFrame &frame) {
+  const cv::Mat &image = frame.image;
+  if (image.empty()) {
+    return;
+  }
+  const size_t row_size = image.cols * image.elemSize();
+  ImageLogEntry entry;
+  memset(&entry, 0, sizeof(entry));
+  entry.timestamp_ns = frame.capture_ns;
+  entry.size = row_size * image.rows;
+  entry.rows = image.rows;
+  entry.cols = image.cols;
+  entry.type = image.type();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ == -1) {
+    return;
+  }
+  const uint64_t block_offset = file_offset_ + buffer_used_;
+  entry.offset = block_offset + kImageLogEntrySize;
+  uint8_t entry_block[kImageLogEntrySize] = {};
+  memcpy(entry_block, &entry, sizeof(entry));
+  Append(entry_block, sizeof(entry_block));
+  if (image.isContinuous()) {
+    Append(image.data, entry.size);
+  } else {
+    for (int row = 0; row < image.rows; ++row) {
+      Append(image.ptr(row), row_size);
+    }
+  }
+  Align();
+  if (block_offset >= lost_offset_) {
+    index_.push_back(entry);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageRecorder::Append(const void *data, size_t size) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  while (size != 0) {
+    size_t count = std::min(size, buffer_size_ - buffer_used_);
+    memcpy(buffer_.get() + buffer_used_, bytes, count);
+    buffer_used_ += count;
+    bytes += count;
+    size -= count;
+    if (buffer_used_ == buffer_size_) {
+      WriteBuffer();
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageRecorder::Align() {
+  // The buffer size is a multiple of the alignment, this never overflows.
+  size_t padding = (kAlignment - buffer_used_ % kAlignment) % kAlignment;
+  memset(buffer_.get() + buffer_used_, 0, padding);
+  buffer_used_ += padding;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageRecorder::WriteBuffer() {
+  if (buffer_used_ == 0) {
+    return;
+  }
+  const uint64_t end = file_offset_ + buffer_used_;
+  if (preallocation_size_ != 0 && end > allocated_size_) {
+    uint64_t size = (end - allocated_size_ + preallocation_size_ - 1) /
+                    preallocation_size_ * preallocation_size_;
+    if (fallocate(fd_, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(allocated_size_),
+                  static_cast<off_t>(size)) == 0) {
+      allocated_size_ += size;
+    } else {
+      // Not supported by the file system, do not try again.
+      preallocation_size_ = 0;
+    }
+  }
+
+  if (WriteFile(buffer_.get(), buffer_used_, file_offset_)) {
+    byte_count_ += buffer_used_;
+  } else {
+    ++error_count_;
+    const uint64_t lost_begin = file_offset_;
+    index_.erase(std::remove_if(index_.begin(), index_.end(),
+                                [lost_begin](const ImageLogEntry &entry) {
+                                  return entry.offset + entry.size >
+                                         lost_begin;
+                                }),
+                 index_.end());
+    // The frame being appended, if any, is lost as well.
+    lost_offset_ = end;
+  }
+  // Leave a hole on failure, so the offsets of the frames stay valid.
+  file_offset_ = end;
+  buffer_used_ = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageRecorder::WriteFile(const uint8_t *data, size_t size,
+                                           uint64_t offset) {
+  while (size != 0) {
+    ssize_t written = pwrite(fd_, data, size, static_cast<off_t>(offset));
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+    offset += static_cast<uint64_t>(written);
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageRecorder::WriteHeader() {
+  // The staging buffer is aligned for O_DIRECT, it is empty at this point.
+  memset(buffer_.get(), 0, kAlignment);
+  memcpy(buffer_.get(), &header_, sizeof(header_));
+  return WriteFile(buffer_.get(), kAlignment, 0);
+}
+
+}  // namespace atlas
@@ -26,8 +26,10 @@
 #ifndef LIB_ATLAS_IO_IMAGE_SEQUENCE_CAPTURE_H_
 #define LIB_ATLAS_IO_IMAGE_SEQUENCE_CAPTURE_H_
 
+#include <lib_atlas/io/image_frame.h>
 #include <lib_atlas/pattern/subject.h>
 #include <lib_atlas/sys/timer.h>
+#include <stdint.h>
 #include <atomic>
 #include <condition_variable>
 #include <memory>
@@ -37,18 +39,55 @@
 
 namespace atlas {
 
-class ImageSequenceCapture : public Subject<cv::Mat> {
+/**
+ * The regularity of the frames sent by an ImageSequenceCapture in streaming
+ * mode.
+ */
+struct FramePacingStats {
+  /** The number of frames sent since the last reset. */
+  uint64_t frame_count;
+
+  /** The average framerate achieved since the last reset. */
+  double framerate;
+
+  /** The mean difference between two consecutive frame intervals. */
+  int64_t jitter_ns;
+
+  /**
+   * The number of frames that came later than the max framerate allows,
+   * because the image source or the observers were too slow.
+   */
+  uint64_t overrun_count;
+};
+
+/**
+ * A source of images, e.g. a camera or a recording.
+ *
+ * In streaming mode, each image is notified to the observers in an
+ * ImageFrame with the time it was captured, its number in the sequence and
+ * the identifier of the capture. An empty image is not notified, a source
+ * returns one when it has nothing to send, e.g. at the end of a recording.
+ */
+class ImageSequenceCapture : public Subject<ImageFrame> {
  public:
   //==========================================================================
   // T Y P E D E F   A N D   E N U M
 
   using Ptr = std::shared_ptr<ImageSequenceCapture>;
 
+  /** The longest a stop request waits for the end of a framerate sleep. */
+  static const int kStopCheckPeriodMs = 100;
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
   ImageSequenceCapture() ATLAS_NOEXCEPT;
 
+  /**
+   * The derived classes must call Stop() in their destructor, the streaming
+   * thread calls GetNextImage() until it is stopped. The program terminates
+   * if the thread still runs here.
+   */
   virtual ~ImageSequenceCapture() ATLAS_NOEXCEPT;
 
   //============================================================================
@@ -68,6 +107,10 @@ class ImageSequenceCapture : public Subject<cv::Mat> {
    * loop will wait the appropriate time in order to have the expected max
    * framerate (only if the framerate is higher that the one manually
    * specified).
+   *
+   * The frames are scheduled on absolute times of CLOCK_MONOTONIC, so the
+   * time spent to get and send an image does not make the framerate drift.
+   * 0 sends the images as fast as they come.
    */
   virtual void SetMaxFramerate(double framerate);
 
@@ -90,12 +133,18 @@ class ImageSequenceCapture : public Subject<cv::Mat> {
   const cv::Mat &GetImage();
 
   /**
-   * Start the ImageSequenceProvider by Openning the media -- see Open().
+   * Start the streaming thread.
+   *
+   * The thread sleeps until the streaming mode is enabled, it does not use
+   * any CPU in the meantime.
    */
   void Start() ATLAS_NOEXCEPT;
 
   /**
-   * Stop the ImageSequenceProvider by closing the media -- see Close().
+   * Stop the streaming thread and wait for it to finish.
+   *
+   * This waits for the image being sent, and at most kStopCheckPeriodMs for
+   * the end of a framerate sleep.
    */
   void Stop() ATLAS_NOEXCEPT;
 
@@ -125,12 +174,35 @@ class ImageSequenceCapture : public Subject<cv::Mat> {
    */
   bool IsStreaming() const ATLAS_NOEXCEPT;
 
+  /**
+   * \return The pacing of the frames sent since the creation or the last
+   *         call to ResetPacingStats().
+   */
+  FramePacingStats GetPacingStats() const;
+
+  void ResetPacingStats();
+
+  /**
+   * Set the identifier written in the frames, to tell the captures apart
+   * when several of them feed the same observers. It is 0 by default.
+   */
+  void SetSourceId(uint32_t source_id) ATLAS_NOEXCEPT;
+
+  uint32_t GetSourceId() const ATLAS_NOEXCEPT;
+
  protected:
   //============================================================================
   // P R O T E C T E D   M E T H O D S
 
   virtual const cv::Mat &GetNextImage() const = 0;
 
+  /**
+   * \return The pooled buffer of the last image returned by GetNextImage(),
+   *         given to the observers with the frame. Null by default, for the
+   *         sources that do not take their images from a FramePool.
+   */
+  virtual FramePool::Frame GetImageBuffer() const;
+
  private:
   //============================================================================
   // P R I V A T E   M E T H O D S
@@ -139,28 +211,52 @@ class ImageSequenceCapture : public Subject<cv::Mat> {
    * The thread function that is going to notify all the observer of this
    * Image Provider if we are in streaming mode.
    *
-   * This is going to wait for the running_ flag to be true, and the will start.
+   * The thread waits on the condition variable while the streaming mode is
+   * disabled, and sleeps until the time of the next frame if there is a
+   * max framerate.
    */
   void StreamingLoop() ATLAS_NOEXCEPT;
 
+  /**
+   * Sleep until the given time of CLOCK_MONOTONIC, or until a stop.
+   *
+   * \return False if the thread has been stopped.
+   */
+  bool SleepUntil(int64_t time_ns) const ATLAS_NOEXCEPT;
+
+  /** Update the pacing statistics with a frame sent at the given time. */
+  void RecordFrame(int64_t time_ns, bool overrun) ATLAS_NOEXCEPT;
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
   double max_framerate_;
 
-  uint64_t frame_count_;
-
-  double total_streaming_time_;
+  std::atomic<uint64_t> frame_count_;
 
   std::atomic<bool> streaming_;
 
   std::atomic<bool> running_;
 
+  std::atomic<uint32_t> source_id_;
+
   std::unique_ptr<std::thread> streaming_thread_;
 
+  /** Wakes up the streaming thread when the streaming mode changes. */
   std::condition_variable cv;
 
   mutable std::mutex cv_mutex_;
+
+  // The pacing statistics, protected by cv_mutex_. The intervals across a
+  // pause of the streaming are not counted.
+  uint64_t paced_frame_count_;
+  uint64_t overrun_count_;
+  uint64_t interval_count_;
+  uint64_t jitter_count_;
+  int64_t streaming_ns_;
+  int64_t total_jitter_ns_;
+  int64_t last_frame_ns_;
+  int64_t last_interval_ns_;
 };
 
 }  // namespace atlas
@@ -27,8 +27,15 @@
 #error This file may only be included from image_sequence_capture.h
 #endif
 
-#include <lib_atlas/sys/timer.h>
+#include <lib_atlas/io/details/deadline.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
 #include <functional>
+#include <utility>
 
 namespace atlas {
 
@@ -40,17 +47,34 @@ namespace atlas {
 ATLAS_ALWAYS_INLINE ImageSequenceCapture::ImageSequenceCapture() ATLAS_NOEXCEPT
     : max_framerate_(0),
       frame_count_(0),
-      total_streaming_time_(0),
       streaming_(false),
       running_(false),
+      source_id_(0),
       streaming_thread_(),
       cv(),
-      cv_mutex_() {}
+      cv_mutex_(),
+      paced_frame_count_(0),
+      overrun_count_(0),
+      interval_count_(0),
+      jitter_count_(0),
+      streaming_ns_(0),
+      total_jitter_ns_(0),
+      last_frame_ns_(0),
+      last_interval_ns_(0) {}
 
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE ImageSequenceCapture::~ImageSequenceCapture()
-    ATLAS_NOEXCEPT {}
+    ATLAS_NOEXCEPT {
+  if (streaming_thread_ != nullptr) {
+    // The derived object is gone and its GetNextImage() may run anyway, fail
+    // here rather than on a pure virtual call or a dangling member.
+    fputs("An ImageSequenceCapture is destroyed while its streaming thread "
+          "runs, call Stop() in the destructor of the derived class.\n",
+          stderr);
+    std::terminate();
+  }
+}
 
 //==============================================================================
 // M E T H O D S   S E C T I O N
@@ -68,66 +92,229 @@ ATLAS_ALWAYS_INLINE const cv::Mat &ImageSequenceCapture::GetImage() {
 
 //------------------------------------------------------------------------------
 //
-void ImageSequenceCapture::Start() ATLAS_NOEXCEPT {
+ATLAS_INLINE FramePool::Frame ImageSequenceCapture::GetImageBuffer() const {
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageSequenceCapture::Start() ATLAS_NOEXCEPT {
   std::lock_guard<std::mutex> lock(cv_mutex_);
+  if (running_) {
+    return;
+  }
   running_ = true;
+  streaming_thread_.reset(
+      new std::thread(&ImageSequenceCapture::StreamingLoop, this));
 }
 
 //------------------------------------------------------------------------------
 //
-void ImageSequenceCapture::Stop() ATLAS_NOEXCEPT { running_ = false; }
+ATLAS_INLINE void ImageSequenceCapture::Stop() ATLAS_NOEXCEPT {
+  {
+    std::lock_guard<std::mutex> lock(cv_mutex_);
+    running_ = false;
+  }
+  cv.notify_all();
+  if (streaming_thread_ != nullptr && streaming_thread_->joinable() &&
+      streaming_thread_->get_id() != std::this_thread::get_id()) {
+    streaming_thread_->join();
+    streaming_thread_.reset();
+  }
+}
 
 //------------------------------------------------------------------------------
 //
-double ImageSequenceCapture::GetMaxFramerate() const ATLAS_NOEXCEPT {
+ATLAS_INLINE double ImageSequenceCapture::GetMaxFramerate() const
+    ATLAS_NOEXCEPT {
+  std::lock_guard<std::mutex> lock(cv_mutex_);
   return max_framerate_;
 }
 
 //------------------------------------------------------------------------------
 //
-void ImageSequenceCapture::SetMaxFramerate(double framerate) {
+ATLAS_INLINE void ImageSequenceCapture::SetMaxFramerate(double framerate) {
+  if (framerate < 0) {
+    throw std::invalid_argument("The framerate cannot be negative.");
+  }
+  std::lock_guard<std::mutex> lock(cv_mutex_);
   max_framerate_ = framerate;
 }
 
 //------------------------------------------------------------------------------
 //
-uint64_t ImageSequenceCapture::GetFrameCount() const ATLAS_NOEXCEPT {
+ATLAS_INLINE uint64_t ImageSequenceCapture::GetFrameCount() const
+    ATLAS_NOEXCEPT {
   return frame_count_;
 }
 
 //------------------------------------------------------------------------------
 //
-void ImageSequenceCapture::SetStreamingMode(bool streaming) ATLAS_NOEXCEPT {
-  streaming_ = streaming;
+ATLAS_INLINE void ImageSequenceCapture::SetStreamingMode(bool streaming)
+    ATLAS_NOEXCEPT {
+  {
+    std::lock_guard<std::mutex> lock(cv_mutex_);
+    streaming_ = streaming;
+  }
+  cv.notify_all();
 }
 
 //------------------------------------------------------------------------------
 //
-bool ImageSequenceCapture::IsStreaming() const ATLAS_NOEXCEPT {
+ATLAS_INLINE bool ImageSequenceCapture::IsStreaming() const ATLAS_NOEXCEPT {
   return streaming_;
 }
 
 //------------------------------------------------------------------------------
 //
-bool ImageSequenceCapture::IsRunning() const ATLAS_NOEXCEPT { return running_; }
+ATLAS_INLINE bool ImageSequenceCapture::IsRunning() const ATLAS_NOEXCEPT {
+  return running_;
+}
 
 //------------------------------------------------------------------------------
 //
-ATLAS_ALWAYS_INLINE void ImageSequenceCapture::StreamingLoop() ATLAS_NOEXCEPT {
-  std::unique_lock<std::mutex> lock(cv_mutex_);
-  cv.wait(lock, [=] { return static_cast<bool>(running_); });
+ATLAS_INLINE void ImageSequenceCapture::SetSourceId(uint32_t source_id)
+    ATLAS_NOEXCEPT {
+  source_id_ = source_id;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint32_t ImageSequenceCapture::GetSourceId() const
+    ATLAS_NOEXCEPT {
+  return source_id_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE FramePacingStats ImageSequenceCapture::GetPacingStats() const {
+  std::lock_guard<std::mutex> lock(cv_mutex_);
+  FramePacingStats stats;
+  stats.frame_count = paced_frame_count_;
+  stats.framerate = streaming_ns_ == 0
+                        ? 0.0
+                        : static_cast<double>(interval_count_) * 1e9 /
+                              static_cast<double>(streaming_ns_);
+  stats.jitter_ns = jitter_count_ == 0
+                        ? 0
+                        : total_jitter_ns_ /
+                              static_cast<int64_t>(jitter_count_);
+  stats.overrun_count = overrun_count_;
+  return stats;
+}
 
-  MilliTimer timer;
-  timer.Start();
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageSequenceCapture::ResetPacingStats() {
+  std::lock_guard<std::mutex> lock(cv_mutex_);
+  paced_frame_count_ = overrun_count_ = 0;
+  interval_count_ = jitter_count_ = 0;
+  streaming_ns_ = total_jitter_ns_ = 0;
+  last_frame_ns_ = last_interval_ns_ = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageSequenceCapture::RecordFrame(int64_t time_ns,
+                                                    bool overrun)
+    ATLAS_NOEXCEPT {
+  ++paced_frame_count_;
+  if (overrun) {
+    ++overrun_count_;
+  }
+  if (last_frame_ns_ != 0) {
+    int64_t interval_ns = time_ns - last_frame_ns_;
+    streaming_ns_ += interval_ns;
+    ++interval_count_;
+    if (last_interval_ns_ != 0) {
+      total_jitter_ns_ += std::llabs(interval_ns - last_interval_ns_);
+      ++jitter_count_;
+    }
+    last_interval_ns_ = interval_ns;
+  }
+  last_frame_ns_ = time_ns;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ImageSequenceCapture::SleepUntil(int64_t time_ns) const
+    ATLAS_NOEXCEPT {
+  const int64_t period_ns =
+      kStopCheckPeriodMs * Deadline::kNanosecondsPerMillisecond;
   while (running_) {
-    if (streaming_) {
-      if (max_framerate_ != 0 && max_framerate_ < 1 / timer.Seconds()) {
-        cv.wait(lock, [&] { return max_framerate_ < 1 / timer.Seconds(); });
+    int64_t now = Deadline::Now();
+    if (now >= time_ns) {
+      return true;
+    }
+    // An absolute wake up time does not drift with the time spent here.
+    timespec wake_up = Deadline::ToTimeSpec(std::min(time_ns, now + period_ns));
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_up, nullptr);
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageSequenceCapture::StreamingLoop() ATLAS_NOEXCEPT {
+  // The time at which the next frame must be sent, 0 to send it right away.
+  int64_t next_frame_ns = 0;
+  std::unique_lock<std::mutex> lock(cv_mutex_);
+  while (running_) {
+    if (!streaming_) {
+      // Sleep until there is something to do.
+      cv.wait(lock, [this] { return !running_ || streaming_; });
+      // Do not try to catch up with the frames of the pause.
+      next_frame_ns = 0;
+      last_frame_ns_ = last_interval_ns_ = 0;
+      continue;
+    }
+    int64_t period_ns =
+        max_framerate_ > 0
+            ? static_cast<int64_t>(Deadline::kNanosecondsPerSecond /
+                                   max_framerate_)
+            : 0;
+    // The observers may use this object, do not hold the lock while they run.
+    lock.unlock();
+    if (period_ns > 0 && next_frame_ns != 0 && !SleepUntil(next_frame_ns)) {
+      lock.lock();
+      break;
+    }
+    int64_t frame_ns = Deadline::Now();
+    const cv::Mat &image = GetNextImage();
+    if (image.empty()) {
+      // Nothing to send, try again at the next frame time, or after a while
+      // if the source stays in streaming mode without any image.
+      const int64_t retry_ns =
+          period_ns > 0
+              ? period_ns
+              : kStopCheckPeriodMs * Deadline::kNanosecondsPerMillisecond;
+      lock.lock();
+      cv.wait_for(lock, std::chrono::nanoseconds(retry_ns),
+                  [this] { return !running_ || !streaming_; });
+      continue;
+    }
+    // GetNextImage() may wait for the device, the image is captured now.
+    ImageFrame frame(image, Deadline::Now(), frame_count_++, source_id_);
+    frame.pyramid = std::make_shared<ImagePyramid>(image);
+    frame.buffer = GetImageBuffer();
+    Notify(frame);
+
+    bool overrun = false;
+    if (period_ns > 0) {
+      next_frame_ns = (next_frame_ns == 0 ? frame_ns : next_frame_ns) +
+                      period_ns;
+      int64_t now = Deadline::Now();
+      if (now > next_frame_ns) {
+        // Too slow for the framerate, send the next frame right away but do
+        // not send a burst to catch up.
+        overrun = true;
+        next_frame_ns = now;
       }
-      timer.Reset();
-      Notify(GetNextImage());
-      ++frame_count_;
+    } else {
+      next_frame_ns = 0;
     }
+    lock.lock();
+    RecordFrame(frame_ns, overrun);
   }
 }
 
@@ -26,28 +26,63 @@
 #ifndef LIB_ATLAS_IO_IMAGE_SEQUENCE_WRITER_H_
 #define LIB_ATLAS_IO_IMAGE_SEQUENCE_WRITER_H_
 
+#include <lib_atlas/io/image_frame.h>
 #include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/bounded_queue.h>
 #include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/sys/latency_histogram.h>
 #include <lib_atlas/sys/timer.h>
+#include <stdint.h>
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <opencv2/core/core.hpp>
+#include <string>
 #include <thread>
 
 namespace atlas {
 
-class ImageSequenceWriter : public Observer<const cv::Mat &> {
+/**
+ * Write the images streamed by an ImageSequenceCapture, or the ones given to
+ * Write().
+ *
+ * When streaming, the images are not written on the thread of the capture:
+ * each writer has its own bounded queue and worker thread, so a slow writer
+ * does not slow the capture nor the other writers down. The policy of the
+ * queue tells what happens to the images when the writer is late.
+ *
+ * A frame whose pixels are in a FramePool buffer is queued as is, it keeps
+ * the buffer until it is written. The image of any other frame is cloned
+ * when it is queued, as its source may write the next image in the same
+ * buffer.
+ *
+ * A WriteFrame() that throws on the worker thread does not stop it, the
+ * failure is counted, see FailureCount(), and the next images are written.
+ *
+ * The derived classes must call Stop() in their destructor, the worker
+ * thread calls WriteFrame().
+ */
+class ImageSequenceWriter : public Observer<ImageFrame> {
  public:
   //==========================================================================
   // T Y P E D E F   A N D   E N U M
 
   using Ptr = std::shared_ptr<ImageSequenceWriter>;
 
+  static const size_t kDefaultQueueCapacity = 4;
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
-  ImageSequenceWriter() ATLAS_NOEXCEPT;
+  /**
+   * \param queue_capacity The number of images that can wait to be written.
+   * \param policy What to do with the images when the queue is full.
+   *
+   * \throw std::invalid_argument if the capacity is 0.
+   */
+  explicit ImageSequenceWriter(
+      size_t queue_capacity = kDefaultQueueCapacity,
+      QueuePolicy policy = QueuePolicy::DROP_OLDEST);
 
   virtual ~ImageSequenceWriter() ATLAS_NOEXCEPT;
 
@@ -55,30 +90,35 @@ class ImageSequenceWriter : public Observer<const cv::Mat &> {
   // P U B L I C  M E T H O D S
 
   /**
-   * \return The total of frame count from the moment the ImageSequenceProvider
-   *         have been created.
+   * \return The number of images written since the writer was created.
    */
   virtual uint64_t FrameCount() const ATLAS_NOEXCEPT;
 
   /**
-   * If the ImageSequenceProvider is not streaming, this will return the next
-   * image of the sequence.
+   * Write an image on the calling thread, when the writer is running but not
+   * streaming.
    *
-   * If the ImageSequenceProvider is currently streaming, the image will rather
-   * be sent to all the observer and the users should not try to get the image
-   * manually.
+   * The image is stamped as captured now, with the number of frames written
+   * as sequence number.
    *
-   * \return The next image, if the ImageSequenceProvider is not streaming.
+   * \throw std::logic_error if the writer is not running or is streaming.
    */
   void Write(const cv::Mat &);
 
   /**
-   * Start the ImageSequenceProvider by Openning the media -- see Open().
+   * Write a frame on the calling thread, see Write(const cv::Mat &).
+   *
+   * \throw std::logic_error if the writer is not running or is streaming.
+   */
+  void Write(const ImageFrame &frame);
+
+  /**
+   * Start the worker thread that writes the streamed images.
    */
-  void Start() ATLAS_NOEXCEPT;
+  void Start();
 
   /**
-   * Stop the ImageSequenceProvider by closing the media -- see Close().
+   * Write the images still in the queue and stop the worker thread.
    */
   void Stop() ATLAS_NOEXCEPT;
 
@@ -95,7 +135,8 @@ class ImageSequenceWriter : public Observer<const cv::Mat &> {
   /**
    * Set the streaming mode to true or false.
    *
-   * Synchronise the streaming flag ressource and set it to the passed argument
+   * When streaming, the images notified by the observed captures are queued
+   * for the worker thread.
    *
    * \param streaming The flag to enable or disable the streaming mode.
    */
@@ -108,33 +149,93 @@ class ImageSequenceWriter : public Observer<const cv::Mat &> {
    */
   bool IsStreaming() const ATLAS_NOEXCEPT;
 
+  /**
+   * \return The number of images waiting to be written.
+   */
+  size_t QueueDepth() const;
+
+  size_t QueueCapacity() const ATLAS_NOEXCEPT;
+
+  QueuePolicy GetQueuePolicy() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of streamed images that were not written because the
+   *         writer was late.
+   */
+  uint64_t DropCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of streamed images whose WriteFrame() threw, they
+   *         are lost.
+   */
+  uint64_t FailureCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The message of the last exception thrown by WriteFrame() on the
+   *         worker thread, empty if there was none.
+   */
+  std::string GetLastFailure() const;
+
+  /**
+   * \return The distribution of the time from the capture of an image to
+   *         the end of its write, whether it was streamed or given to
+   *         Write().
+   */
+  const LatencyHistogram &GetLatency() const ATLAS_NOEXCEPT;
+
+  void ResetLatency() ATLAS_NOEXCEPT;
+
  protected:
   //============================================================================
   // P R O T E C T E D   M E T H O D S
 
-  virtual void WriteImage(const cv::Mat &image) = 0;
+  virtual void WriteFrame(const ImageFrame &frame) = 0;
 
  private:
   //============================================================================
   // P R I V A T E   M E T H O D S
 
   /**
-   * The thread function that is going to notify all the observer of this
-   * Image Provider if we are in streaming mode.
+   * Queue the image notified by a capture if we are in streaming mode.
    *
-   * This is going to wait for the running_ flag to be true, and the will start.
+   * This is called on the thread of the capture, so it only waits if the
+   * policy of the queue is BLOCK.
    */
-  virtual void OnSubjectNotify(Subject<const cv::Mat &> &subject,
-                               const cv::Mat &image) ATLAS_NOEXCEPT override;
+  void OnSubjectNotify(Subject<ImageFrame> &subject,
+                       const ImageFrame &frame) ATLAS_NOEXCEPT override;
+
+  /**
+   * The function of the worker thread, it writes the queued images until the
+   * queue is closed and empty.
+   */
+  void WriteQueuedImages();
+
+  /** Write a frame and account for it. */
+  void WriteAndRecord(const ImageFrame &frame);
 
   //============================================================================
   // P R I V A T E   M E M B E R S
 
-  uint64_t frame_count_;
+  std::atomic<uint64_t> frame_count_;
+
+  std::atomic<uint64_t> failure_count_;
+
+  std::string last_failure_;
+
+  mutable std::mutex failure_mutex_;
+
+  std::atomic<bool> streaming_;
+
+  std::atomic<bool> running_;
+
+  BoundedQueue<ImageFrame> queue_;
+
+  LatencyHistogram latency_;
 
-  bool streaming_;
+  std::thread worker_;
 
-  bool running_;
+  /** Serializes Start() and Stop(). */
+  std::mutex state_mutex_;
 };
 
 }  // namespace atlas
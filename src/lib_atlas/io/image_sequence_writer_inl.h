@@ -27,8 +27,9 @@
 #error This file may only be included from image_sequence_writer.h
 #endif
 
-#include <lib_atlas/sys/timer.h>
-#include <functional>
+#include <lib_atlas/io/details/deadline.h>
+#include <stdexcept>
+#include <utility>
 
 namespace atlas {
 
@@ -37,14 +38,24 @@ namespace atlas {
 
 //------------------------------------------------------------------------------
 //
-ATLAS_ALWAYS_INLINE ImageSequenceWriter::ImageSequenceWriter() ATLAS_NOEXCEPT
+ATLAS_ALWAYS_INLINE ImageSequenceWriter::ImageSequenceWriter(
+    size_t queue_capacity, QueuePolicy policy)
     : frame_count_(0),
+      failure_count_(0),
+      last_failure_(),
+      failure_mutex_(),
       streaming_(false),
-      running_(false) {}
+      running_(false),
+      queue_(queue_capacity, policy),
+      latency_(),
+      worker_(),
+      state_mutex_() {}
 
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE ImageSequenceWriter::~ImageSequenceWriter() ATLAS_NOEXCEPT {
+  // Only a safety net, WriteFrame() is already gone at this point.
+  Stop();
 }
 
 //==============================================================================
@@ -53,40 +64,95 @@ ATLAS_ALWAYS_INLINE ImageSequenceWriter::~ImageSequenceWriter() ATLAS_NOEXCEPT {
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE void ImageSequenceWriter::OnSubjectNotify(
-    Subject<const cv::Mat &> &subject, const cv::Mat &image) ATLAS_NOEXCEPT {
-  if (IsStreaming()) {
-    WriteImage(image);
-    ++frame_count_;
+    Subject<ImageFrame> &subject, const ImageFrame &frame) ATLAS_NOEXCEPT {
+  if (!IsStreaming() || !IsRunning()) {
     return;
   }
+  if (frame.buffer != nullptr) {
+    queue_.Push(frame);
+  } else {
+    // The source may write its next image in the same buffer. The pyramid
+    // is not kept, it would compute its levels from that buffer.
+    queue_.Push(ImageFrame(frame.image.clone(), frame.capture_ns,
+                           frame.sequence, frame.source_id));
+  }
 }
 
 //------------------------------------------------------------------------------
 //
-ATLAS_ALWAYS_INLINE void ImageSequenceWriter::Write(const cv::Mat &image) {
-  if (running_) {
-    if (!IsStreaming()) {
-      ++frame_count_;
-      WriteImage(image);
-      return;
+ATLAS_ALWAYS_INLINE void ImageSequenceWriter::WriteQueuedImages() {
+  ImageFrame frame;
+  while (queue_.Pop(frame)) {
+    try {
+      WriteAndRecord(frame);
+    } catch (const std::exception &e) {
+      // Nobody waits for the streamed images, the failure is kept for
+      // GetLastFailure() and the writer carries on with the next images.
+      std::lock_guard<std::mutex> lock(failure_mutex_);
+      last_failure_ = e.what();
+      ++failure_count_;
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(failure_mutex_);
+      last_failure_ = "Unknown exception.";
+      ++failure_count_;
     }
+    // Do not keep the image, nor its pooled buffer, until the next one.
+    frame = ImageFrame();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void ImageSequenceWriter::WriteAndRecord(
+    const ImageFrame &frame) {
+  WriteFrame(frame);
+  ++frame_count_;
+  latency_.Record(Deadline::Now() - frame.capture_ns);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void ImageSequenceWriter::Write(const cv::Mat &image) {
+  Write(ImageFrame(image, Deadline::Now(), frame_count_, 0));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void ImageSequenceWriter::Write(const ImageFrame &frame) {
+  if (!running_) {
     throw std::logic_error(
         "The image writer is not running, cannot Write the image.");
   }
-  throw std::logic_error(
-      "The image writer is streaming, cannot Write the image.");
+  if (IsStreaming()) {
+    throw std::logic_error(
+        "The image writer is streaming, cannot Write the image.");
+  }
+  WriteAndRecord(frame);
 }
 
 //------------------------------------------------------------------------------
 //
-ATLAS_ALWAYS_INLINE void ImageSequenceWriter::Start() ATLAS_NOEXCEPT {
+ATLAS_ALWAYS_INLINE void ImageSequenceWriter::Start() {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  if (running_) {
+    return;
+  }
+  queue_.Reopen();
+  worker_ = std::thread(&ImageSequenceWriter::WriteQueuedImages, this);
   running_ = true;
 }
 
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE void ImageSequenceWriter::Stop() ATLAS_NOEXCEPT {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  if (!running_) {
+    return;
+  }
   running_ = false;
+  // The worker writes what is left in the queue before it returns.
+  queue_.Close();
+  worker_.join();
 }
 
 //------------------------------------------------------------------------------
@@ -116,4 +182,58 @@ ATLAS_ALWAYS_INLINE bool ImageSequenceWriter::IsRunning() const ATLAS_NOEXCEPT {
   return running_;
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE size_t ImageSequenceWriter::QueueDepth() const {
+  return queue_.Size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE size_t ImageSequenceWriter::QueueCapacity() const
+    ATLAS_NOEXCEPT {
+  return queue_.Capacity();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE QueuePolicy ImageSequenceWriter::GetQueuePolicy() const
+    ATLAS_NOEXCEPT {
+  return queue_.GetPolicy();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE uint64_t ImageSequenceWriter::DropCount() const
+    ATLAS_NOEXCEPT {
+  return queue_.DropCount();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE uint64_t ImageSequenceWriter::FailureCount() const
+    ATLAS_NOEXCEPT {
+  return failure_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE std::string ImageSequenceWriter::GetLastFailure() const {
+  std::lock_guard<std::mutex> lock(failure_mutex_);
+  return last_failure_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE const LatencyHistogram &ImageSequenceWriter::GetLatency()
+    const ATLAS_NOEXCEPT {
+  return latency_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void ImageSequenceWriter::ResetLatency() ATLAS_NOEXCEPT {
+  latency_.Reset();
+}
+
 }  // namespace atlas
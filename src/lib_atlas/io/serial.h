@@ -37,10 +37,15 @@
 #define LIB_ATLAS_IO_SERIAL_H_
 
 #include <lib_atlas/exceptions.h>
+#include <lib_atlas/io/details/chunk_timestamps.h>
 #include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/queue_policy.h>
+#include <lib_atlas/sys/latency_histogram.h>
 #include <stdint.h>
+#include <sys/uio.h>
 #include <cstring>
 #include <exception>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -93,6 +98,51 @@ typedef enum {
   flowcontrol_hardware = 2
 } flowcontrol_t;
 
+/**
+ * Enumeration defines the possible latency profiles for the serial port.
+ *
+ * latency_default favours few system calls: a fixed size read waits for the
+ * predicted transmission time of the missing bytes before reading them.
+ *
+ * latency_low favours the reaction time: the driver is asked to deliver
+ * every byte as soon as it arrives (ASYNC_LOW_LATENCY, which lowers the
+ * latency timer of the USB adapters to 1 ms) and the reads take what is
+ * available as soon as the port wakes up, at the cost of more system calls.
+ * Both profiles wait for the data with ppoll, which enforces the timeouts.
+ */
+typedef enum { latency_default = 0, latency_low = 1 } latency_t;
+
+/**
+ * Enumeration defines the outcome of the non throwing operations of the
+ * serial port, see Serial::TryRead.
+ */
+typedef enum {
+  status_ok = 0,
+  status_timeout = 1,
+  status_not_open = 2,
+  status_disconnected = 3,
+  status_io_error = 4
+} status_t;
+
+/**
+ * The result of a non throwing operation of the serial port.
+ */
+struct IOResult {
+  status_t status;
+  /** The bytes transferred, even if the operation failed or timed out. */
+  size_t bytes;
+  /** The errno of the system call that failed, for status_io_error. */
+  int error;
+};
+
+/**
+ * Enumeration defines the direction of the data going through the port.
+ */
+typedef enum {
+  direction_rx = 0,
+  direction_tx = 1
+} direction_t;
+
 /**
  * Structure for setting the timeout of the serial port, times are
  * in milliseconds.
@@ -170,6 +220,10 @@ class Serial {
 
   using Ptr = std::shared_ptr<Serial>;
 
+  /** Called with the bytes read from or written to the device. */
+  using TrafficCallback =
+      std::function<void(direction_t, const uint8_t *, size_t)>;
+
   //============================================================================
   // P U B L I C   C / D T O R S
 
@@ -247,13 +301,29 @@ class Serial {
   /** Closes the serial port. */
   void Close();
 
-  /** Return the number of characters in the buffer. */
+  /** Gets the file descriptor of the serial port.
+   *
+   * This is meant for the integration of the port in an event loop
+   * (e.g. SerialReactor). Reading or writing directly on the file descriptor
+   * bypasses the locks and the receive buffer of this class.
+   *
+   * \return The file descriptor, -1 if the port is not open.
+   */
+  int GetFileDescriptor() const;
+
+  /** Return the number of characters in the buffer.
+   *
+   * This includes the bytes that have already been received by a previous
+   * ReadLine call but not yet returned to the user. Takes the read lock, it
+   * waits for a read in progress on another thread.
+   */
   size_t Available();
 
   /** Block until there is serial data to read or read_timeout_constant
    * number of milliseconds have elapsed. The return value is true when
    * the function exits with the port in a readable state, false otherwise
-   * (due to timeout or select interruption). */
+   * (due to timeout or select interruption). The read lock is held while
+   * waiting. */
   bool WaitReadable();
 
   /** Block for a period of time corresponding to the transmission time of
@@ -292,7 +362,30 @@ class Serial {
    */
   size_t Read(uint8_t *buffer, size_t size);
 
+  /** Read whatever is available from the serial port, up to a given amount
+   * of bytes, into a given buffer.
+   *
+   * Unlike Read, this does not wait for the requested amount of bytes. It
+   * returns as soon as some data have been read, or when the timeout expires
+   * if nothing was received. Timeouts of the port are ignored.
+   *
+   * \param buffer An uint8_t array of at least the requested size.
+   * \param size A size_t defining the maximum number of bytes to read.
+   * \param timeout_ms The maximum time to wait for data, in milliseconds.
+   *        Zero only reads what is already available.
+   *
+   * \return A size_t representing the number of bytes read, zero if the
+   *         timeout expired.
+   *
+   * \throw serial::PortNotOpenedException
+   * \throw serial::SerialException
+   */
+  size_t ReadSome(uint8_t *buffer, size_t size, uint32_t timeout_ms);
+
   /** Read a given amount of bytes from the serial port into a give buffer.
+   *
+   * The data are appended to the vector by reading directly in its storage,
+   * so no allocation occurs if its capacity is large enough.
    *
    * \param buffer A reference to a std::vector of uint8_t.
    * \param size A size_t defining how many bytes to be read.
@@ -306,6 +399,9 @@ class Serial {
   size_t Read(std::vector<uint8_t> &buffer, size_t size = 1);
 
   /** Read a given amount of bytes from the serial port into a give buffer.
+   *
+   * The data are appended to the string by reading directly in its storage,
+   * so no allocation occurs if its capacity is large enough.
    *
    * \param buffer A reference to a std::string.
    * \param size A size_t defining how many bytes to be read.
@@ -334,6 +430,11 @@ class Serial {
    *
    * Reads from the serial port until a single line has been read.
    *
+   * The data is pulled from the driver by chunks of whatever is available
+   * and the bytes received after the delimiter are kept for the next read,
+   * so a line typically costs a couple of system calls instead of one per
+   * byte.
+   *
    * \param buffer A std::string reference used to store the data.
    * \param size A maximum length of a line, defaults to 65536 (2^16)
    * \param eol A string to match against for the EOL.
@@ -342,6 +443,7 @@ class Serial {
    *
    * \throw serial::PortNotOpenedException
    * \throw serial::SerialException
+   * \throw std::invalid_argument if the eol is empty.
    */
   size_t ReadLine(std::string &buffer, size_t size = 65536,
                   std::string eol = "\n");
@@ -422,6 +524,144 @@ class Serial {
    */
   size_t Write(const std::string &data);
 
+  /** The non throwing versions of Available, WaitReadable, Read and Write.
+   *
+   * They behave like the throwing ones, but return the status of the
+   * operation instead of throwing, without any allocation. This is meant for
+   * the loops that must keep up when a device disconnects or times out
+   * repeatedly, where building and throwing an exception on each call costs
+   * way more than the system calls themselves.
+   *
+   * A partial transfer because of a timeout is status_timeout, with bytes
+   * the number of bytes transferred. A device that reports readiness but
+   * returns no data is status_disconnected, and a failed system call is
+   * status_io_error with the errno in error.
+   */
+  IOResult TryAvailable();
+
+  IOResult TryWaitReadable();
+
+  IOResult TryRead(uint8_t *buffer, size_t size);
+
+  IOResult TryWrite(const uint8_t *data, size_t size);
+
+  /** Set a callback that sees every byte exchanged with the device.
+   *
+   * The received bytes are given once, when they are read from the driver,
+   * whatever the read method used. The sent bytes are given once they have
+   * been written. The callback is called from the thread doing the read or
+   * the write, while it holds the read or the write lock.
+   *
+   * The callback is replaced under both locks, so this can be called while
+   * other threads use the port, it waits for the read and the write in
+   * progress. It must not be called from the callback itself.
+   *
+   * \param callback The callback, or an empty function to remove it.
+   */
+  void SetTrafficCallback(TrafficCallback callback);
+
+  /** Enable or disable the timestamping of the received bytes.
+   *
+   * Each chunk read from the driver is tagged with the CLOCK_MONOTONIC time
+   * at which the poll waiting for it woke up, and the time at which the
+   * first byte returned by a read arrived is given by
+   * GetLastReadTimestamp(). This is what a sensor fusion needs to
+   * compensate for the transmission and the processing delays.
+   *
+   * The driver of a tty does not timestamp the data, so the timestamp is
+   * only that accurate when a reader is waiting on the port. Data that were
+   * already there when the read started are tagged with the time of the read.
+   *
+   * \param enabled True to timestamp the received bytes.
+   */
+  void SetTimestamping(bool enabled);
+
+  bool IsTimestamping() const;
+
+  /** Get the arrival time of the first byte returned by the last Read(),
+   * ReadLine(), ReadLines() or ReadSome().
+   *
+   * This must be called from the thread that did the read.
+   *
+   * \return The CLOCK_MONOTONIC time in nanoseconds, 0 if nothing was read
+   *         or the timestamping is disabled.
+   */
+  int64_t GetLastReadTimestamp() const;
+
+  /** Get the distribution of the time between the arrival of the first byte
+   * returned by a read and the return of the read to the user.
+   *
+   * The reads are only measured while the timestamping is enabled. This is
+   * what shows the effect of the inter byte timeout and of the low latency
+   * settings of the port.
+   */
+  const LatencyHistogram &GetReadLatency() const;
+
+  /** Forget the reads measured by GetReadLatency(). */
+  void ResetReadLatency();
+
+  /** Start a thread writing the buffers given to WriteAsync().
+   *
+   * The buffers are queued without blocking the caller, and the writer thread
+   * sends everything that is queued with a single writev, so many small
+   * commands cost a single system call. The writes that fail or time out are
+   * counted, see GetAsyncErrorCount().
+   *
+   * This must not be called while other threads use WriteAsync().
+   *
+   * \param capacity The maximum number of buffers in the queue.
+   *
+   * \param policy What WriteAsync() does when the queue is full.
+   *
+   * \throw std::invalid_argument if the capacity is 0.
+   */
+  void EnableAsyncWrite(size_t capacity = 256,
+                        QueuePolicy policy = QueuePolicy::BLOCK);
+
+  /** Write the buffers still queued and stop the writer thread.
+   *
+   * This must not be called while other threads use WriteAsync().
+   */
+  void DisableAsyncWrite();
+
+  bool IsAsyncWriteEnabled() const;
+
+  /** Queue a buffer to be written by the writer thread.
+   *
+   * The vector overload takes the buffer without copying it when it is
+   * given as an rvalue.
+   *
+   * \return False if the queue is full and the policy is FAIL or
+   * DROP_NEWEST, the buffer is then dropped.
+   *
+   * \throw std::logic_error if the asynchronous write is not enabled.
+   */
+  bool WriteAsync(const uint8_t *data, size_t size);
+
+  bool WriteAsync(std::vector<uint8_t> data);
+
+  bool WriteAsync(const std::string &data);
+
+  /** Wait for all the queued buffers to be written or dropped.
+   *
+   * \return False if the timeout expired first.
+   *
+   * \throw std::logic_error if the asynchronous write is not enabled.
+   */
+  bool WaitAsyncWrite(uint32_t timeout_ms);
+
+  /** Returns the number of buffers waiting to be written. */
+  size_t GetAsyncQueueDepth() const;
+
+  /** Returns the number of buffers dropped because the queue was full. */
+  uint64_t GetAsyncDropCount() const;
+
+  /** Returns the number of batches that failed or were not entirely sent. */
+  uint64_t GetAsyncErrorCount() const;
+
+  /** Returns the number of writev calls made by the writer thread. */
+  uint64_t GetAsyncWriteCallCount() const;
+
   /** Sets the serial port identifier.
    *
    * \param port A const std::string reference containing the address of the
@@ -590,6 +830,22 @@ class Serial {
    */
   flowcontrol_t GetFlowcontrol() const;
 
+  /** Sets the latency profile of the serial port.
+   *
+   * The ASYNC_LOW_LATENCY flag is only set if the driver supports it, this
+   * is not the case of the pseudo terminals for instance.
+   *
+   * \param latency The latency profile, default is latency_default,
+   * possible values are: latency_default, latency_low
+   */
+  void SetLatency(latency_t latency);
+
+  /** Gets the latency profile of the serial port.
+   *
+   * \see Serial::SetLatency
+   */
+  latency_t GetLatency() const;
+
   /** Flush the input and output buffers */
   void Flush();
 
@@ -650,15 +906,76 @@ class Serial {
   class ScopedReadLock;
   class ScopedWriteLock;
 
-  //============================================================================
-  // P R I V A T E  M E M B E R S
+  // Thread of the asynchronous write mode
+  class AsyncWriter;
 
-  SerialImpl *pimpl_;
+  //============================================================================
+  // P R I V A T E  M E T H O D S
 
   // Read common function
   size_t read_(uint8_t *buffer, size_t size);
+  IOResult try_read_(uint8_t *buffer, size_t size);
   // Write common function
   size_t write_(const uint8_t *data, size_t length);
+  IOResult try_write_(const uint8_t *data, size_t length);
+  // Gather write used by the async writer, takes the write lock. The array
+  // is used in place and is unchanged on return
+  size_t writev_(iovec *iov, int count);
+  // Give the bytes exchanged to the traffic callback, if any
+  void tap_(direction_t direction, const uint8_t *data, size_t size);
+  // Keep the arrival time of the first byte returned by a read
+  void stamp_read_(int64_t timestamp_ns);
+  // Arrival time of the first byte of the receive buffer
+  int64_t rx_buffer_timestamp_();
+  // Line reading common function, the read lock must be held by the caller
+  size_t readline_(std::string &buffer, size_t size, const std::string &eol);
+
+  /** Pull everything the driver currently holds into the receive buffer.
+   *
+   * At least one byte is requested so the call blocks until data arrives or
+   * the read timeout expires. At most max_size bytes are read.
+   *
+   * \return The number of bytes appended to the receive buffer.
+   */
+  size_t fill_rx_buffer_(size_t max_size);
+
+  /** Move up to size buffered bytes to the given buffer.
+   *
+   * \return The number of bytes moved out of the receive buffer.
+   */
+  size_t drain_rx_buffer_(uint8_t *buffer, size_t size);
+
+  /** Discard the content of the receive buffer. */
+  void clear_rx_buffer_();
+
+  /** Search for the EOL in the given range with memchr or memmem.
+   *
+   * \return A pointer to the first byte of the EOL, nullptr if not found.
+   */
+  static const uint8_t *find_eol_(const uint8_t *data, size_t size,
+                                  const std::string &eol);
+
+  //============================================================================
+  // P R I V A T E  M E M B E R S
+
+  SerialImpl *pimpl_;
+
+  // Bytes received from the port but not yet returned to the user.
+  // Line oriented reads pull whole chunks from the driver and keep the
+  // leftover here for the next call. [rx_begin_, rx_end_) is the valid range.
+  std::vector<uint8_t> rx_buffer_;
+  size_t rx_begin_;
+  size_t rx_end_;
+  // Arrival time of the bytes that went through the receive buffer.
+  ChunkTimestamps rx_timestamps_;
+
+  int64_t last_read_timestamp_ns_;
+  LatencyHistogram read_latency_;
+
+  TrafficCallback traffic_callback_;
+
+  // Only set while the asynchronous write mode is enabled.
+  std::unique_ptr<AsyncWriter> async_writer_;
 };
 
 }  // namespace atlas
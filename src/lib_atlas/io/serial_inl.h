@@ -33,15 +33,17 @@
 #error This file may only be included from serial.h
 #endif
 
+#include <lib_atlas/io/details/serial_async_writer.h>
 #include <lib_atlas/io/details/serial_impl.h>
+#include <string.h>
 #include <algorithm>
 
-#if !defined(__OpenBSD__)
-#include <alloca.h>
-#endif
-
 namespace atlas {
 
+// Initial size of the receive buffer used by the line oriented reads.
+// Most devices send sentences that are way shorter than this.
+const size_t kSerialRxBufferSize = 4096;
+
 //==============================================================================
 // I N N E R   C L A S S   S E C T I O N
 
@@ -84,13 +86,25 @@ ATLAS_INLINE Serial::Serial(const std::string &port, uint32_t baudrate,
                             parity_t parity, stopbits_t stopbits,
                             flowcontrol_t flowcontrol)
     : pimpl_(new SerialImpl(port, baudrate, bytesize, parity, stopbits,
-                            flowcontrol)) {
+                            flowcontrol)),
+      rx_buffer_(kSerialRxBufferSize),
+      rx_begin_(0),
+      rx_end_(0),
+      rx_timestamps_(),
+      last_read_timestamp_ns_(0),
+      read_latency_(),
+      traffic_callback_(),
+      async_writer_() {
   pimpl_->SetTimeout(timeout);
 }
 
 //------------------------------------------------------------------------------
 //
-ATLAS_INLINE Serial::~Serial() { delete pimpl_; }
+ATLAS_INLINE Serial::~Serial() {
+  // The writer thread uses the port until it is stopped.
+  async_writer_.reset();
+  delete pimpl_;
+}
 
 //==============================================================================
 // M E T H O D S   S E C T I O N
@@ -101,7 +115,10 @@ ATLAS_INLINE void Serial::Open() { pimpl_->Open(); }
 
 //------------------------------------------------------------------------------
 //
-ATLAS_INLINE void Serial::Close() { pimpl_->Close(); }
+ATLAS_INLINE void Serial::Close() {
+  clear_rx_buffer_();
+  pimpl_->Close();
+}
 
 //------------------------------------------------------------------------------
 //
@@ -109,11 +126,24 @@ ATLAS_INLINE bool Serial::IsOpen() const { return pimpl_->IsOpen(); }
 
 //------------------------------------------------------------------------------
 //
-ATLAS_INLINE size_t Serial::Available() { return pimpl_->Available(); }
+ATLAS_INLINE int Serial::GetFileDescriptor() const {
+  return pimpl_->GetFileDescriptor();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::Available() {
+  ScopedReadLock lock(pimpl_);
+  return (rx_end_ - rx_begin_) + pimpl_->Available();
+}
 
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE bool Serial::WaitReadable() {
+  ScopedReadLock lock(pimpl_);
+  if (rx_end_ != rx_begin_) {
+    return true;
+  }
   Timeout timeout(pimpl_->GetTimeout());
   return pimpl_->WaitReadable(timeout.read_timeout_constant);
 }
@@ -127,24 +157,144 @@ ATLAS_INLINE void Serial::WaitByteTimes(size_t count) {
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::read_(uint8_t *buffer, size_t size) {
-  return pimpl_->Read(buffer, size);
+  return SerialImpl::ThrowOnError(try_read_(buffer, size), "read");
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::try_read_(uint8_t *buffer, size_t size) {
+  // Serve what the line reads left behind before going to the driver.
+  int64_t timestamp_ns = rx_buffer_timestamp_();
+  size_t bytes_read = drain_rx_buffer_(buffer, size);
+  IOResult result = {status_ok, 0, 0};
+  if (bytes_read < size) {
+    result = pimpl_->TryRead(buffer + bytes_read, size - bytes_read);
+    tap_(direction_rx, buffer + bytes_read, result.bytes);
+    if (bytes_read == 0 && result.bytes != 0) {
+      timestamp_ns = pimpl_->GetReadTimestamp();
+    }
+  }
+  result.bytes += bytes_read;
+  stamp_read_(result.bytes != 0 ? timestamp_ns : 0);
+  return result;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::fill_rx_buffer_(size_t max_size) {
+  // Make room at the end of the buffer. Move the leftover to the front
+  // first, and only grow if a single line does not fit.
+  if (rx_begin_ != 0) {
+    memmove(rx_buffer_.data(), rx_buffer_.data() + rx_begin_,
+            rx_end_ - rx_begin_);
+    rx_end_ -= rx_begin_;
+    rx_begin_ = 0;
+  }
+  if (rx_end_ == rx_buffer_.size()) {
+    rx_buffer_.resize(rx_buffer_.size() * 2);
+  }
+  size_t space = rx_buffer_.size() - rx_end_;
+
+  // Grab everything the driver holds in one call. If nothing is there yet,
+  // ask for one byte so the read blocks until data arrives or times out.
+  size_t count = std::min(pimpl_->Available(), std::min(space, max_size));
+  count = std::max<size_t>(count, 1);
+  size_t bytes_read = pimpl_->Read(rx_buffer_.data() + rx_end_, count);
+  tap_(direction_rx, rx_buffer_.data() + rx_end_, bytes_read);
+  rx_timestamps_.Push(bytes_read, pimpl_->GetReadTimestamp());
+  rx_end_ += bytes_read;
+  return bytes_read;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::drain_rx_buffer_(uint8_t *buffer, size_t size) {
+  size_t count = std::min(size, rx_end_ - rx_begin_);
+  if (count != 0) {
+    memcpy(buffer, rx_buffer_.data() + rx_begin_, count);
+    rx_begin_ += count;
+    if (rx_begin_ == rx_end_) {
+      rx_begin_ = rx_end_ = 0;
+    }
+  }
+  return count;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const uint8_t *Serial::find_eol_(const uint8_t *data, size_t size,
+                                             const std::string &eol) {
+  if (eol.length() == 1) {
+    return static_cast<const uint8_t *>(memchr(data, eol[0], size));
+  }
+  return static_cast<const uint8_t *>(
+      memmem(data, size, eol.data(), eol.length()));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::clear_rx_buffer_() {
+  rx_begin_ = rx_end_ = 0;
+  rx_timestamps_.Clear();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t Serial::rx_buffer_timestamp_() {
+  if (rx_begin_ == rx_end_) {
+    return 0;
+  }
+  // The buffered bytes are the last ones that went through the buffer.
+  return rx_timestamps_.Find(rx_timestamps_.GetEndPosition() -
+                             (rx_end_ - rx_begin_));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::stamp_read_(int64_t timestamp_ns) {
+  last_read_timestamp_ns_ = timestamp_ns;
+  if (timestamp_ns != 0) {
+    read_latency_.Record(Deadline::Now() - timestamp_ns);
+  }
 }
 
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::Read(uint8_t *buffer, size_t size) {
   ScopedReadLock lock(pimpl_);
-  return pimpl_->Read(buffer, size);
+  return read_(buffer, size);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::ReadSome(uint8_t *buffer, size_t size,
+                                     uint32_t timeout_ms) {
+  ScopedReadLock lock(pimpl_);
+  if (rx_end_ != rx_begin_) {
+    stamp_read_(rx_buffer_timestamp_());
+    return drain_rx_buffer_(buffer, size);
+  }
+  size_t bytes_read = pimpl_->ReadSome(buffer, size, timeout_ms);
+  tap_(direction_rx, buffer, bytes_read);
+  stamp_read_(pimpl_->GetReadTimestamp());
+  return bytes_read;
 }
 
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::Read(std::vector<uint8_t> &buffer, size_t size) {
   ScopedReadLock lock(pimpl_);
-  uint8_t *buffer_ = new uint8_t[size];
-  size_t bytes_read = pimpl_->Read(buffer_, size);
-  buffer.insert(buffer.end(), buffer_, buffer_ + bytes_read);
-  delete[] buffer_;
+  // Grow the vector and read in its tail, then shrink it to what was read.
+  size_t offset = buffer.size();
+  buffer.resize(offset + size);
+  size_t bytes_read = 0;
+  try {
+    bytes_read = read_(buffer.data() + offset, size);
+  } catch (...) {
+    buffer.resize(offset);
+    throw;
+  }
+  buffer.resize(offset + bytes_read);
   return bytes_read;
 }
 
@@ -152,10 +302,16 @@ ATLAS_INLINE size_t Serial::Read(std::vector<uint8_t> &buffer, size_t size) {
 //
 ATLAS_INLINE size_t Serial::Read(std::string &buffer, size_t size) {
   ScopedReadLock lock(pimpl_);
-  uint8_t *buffer_ = new uint8_t[size];
-  size_t bytes_read = pimpl_->Read(buffer_, size);
-  buffer.append(reinterpret_cast<const char *>(buffer_), bytes_read);
-  delete[] buffer_;
+  size_t offset = buffer.size();
+  buffer.resize(offset + size);
+  size_t bytes_read = 0;
+  try {
+    bytes_read = read_(reinterpret_cast<uint8_t *>(&buffer[offset]), size);
+  } catch (...) {
+    buffer.resize(offset);
+    throw;
+  }
+  buffer.resize(offset + bytes_read);
   return bytes_read;
 }
 
@@ -172,26 +328,48 @@ ATLAS_INLINE std::string Serial::Read(size_t size) {
 ATLAS_INLINE size_t Serial::ReadLine(std::string &buffer, size_t size,
                                      std::string eol) {
   ScopedReadLock lock(pimpl_);
+  return readline_(buffer, size, eol);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::readline_(std::string &buffer, size_t size,
+                                      const std::string &eol) {
+  if (eol.empty()) {
+    throw std::invalid_argument("Empty end of line delimiter is invalid.");
+  }
   size_t eol_len = eol.length();
-  uint8_t *buffer_ = static_cast<uint8_t *>(alloca(size * sizeof(uint8_t)));
-  size_t read_so_far = 0;
+  // Number of buffered bytes that have already been searched for the EOL.
+  size_t scanned = 0;
+  size_t line_len = 0;
   while (true) {
-    size_t bytes_read = read_(buffer_ + read_so_far, 1);
-    read_so_far += bytes_read;
-    if (bytes_read == 0) {
-      break;  // Timeout occured on reading 1 byte
-    }
-    if (std::string(
-            reinterpret_cast<const char *>(buffer_ + read_so_far - eol_len),
-            eol_len) == eol) {
+    const uint8_t *begin = rx_buffer_.data() + rx_begin_;
+    size_t limit = std::min(rx_end_ - rx_begin_, size);
+    // The EOL may straddle the previously scanned region and the new data.
+    size_t from = scanned >= eol_len ? scanned - (eol_len - 1) : 0;
+    const uint8_t *found = find_eol_(begin + from, limit - from, eol);
+    if (found != nullptr) {
+      line_len = static_cast<size_t>(found - begin) + eol_len;
       break;  // EOL found
     }
-    if (read_so_far == size) {
+    if (limit == size) {
+      line_len = size;
       break;  // Reached the maximum read length
     }
+    scanned = limit;
+    if (fill_rx_buffer_(size - limit) == 0) {
+      line_len = limit;
+      break;  // Timeout occured while waiting for more data
+    }
+  }
+  stamp_read_(rx_buffer_timestamp_());
+  buffer.append(reinterpret_cast<const char *>(rx_buffer_.data() + rx_begin_),
+                line_len);
+  rx_begin_ += line_len;
+  if (rx_begin_ == rx_end_) {
+    rx_begin_ = rx_end_ = 0;
   }
-  buffer.append(reinterpret_cast<const char *>(buffer_), read_so_far);
-  return read_so_far;
+  return line_len;
 }
 
 //------------------------------------------------------------------------------
@@ -209,36 +387,19 @@ ATLAS_INLINE std::vector<std::string> Serial::ReadLines(size_t size,
   ScopedReadLock lock(pimpl_);
   std::vector<std::string> lines;
   size_t eol_len = eol.length();
-  uint8_t *buffer_ = static_cast<uint8_t *>(alloca(size * sizeof(uint8_t)));
   size_t read_so_far = 0;
-  size_t start_of_line = 0;
   while (read_so_far < size) {
-    size_t bytes_read = read_(buffer_ + read_so_far, 1);
-    read_so_far += bytes_read;
+    std::string line;
+    size_t bytes_read = readline_(line, size - read_so_far, eol);
     if (bytes_read == 0) {
-      if (start_of_line != read_so_far) {
-        lines.push_back(
-            std::string(reinterpret_cast<const char *>(buffer_ + start_of_line),
-                        read_so_far - start_of_line));
-      }
-      break;  // Timeout occured on reading 1 byte
+      break;  // Timeout occured before anything was received
     }
-    if (std::string(
-            reinterpret_cast<const char *>(buffer_ + read_so_far - eol_len),
-            eol_len) == eol) {
-      // EOL found
-      lines.push_back(
-          std::string(reinterpret_cast<const char *>(buffer_ + start_of_line),
-                      read_so_far - start_of_line));
-      start_of_line = read_so_far;
-    }
-    if (read_so_far == size) {
-      if (start_of_line != read_so_far) {
-        lines.push_back(
-            std::string(reinterpret_cast<const char *>(buffer_ + start_of_line),
-                        read_so_far - start_of_line));
-      }
-      break;  // Reached the maximum read length
+    read_so_far += bytes_read;
+    lines.push_back(std::move(line));
+    const std::string &last = lines.back();
+    if (last.length() < eol_len ||
+        last.compare(last.length() - eol_len, eol_len, eol) != 0) {
+      break;  // Timeout occured or reached the maximum read length
     }
   }
   return lines;
@@ -268,7 +429,185 @@ ATLAS_INLINE size_t Serial::Write(const uint8_t *data, size_t size) {
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE size_t Serial::write_(const uint8_t *data, size_t length) {
-  return pimpl_->Write(data, length);
+  return SerialImpl::ThrowOnError(try_write_(data, length), "write");
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::try_write_(const uint8_t *data, size_t length) {
+  IOResult result = pimpl_->TryWrite(data, length);
+  tap_(direction_tx, data, result.bytes);
+  return result;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::TryAvailable() {
+  ScopedReadLock lock(pimpl_);
+  IOResult result = pimpl_->TryAvailable();
+  result.bytes += rx_end_ - rx_begin_;
+  return result;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::TryWaitReadable() {
+  ScopedReadLock lock(pimpl_);
+  if (rx_end_ != rx_begin_) {
+    return IOResult{status_ok, 0, 0};
+  }
+  return pimpl_->TryWaitReadable(pimpl_->GetTimeout().read_timeout_constant);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::TryRead(uint8_t *buffer, size_t size) {
+  ScopedReadLock lock(pimpl_);
+  return try_read_(buffer, size);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE IOResult Serial::TryWrite(const uint8_t *data, size_t size) {
+  ScopedWriteLock lock(pimpl_);
+  return try_write_(data, size);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::writev_(iovec *iov, int count) {
+  ScopedWriteLock lock(pimpl_);
+  size_t bytes_written = pimpl_->WriteV(iov, count);
+  size_t remaining = bytes_written;
+  for (int i = 0; i < count && remaining != 0; ++i) {
+    size_t size = std::min(remaining, iov[i].iov_len);
+    tap_(direction_tx, static_cast<const uint8_t *>(iov[i].iov_base), size);
+    remaining -= size;
+  }
+  return bytes_written;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::tap_(direction_t direction, const uint8_t *data,
+                               size_t size) {
+  if (traffic_callback_ && size != 0) {
+    traffic_callback_(direction, data, size);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SetTrafficCallback(TrafficCallback callback) {
+  ScopedReadLock rlock(pimpl_);
+  ScopedWriteLock wlock(pimpl_);
+  traffic_callback_ = std::move(callback);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SetTimestamping(bool enabled) {
+  ScopedReadLock lock(pimpl_);
+  pimpl_->SetTimestamping(enabled);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::IsTimestamping() const {
+  return pimpl_->IsTimestamping();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t Serial::GetLastReadTimestamp() const {
+  return last_read_timestamp_ns_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const LatencyHistogram &Serial::GetReadLatency() const {
+  return read_latency_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::ResetReadLatency() { read_latency_.Reset(); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::EnableAsyncWrite(size_t capacity,
+                                          QueuePolicy policy) {
+  async_writer_.reset();
+  async_writer_.reset(new AsyncWriter(*this, capacity, policy));
+  async_writer_->Start();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::DisableAsyncWrite() { async_writer_.reset(); }
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::IsAsyncWriteEnabled() const {
+  return async_writer_ != nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::WriteAsync(const uint8_t *data, size_t size) {
+  if (async_writer_ == nullptr) {
+    throw std::logic_error("The asynchronous write is not enabled.");
+  }
+  return async_writer_->Push(data, size);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::WriteAsync(std::vector<uint8_t> data) {
+  if (async_writer_ == nullptr) {
+    throw std::logic_error("The asynchronous write is not enabled.");
+  }
+  return async_writer_->Push(std::move(data));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::WriteAsync(const std::string &data) {
+  return WriteAsync(reinterpret_cast<const uint8_t *>(data.data()),
+                    data.size());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool Serial::WaitAsyncWrite(uint32_t timeout_ms) {
+  if (async_writer_ == nullptr) {
+    throw std::logic_error("The asynchronous write is not enabled.");
+  }
+  return async_writer_->WaitIdle(timeout_ms);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t Serial::GetAsyncQueueDepth() const {
+  return async_writer_ == nullptr ? 0 : async_writer_->QueueDepth();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t Serial::GetAsyncDropCount() const {
+  return async_writer_ == nullptr ? 0 : async_writer_->DropCount();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t Serial::GetAsyncErrorCount() const {
+  return async_writer_ == nullptr ? 0 : async_writer_->ErrorCount();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t Serial::GetAsyncWriteCallCount() const {
+  return async_writer_ == nullptr ? 0 : async_writer_->WriteCallCount();
 }
 
 //------------------------------------------------------------------------------
@@ -358,6 +697,18 @@ ATLAS_INLINE flowcontrol_t Serial::GetFlowcontrol() const {
   return pimpl_->GetFlowcontrol();
 }
 
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void Serial::SetLatency(latency_t latency) {
+  pimpl_->SetLatency(latency);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE latency_t Serial::GetLatency() const {
+  return pimpl_->GetLatency();
+}
+
 //------------------------------------------------------------------------------
 //
 ATLAS_INLINE void Serial::Flush() {
@@ -370,6 +721,7 @@ ATLAS_INLINE void Serial::Flush() {
 //
 ATLAS_INLINE void Serial::FlushInput() {
   ScopedReadLock lock(pimpl_);
+  clear_rx_buffer_();
   pimpl_->FlushInput();
 }
 
@@ -0,0 +1,159 @@
+/**
+ * \file	serial_log.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_LOG_H_
+#define LIB_ATLAS_IO_SERIAL_LOG_H_
+
+#include <lib_atlas/exceptions.h>
+#include <lib_atlas/io/serial.h>
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+
+namespace atlas {
+
+/**
+ * The layout of a serial traffic log, as written by SerialRecorder.
+ *
+ * The file starts with a SerialLogHeader and is followed by the records.
+ * Each record is a SerialLogRecordHeader immediately followed by the bytes,
+ * padded with zeros to the next multiple of 8 bytes. Everything is thus
+ * aligned on 8 bytes and the log can be used in place once mapped in
+ * memory. The integers are stored with the byte order of the host.
+ */
+struct SerialLogHeader {
+  /** kSerialLogMagic, without the terminating zero. */
+  char magic[8];
+
+  uint32_t version;
+
+  /** The size of this header, the first record starts right after it. */
+  uint32_t header_size;
+
+  /** CLOCK_REALTIME at the start of the recording, in nanoseconds. */
+  int64_t start_realtime_ns;
+
+  /** CLOCK_MONOTONIC at the start of the recording, in nanoseconds. */
+  int64_t start_monotonic_ns;
+};
+
+struct SerialLogRecordHeader {
+  /** CLOCK_MONOTONIC when the bytes went through the port. */
+  int64_t timestamp_ns;
+
+  uint32_t size;
+
+  /** A direction_t. */
+  uint8_t direction;
+
+  uint8_t reserved[3];
+};
+
+static_assert(sizeof(SerialLogHeader) == 32,
+              "The header of the log must not be padded.");
+static_assert(sizeof(SerialLogRecordHeader) == 16,
+              "The header of the records must not be padded.");
+
+const char kSerialLogMagic[] = "ATLSLOG";
+
+const uint32_t kSerialLogVersion = 1;
+
+/**
+ * A record of a serial traffic log, pointing in the memory of the log.
+ */
+struct SerialLogRecord {
+  int64_t timestamp_ns;
+  direction_t direction;
+  const uint8_t *data;
+  size_t size;
+};
+
+/**
+ * Read a serial traffic log by mapping it in memory, the records are given
+ * without any copy.
+ *
+ * A record cut by the end of the file, as left when the recording process
+ * crashed, is considered as the end of the log.
+ */
+class SerialLogReader {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<SerialLogReader>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \throw IOException if the file cannot be opened or mapped.
+   * \throw CorruptedDataException if the file is not a serial traffic log.
+   */
+  explicit SerialLogReader(const std::string &path);
+
+  ~SerialLogReader() ATLAS_NOEXCEPT;
+
+  SerialLogReader(const SerialLogReader &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  SerialLogReader &operator=(const SerialLogReader &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  const SerialLogHeader &GetHeader() const ATLAS_NOEXCEPT;
+
+  /**
+   * \param record The next record, valid as long as the reader exists.
+   *
+   * \return False at the end of the log.
+   */
+  bool Next(SerialLogRecord &record) ATLAS_NOEXCEPT;
+
+  /**
+   * Go back to the first record.
+   */
+  void Rewind() ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  const uint8_t *data_;
+
+  size_t size_;
+
+  /** The offset of the next record. */
+  size_t offset_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/serial_log_inl.h>
+
+#endif  // LIB_ATLAS_IO_SERIAL_LOG_H_
@@ -0,0 +1,125 @@
+/**
+ * \file	serial_log_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_LOG_H_
+#error This file may only be included from serial_log.h
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialLogReader::SerialLogReader(const std::string &path)
+    : data_(nullptr), size_(0), offset_(0) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    ATLAS_THROW(IOException, "open " << path << ": " << strerror(errno));
+  }
+  struct stat status;
+  if (fstat(fd, &status) == -1) {
+    int error = errno;
+    ::close(fd);
+    ATLAS_THROW(IOException, "fstat " << path << ": " << strerror(error));
+  }
+  size_ = static_cast<size_t>(status.st_size);
+  if (size_ < sizeof(SerialLogHeader)) {
+    ::close(fd);
+    throw CorruptedDataException("SerialLogReader: header");
+  }
+  void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps the file alive.
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    ATLAS_THROW(IOException, "mmap " << path << ": " << strerror(errno));
+  }
+  data_ = static_cast<const uint8_t *>(data);
+  // The records are read in sequence, let the kernel read ahead.
+  madvise(data, size_, MADV_SEQUENTIAL);
+
+  const SerialLogHeader &header = GetHeader();
+  if (memcmp(header.magic, kSerialLogMagic, sizeof(header.magic)) != 0 ||
+      header.version != kSerialLogVersion ||
+      header.header_size < sizeof(SerialLogHeader) ||
+      header.header_size > size_) {
+    munmap(data, size_);
+    throw CorruptedDataException("SerialLogReader: header");
+  }
+  offset_ = header.header_size;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialLogReader::~SerialLogReader() ATLAS_NOEXCEPT {
+  munmap(const_cast<uint8_t *>(data_), size_);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const SerialLogHeader &SerialLogReader::GetHeader() const
+    ATLAS_NOEXCEPT {
+  return *reinterpret_cast<const SerialLogHeader *>(data_);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SerialLogReader::Next(SerialLogRecord &record)
+    ATLAS_NOEXCEPT {
+  if (size_ - offset_ < sizeof(SerialLogRecordHeader)) {
+    return false;
+  }
+  const SerialLogRecordHeader &header =
+      *reinterpret_cast<const SerialLogRecordHeader *>(data_ + offset_);
+  size_t padded_size = (static_cast<size_t>(header.size) + 7) & ~size_t(7);
+  if (size_ - offset_ - sizeof(SerialLogRecordHeader) < padded_size) {
+    return false;
+  }
+  record.timestamp_ns = header.timestamp_ns;
+  record.direction = static_cast<direction_t>(header.direction);
+  record.data = data_ + offset_ + sizeof(SerialLogRecordHeader);
+  record.size = header.size;
+  offset_ += sizeof(SerialLogRecordHeader) + padded_size;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialLogReader::Rewind() ATLAS_NOEXCEPT {
+  offset_ = GetHeader().header_size;
+}
+
+}  // namespace atlas
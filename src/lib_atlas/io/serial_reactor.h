@@ -0,0 +1,247 @@
+/**
+ * \file	serial_reactor.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_REACTOR_H_
+#define LIB_ATLAS_IO_SERIAL_REACTOR_H_
+
+#include <lib_atlas/io/serial.h>
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/runnable.h>
+#include <lib_atlas/pattern/subject.h>
+#include <lib_atlas/sys/latency_histogram.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Multiplex several serial ports on a single thread with epoll.
+ *
+ * Instead of having a thread blocking on each device, the ports are
+ * registered to the reactor which waits for all of them at once and
+ * dispatches the events:
+ *  * When data is received on a port, it is read in one call and given to the
+ *    read callback of the port, then notified to the observers of the port.
+ *  * When the write interest of a port is enabled and the port can be
+ *    written, the writable callback of the port is called.
+ *  * When the device hangs up, the port is removed from the reactor and the
+ *    error callback is called.
+ *
+ * The reactor can either be driven by its own thread (see Runnable::Start())
+ * or by calling Poll() from an existing loop. All the callbacks are called
+ * from the thread that runs Poll(), one event at a time. In order to spread
+ * the ports on a small pool of threads, use one reactor per group of ports.
+ *
+ * Sample usage:
+ *
+ *   atlas::SerialReactor reactor;
+ *   reactor.AddPort(dvl_port, [](const uint8_t *data, size_t size) {
+ *     parser.Feed(data, size);
+ *   });
+ *   imu_observer.Observe(reactor.AddPort(imu_port));
+ *   reactor.Start();
+ */
+class SerialReactor : public Runnable {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<SerialReactor>;
+
+  using ReadCallback = std::function<void(const uint8_t *, size_t)>;
+
+  using WriteCallback = std::function<void()>;
+
+  using ErrorCallback = std::function<void()>;
+
+  using PortSubject = Subject<const uint8_t *, size_t>;
+
+  /** Maximum time Run() blocks before checking if it must stop. */
+  static const int kStopCheckPeriodMs = 100;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param read_buffer_size The maximum number of bytes read from a port
+   *        for a single event.
+   *
+   * \throw IOException if the epoll instance cannot be created.
+   */
+  explicit SerialReactor(size_t read_buffer_size = 4096);
+
+  virtual ~SerialReactor() ATLAS_NOEXCEPT;
+
+  SerialReactor(const SerialReactor &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  SerialReactor &operator=(const SerialReactor &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Register an opened port to the reactor.
+   *
+   * The port must outlive its registration to the reactor.
+   *
+   * \param port The port to watch, it must be opened.
+   * \param on_read Called with the received data, may be empty. If the
+   *        timestamping of the port is enabled, port.GetLastReadTimestamp()
+   *        gives the arrival time of the data.
+   * \param on_writable Called when the port can be written and the write
+   *        interest has been enabled with SetWriteInterest().
+   * \param on_error Called once if the device hangs up or reports an error.
+   *        The port has already been removed from the reactor at this point.
+   *
+   * \return The subject notifying the data received on this port.
+   *
+   * \throw PortNotOpenedException if the port is not open.
+   * \throw std::invalid_argument if the port is already registered.
+   * \throw IOException if epoll refuses the file descriptor.
+   */
+  PortSubject &AddPort(Serial &port, ReadCallback on_read = ReadCallback(),
+                       WriteCallback on_writable = WriteCallback(),
+                       ErrorCallback on_error = ErrorCallback());
+
+  /**
+   * Unregister a port from the reactor.
+   *
+   * \throw std::invalid_argument if the port is not registered.
+   */
+  void RemovePort(Serial &port);
+
+  /**
+   * Enable or disable the writable notifications of a port.
+   *
+   * Writable notifications should only be enabled while there is something
+   * to send, otherwise the reactor wakes up continuously.
+   *
+   * \throw std::invalid_argument if the port is not registered.
+   */
+  void SetWriteInterest(Serial &port, bool enabled);
+
+  /**
+   * \return The number of ports currently registered.
+   */
+  size_t PortCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * Wait for events on the registered ports and dispatch them.
+   *
+   * \param timeout_ms The maximum time to wait for an event, -1 to wait
+   *        indefinitely.
+   *
+   * \return The number of events that have been dispatched.
+   *
+   * \throw IOException if epoll reports an error.
+   */
+  size_t Poll(int timeout_ms);
+
+  /**
+   * Get the distribution of the time between the wake up of the reactor
+   * and the call of the read callbacks and observers.
+   *
+   * This includes the read of the port and the callbacks of the ports
+   * served before in the same wake up.
+   */
+  const LatencyHistogram &GetDispatchLatency() const ATLAS_NOEXCEPT;
+
+  /** Forget the dispatches measured by GetDispatchLatency(). */
+  void ResetDispatchLatency() ATLAS_NOEXCEPT;
+
+  /**
+   * \return The message of the epoll error that stopped the thread of the
+   *         reactor, empty if there was none. The thread is still to be
+   *         joined with Stop().
+   */
+  std::string GetRunError() const;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  /**
+   * Dispatch the events until the reactor is stopped, or until epoll fails,
+   * see GetRunError().
+   */
+  void Run() override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Port {
+    Serial *serial;
+    int fd;
+    bool write_interest;
+    ReadCallback on_read;
+    WriteCallback on_writable;
+    ErrorCallback on_error;
+    PortSubject subject;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  std::shared_ptr<Port> FindPort(int fd) const;
+
+  void UpdateInterest(const Port &port);
+
+  void HandleReadable(Port &port, int64_t wakeup_ns);
+
+  void HandleError(int fd);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  int epoll_fd_;
+
+  /** The ports indexed by their file descriptor. */
+  std::map<int, std::shared_ptr<Port>> ports_;
+
+  mutable std::mutex ports_mutex_;
+
+  /** The buffer the data are read in, only used by the polling thread. */
+  std::vector<uint8_t> read_buffer_;
+
+  LatencyHistogram dispatch_latency_;
+
+  std::string run_error_;
+
+  mutable std::mutex run_error_mutex_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/serial_reactor_inl.h>
+
+#endif  // LIB_ATLAS_IO_SERIAL_REACTOR_H_
@@ -0,0 +1,273 @@
+/**
+ * \file	serial_reactor_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_REACTOR_H_
+#error This file may only be included from serial_reactor.h
+#endif
+
+#include <errno.h>
+#include <lib_atlas/io/details/deadline.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <algorithm>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialReactor::SerialReactor(size_t read_buffer_size)
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      ports_(),
+      ports_mutex_(),
+      read_buffer_(read_buffer_size),
+      dispatch_latency_(),
+      run_error_(),
+      run_error_mutex_() {
+  if (epoll_fd_ == -1) {
+    ATLAS_THROW(IOException, errno);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialReactor::~SerialReactor() ATLAS_NOEXCEPT {
+  // The thread must be joined before the members it uses are destroyed.
+  if (IsRunning()) {
+    Stop();
+  }
+  ::close(epoll_fd_);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialReactor::PortSubject &SerialReactor::AddPort(
+    Serial &port, ReadCallback on_read, WriteCallback on_writable,
+    ErrorCallback on_error) {
+  if (!port.IsOpen()) {
+    throw PortNotOpenedException("SerialReactor::AddPort");
+  }
+  std::shared_ptr<Port> entry = std::make_shared<Port>();
+  entry->serial = &port;
+  entry->fd = port.GetFileDescriptor();
+  entry->write_interest = false;
+  entry->on_read = std::move(on_read);
+  entry->on_writable = std::move(on_writable);
+  entry->on_error = std::move(on_error);
+
+  std::lock_guard<std::mutex> lock(ports_mutex_);
+  if (ports_.find(entry->fd) != ports_.end()) {
+    throw std::invalid_argument("The port is already in the reactor.");
+  }
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = entry->fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, entry->fd, &event) == -1) {
+    ATLAS_THROW(IOException, errno);
+  }
+  ports_[entry->fd] = entry;
+  return entry->subject;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::RemovePort(Serial &port) {
+  std::lock_guard<std::mutex> lock(ports_mutex_);
+  auto it = std::find_if(ports_.begin(), ports_.end(),
+                         [&port](const std::pair<const int,
+                                                 std::shared_ptr<Port>> &p) {
+                           return p.second->serial == &port;
+                         });
+  if (it == ports_.end()) {
+    throw std::invalid_argument("The port is not in the reactor.");
+  }
+  // The file descriptor may already be closed, ignore the error.
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->first, nullptr);
+  ports_.erase(it);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::SetWriteInterest(Serial &port, bool enabled) {
+  std::lock_guard<std::mutex> lock(ports_mutex_);
+  auto it = ports_.find(port.GetFileDescriptor());
+  if (it == ports_.end() || it->second->serial != &port) {
+    throw std::invalid_argument("The port is not in the reactor.");
+  }
+  if (it->second->write_interest != enabled) {
+    it->second->write_interest = enabled;
+    UpdateInterest(*it->second);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SerialReactor::PortCount() const ATLAS_NOEXCEPT {
+  std::lock_guard<std::mutex> lock(ports_mutex_);
+  return ports_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const LatencyHistogram &SerialReactor::GetDispatchLatency() const
+    ATLAS_NOEXCEPT {
+  return dispatch_latency_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::ResetDispatchLatency() ATLAS_NOEXCEPT {
+  dispatch_latency_.Reset();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::UpdateInterest(const Port &port) {
+  epoll_event event = {};
+  event.events = EPOLLIN | (port.write_interest ? EPOLLOUT : 0);
+  event.data.fd = port.fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, port.fd, &event) == -1) {
+    ATLAS_THROW(IOException, errno);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::shared_ptr<SerialReactor::Port> SerialReactor::FindPort(
+    int fd) const {
+  std::lock_guard<std::mutex> lock(ports_mutex_);
+  auto it = ports_.find(fd);
+  if (it == ports_.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t SerialReactor::Poll(int timeout_ms) {
+  const int kMaxEvents = 16;
+  epoll_event events[kMaxEvents];
+  int count = epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+  if (count == -1) {
+    if (errno == EINTR) {
+      return 0;
+    }
+    ATLAS_THROW(IOException, errno);
+  }
+  int64_t wakeup_ns = Deadline::Now();
+
+  for (int i = 0; i < count; ++i) {
+    // Hold a reference on the port so a callback may remove it safely.
+    std::shared_ptr<Port> port = FindPort(events[i].data.fd);
+    if (port == nullptr) {
+      continue;  // Removed while we were waiting.
+    }
+    if (events[i].events & EPOLLIN) {
+      try {
+        HandleReadable(*port, wakeup_ns);
+      } catch (const IOException &) {
+        // A disconnected device fails the read, handle it like a hangup.
+        events[i].events |= EPOLLERR;
+      } catch (const SerialException &) {
+        events[i].events |= EPOLLERR;
+      }
+    }
+    if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+      HandleError(port->fd);
+      continue;
+    }
+    if ((events[i].events & EPOLLOUT) && port->on_writable) {
+      port->on_writable();
+    }
+  }
+  return static_cast<size_t>(count);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::HandleReadable(Port &port,
+                                                int64_t wakeup_ns) {
+  // The port is readable, so this does not wait.
+  size_t bytes_read =
+      port.serial->ReadSome(read_buffer_.data(), read_buffer_.size(), 0);
+  if (bytes_read == 0) {
+    return;
+  }
+  dispatch_latency_.Record(Deadline::Now() - wakeup_ns);
+  if (port.on_read) {
+    port.on_read(read_buffer_.data(), bytes_read);
+  }
+  port.subject.Notify(read_buffer_.data(), bytes_read);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::HandleError(int fd) {
+  std::shared_ptr<Port> port;
+  {
+    std::lock_guard<std::mutex> lock(ports_mutex_);
+    auto it = ports_.find(fd);
+    if (it == ports_.end()) {
+      return;
+    }
+    port = it->second;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    ports_.erase(it);
+  }
+  if (port->on_error) {
+    port->on_error();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReactor::Run() {
+  while (!MustStop()) {
+    try {
+      Poll(kStopCheckPeriodMs);
+    } catch (const IOException &e) {
+      // The next epoll_wait would fail the same way, there is nobody to
+      // throw to on this thread.
+      std::lock_guard<std::mutex> lock(run_error_mutex_);
+      run_error_ = e.what();
+      return;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::string SerialReactor::GetRunError() const {
+  std::lock_guard<std::mutex> lock(run_error_mutex_);
+  return run_error_;
+}
+
+}  // namespace atlas
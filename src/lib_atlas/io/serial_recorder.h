@@ -0,0 +1,162 @@
+/**
+ * \file	serial_recorder.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_RECORDER_H_
+#define LIB_ATLAS_IO_SERIAL_RECORDER_H_
+
+#include <lib_atlas/io/serial.h>
+#include <lib_atlas/io/serial_log.h>
+#include <lib_atlas/macros.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Record all the traffic of a serial port in a binary log.
+ *
+ * Every byte read from or written to the attached port is written in the
+ * log with the CLOCK_MONOTONIC time it went through the port. The format is
+ * described in serial_log.h, the log can be read with SerialLogReader and
+ * played back to a parser with SerialReplay.
+ *
+ * The records are gathered in a memory buffer and written to the file when
+ * it is full, so recording costs a memcpy in the read and write paths of the
+ * port most of the time. A failure to write the file is counted and does not
+ * disturb the port.
+ *
+ * Sample usage:
+ *
+ *   atlas::SerialRecorder recorder("/tmp/dvl.slog");
+ *   recorder.Attach(dvl_port);
+ */
+class SerialRecorder {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<SerialRecorder>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Create the log, replacing the file if it exists.
+   *
+   * \param path The path of the log.
+   * \param buffer_size The size of the memory buffer.
+   *
+   * \throw IOException if the log cannot be created.
+   */
+  explicit SerialRecorder(const std::string &path,
+                          size_t buffer_size = 64 * 1024);
+
+  /**
+   * Detach from the port and write what remains in the buffer.
+   */
+  ~SerialRecorder() ATLAS_NOEXCEPT;
+
+  SerialRecorder(const SerialRecorder &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  SerialRecorder &operator=(const SerialRecorder &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Record the traffic of a port, replacing its traffic callback.
+   *
+   * The port must outlive the recorder or be detached first. The port can be
+   * in use by other threads.
+   */
+  void Attach(Serial &serial);
+
+  /**
+   * Stop recording the port attached, if any.
+   */
+  void Detach();
+
+  /**
+   * Add a record to the log, this is thread safe.
+   */
+  void Record(direction_t direction, const uint8_t *data, size_t size,
+              int64_t timestamp_ns);
+
+  /**
+   * Write the records still in the memory buffer to the file.
+   */
+  void Flush();
+
+  uint64_t GetRecordCount() const ATLAS_NOEXCEPT;
+
+  uint64_t GetByteCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of writes of the file that failed, the records they
+   *         contained are lost.
+   */
+  uint64_t GetErrorCount() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /** Write the memory buffer to the file, the mutex must be held. */
+  void WriteBuffer();
+
+  /** Write the whole data to the file, the mutex must be held. */
+  void WriteFile(const uint8_t *data, size_t size);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  int fd_;
+
+  std::vector<uint8_t> buffer_;
+
+  size_t buffer_used_;
+
+  Serial *serial_;
+
+  std::mutex mutex_;
+
+  std::atomic<uint64_t> record_count_;
+
+  std::atomic<uint64_t> byte_count_;
+
+  std::atomic<uint64_t> error_count_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/serial_recorder_inl.h>
+
+#endif  // LIB_ATLAS_IO_SERIAL_RECORDER_H_
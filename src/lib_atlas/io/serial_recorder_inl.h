@@ -0,0 +1,192 @@
+/**
+ * \file	serial_recorder_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_RECORDER_H_
+#error This file may only be included from serial_recorder.h
+#endif
+
+#include <lib_atlas/io/details/deadline.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialRecorder::SerialRecorder(const std::string &path,
+                                            size_t buffer_size)
+    : fd_(-1),
+      buffer_(std::max(buffer_size, sizeof(SerialLogRecordHeader) + 8)),
+      buffer_used_(0),
+      serial_(nullptr),
+      mutex_(),
+      record_count_(0),
+      byte_count_(0),
+      error_count_(0) {
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ == -1) {
+    ATLAS_THROW(IOException, "open " << path << ": " << strerror(errno));
+  }
+
+  SerialLogHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kSerialLogMagic, sizeof(header.magic));
+  header.version = kSerialLogVersion;
+  header.header_size = sizeof(header);
+  timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  header.start_realtime_ns =
+      static_cast<int64_t>(now.tv_sec) * Deadline::kNanosecondsPerSecond +
+      now.tv_nsec;
+  header.start_monotonic_ns = Deadline::Now();
+  if (::write(fd_, &header, sizeof(header)) !=
+      static_cast<ssize_t>(sizeof(header))) {
+    int error = errno;
+    ::close(fd_);
+    ATLAS_THROW(IOException, "write " << path << ": " << strerror(error));
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialRecorder::~SerialRecorder() ATLAS_NOEXCEPT {
+  Detach();
+  Flush();
+  ::close(fd_);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialRecorder::Attach(Serial &serial) {
+  Detach();
+  serial_ = &serial;
+  serial.SetTrafficCallback(
+      [this](direction_t direction, const uint8_t *data, size_t size) {
+        Record(direction, data, size, Deadline::Now());
+      });
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialRecorder::Detach() {
+  if (serial_ != nullptr) {
+    serial_->SetTrafficCallback(Serial::TrafficCallback());
+    serial_ = nullptr;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialRecorder::Record(direction_t direction,
+                                         const uint8_t *data, size_t size,
+                                         int64_t timestamp_ns) {
+  SerialLogRecordHeader header;
+  memset(&header, 0, sizeof(header));
+  header.timestamp_ns = timestamp_ns;
+  header.size = static_cast<uint32_t>(size);
+  header.direction = static_cast<uint8_t>(direction);
+  const size_t padding = ((size + 7) & ~size_t(7)) - size;
+  const size_t record_size = sizeof(header) + size + padding;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (buffer_.size() - buffer_used_ < record_size) {
+    WriteBuffer();
+  }
+  if (record_size > buffer_.size()) {
+    // Too big for the buffer, which is now empty, write it directly.
+    static const uint8_t zeros[8] = {};
+    WriteFile(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
+    WriteFile(data, size);
+    WriteFile(zeros, padding);
+  } else {
+    uint8_t *destination = buffer_.data() + buffer_used_;
+    memcpy(destination, &header, sizeof(header));
+    memcpy(destination + sizeof(header), data, size);
+    memset(destination + sizeof(header) + size, 0, padding);
+    buffer_used_ += record_size;
+  }
+  ++record_count_;
+  byte_count_ += size;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialRecorder::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  WriteBuffer();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t SerialRecorder::GetRecordCount() const ATLAS_NOEXCEPT {
+  return record_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t SerialRecorder::GetByteCount() const ATLAS_NOEXCEPT {
+  return byte_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t SerialRecorder::GetErrorCount() const ATLAS_NOEXCEPT {
+  return error_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialRecorder::WriteBuffer() {
+  WriteFile(buffer_.data(), buffer_used_);
+  buffer_used_ = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialRecorder::WriteFile(const uint8_t *data, size_t size) {
+  while (size != 0) {
+    ssize_t written = ::write(fd_, data, size);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      ++error_count_;
+      return;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+}
+
+}  // namespace atlas
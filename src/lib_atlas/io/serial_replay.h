@@ -0,0 +1,165 @@
+/**
+ * \file	serial_replay.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_REPLAY_H_
+#define LIB_ATLAS_IO_SERIAL_REPLAY_H_
+
+#include <lib_atlas/io/serial_log.h>
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/runnable.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace atlas {
+
+/**
+ * Play the bytes received in a serial traffic log back on a virtual port.
+ *
+ * The replay creates a pseudo terminal and writes the received bytes of the
+ * log on it. The driver under test opens GetPortName() with a regular
+ * atlas::Serial, so it runs exactly the code it runs on the real device.
+ * The bytes sent by the driver are read and discarded.
+ *
+ * The records can be played in real time, in scaled time (e.g. 10 times
+ * faster than the recording), or as fast as the driver reads them, which
+ * is handy to benchmark a parser offline.
+ *
+ * Sample usage:
+ *
+ *   atlas::SerialReplay replay("/tmp/dvl.slog", 10.0);
+ *   atlas::Serial port(replay.GetPortName(), 115200);
+ *   replay.Start();
+ *   while (!replay.IsFinished()) {
+ *     parser.Parse(port.ReadLine());
+ *   }
+ */
+class SerialReplay : public Runnable {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<SerialReplay>;
+
+  /** The speed that replays the log without waiting between the records. */
+  static constexpr double kAsFastAsPossible = 0.0;
+
+  /** The longest the replay blocks without checking if it must stop. */
+  static const int kStopCheckPeriodMs = 100;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param log_path The path of a log written by SerialRecorder.
+   * \param speed The factor applied to the speed of the recording, 1 for
+   *        real time, 2 for twice faster, or kAsFastAsPossible.
+   *
+   * \throw IOException if the log or the pseudo terminal cannot be opened.
+   * \throw CorruptedDataException if the file is not a serial traffic log.
+   */
+  explicit SerialReplay(const std::string &log_path, double speed = 1.0);
+
+  virtual ~SerialReplay() ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * \return The path of the virtual port to give to atlas::Serial.
+   */
+  const std::string &GetPortName() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return True once all the records have been written to the port.
+   */
+  bool IsFinished() const ATLAS_NOEXCEPT;
+
+  /**
+   * Wait for all the records to be written to the port.
+   *
+   * \return False if the timeout expired first.
+   */
+  bool WaitFinished(uint32_t timeout_ms);
+
+  uint64_t GetRecordCount() const ATLAS_NOEXCEPT;
+
+  uint64_t GetByteCount() const ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  void Run() override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /**
+   * Sleep until the given CLOCK_MONOTONIC time.
+   *
+   * \return False if the replay must stop.
+   */
+  bool SleepUntil(int64_t time_ns);
+
+  /**
+   * Write all the bytes on the port, discarding what the driver sends.
+   *
+   * \return False if the replay must stop or the port failed.
+   */
+  bool WriteAll(const uint8_t *data, size_t size);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  SerialLogReader log_;
+
+  double speed_;
+
+  int master_fd_;
+
+  int slave_fd_;
+
+  std::string port_name_;
+
+  std::atomic<bool> finished_;
+
+  std::mutex finished_mutex_;
+
+  std::condition_variable finished_condition_;
+
+  std::atomic<uint64_t> record_count_;
+
+  std::atomic<uint64_t> byte_count_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/serial_replay_inl.h>
+
+#endif  // LIB_ATLAS_IO_SERIAL_REPLAY_H_
@@ -0,0 +1,210 @@
+/**
+ * \file	serial_replay_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_SERIAL_REPLAY_H_
+#error This file may only be included from serial_replay.h
+#endif
+
+#include <lib_atlas/io/details/deadline.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+
+#if defined(__linux__)
+#include <pty.h>
+#else
+#include <util.h>
+#endif
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialReplay::SerialReplay(const std::string &log_path,
+                                        double speed)
+    : log_(log_path),
+      speed_(speed),
+      master_fd_(-1),
+      slave_fd_(-1),
+      port_name_(),
+      finished_(false),
+      finished_mutex_(),
+      finished_condition_(),
+      record_count_(0),
+      byte_count_(0) {
+  // The line discipline must not alter the bytes, even before the driver
+  // opens and configures the port.
+  termios raw;
+  memset(&raw, 0, sizeof(raw));
+  cfmakeraw(&raw);
+  char name[128];
+  if (openpty(&master_fd_, &slave_fd_, name, &raw, nullptr) == -1) {
+    ATLAS_THROW(IOException, "openpty: " << strerror(errno));
+  }
+  port_name_ = name;
+  fcntl(master_fd_, F_SETFL, fcntl(master_fd_, F_GETFL) | O_NONBLOCK);
+  fcntl(master_fd_, F_SETFD, FD_CLOEXEC);
+  fcntl(slave_fd_, F_SETFD, FD_CLOEXEC);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE SerialReplay::~SerialReplay() ATLAS_NOEXCEPT {
+  if (IsRunning()) {
+    Stop();
+  }
+  // The slave side was kept open so the port does not hang up when the
+  // driver closes it.
+  ::close(slave_fd_);
+  ::close(master_fd_);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const std::string &SerialReplay::GetPortName() const
+    ATLAS_NOEXCEPT {
+  return port_name_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SerialReplay::IsFinished() const ATLAS_NOEXCEPT {
+  return finished_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SerialReplay::WaitFinished(uint32_t timeout_ms) {
+  std::unique_lock<std::mutex> lock(finished_mutex_);
+  return finished_condition_.wait_for(
+      lock, std::chrono::milliseconds(timeout_ms),
+      [this] { return finished_.load(); });
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t SerialReplay::GetRecordCount() const ATLAS_NOEXCEPT {
+  return record_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t SerialReplay::GetByteCount() const ATLAS_NOEXCEPT {
+  return byte_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void SerialReplay::Run() {
+  log_.Rewind();
+  const int64_t start_ns = Deadline::Now();
+  int64_t first_timestamp_ns = 0;
+  bool first = true;
+  SerialLogRecord record;
+  while (log_.Next(record)) {
+    if (record.direction != direction_rx) {
+      continue;
+    }
+    if (speed_ > 0) {
+      if (first) {
+        first_timestamp_ns = record.timestamp_ns;
+        first = false;
+      }
+      int64_t offset_ns = static_cast<int64_t>(
+          (record.timestamp_ns - first_timestamp_ns) / speed_);
+      if (!SleepUntil(start_ns + offset_ns)) {
+        return;
+      }
+    }
+    if (!WriteAll(record.data, record.size)) {
+      return;
+    }
+    ++record_count_;
+    byte_count_ += record.size;
+  }
+  std::lock_guard<std::mutex> lock(finished_mutex_);
+  finished_ = true;
+  finished_condition_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SerialReplay::SleepUntil(int64_t time_ns) {
+  const int64_t period_ns =
+      kStopCheckPeriodMs * Deadline::kNanosecondsPerMillisecond;
+  while (!MustStop()) {
+    int64_t now = Deadline::Now();
+    if (now >= time_ns) {
+      return true;
+    }
+    // An absolute wake up time does not drift with the time spent here.
+    timespec wake_up = Deadline::ToTimeSpec(std::min(time_ns, now + period_ns));
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_up, nullptr);
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool SerialReplay::WriteAll(const uint8_t *data, size_t size) {
+  uint8_t discarded[256];
+  while (size != 0) {
+    if (MustStop()) {
+      return false;
+    }
+    ssize_t written = ::write(master_fd_, data, size);
+    if (written > 0) {
+      data += written;
+      size -= static_cast<size_t>(written);
+      continue;
+    }
+    if (written < 0 && errno != EAGAIN && errno != EINTR) {
+      return false;
+    }
+    // The driver does not read fast enough, wait for room. What it sends
+    // must be drained or it could block on its own write.
+    pollfd descriptor = {master_fd_, POLLIN | POLLOUT, 0};
+    poll(&descriptor, 1, kStopCheckPeriodMs);
+    if (descriptor.revents & POLLIN) {
+      while (::read(master_fd_, discarded, sizeof(discarded)) > 0) {
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace atlas
@@ -0,0 +1,90 @@
+/**
+ * \file	video_file_capture.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_VIDEO_FILE_CAPTURE_H_
+#define LIB_ATLAS_IO_VIDEO_FILE_CAPTURE_H_
+
+#include <lib_atlas/io/file_capture.h>
+#include <lib_atlas/macros.h>
+#include <memory>
+#include <opencv2/highgui/highgui.hpp>
+#include <string>
+
+namespace atlas {
+
+/**
+ * Replay a video file with cv::VideoCapture.
+ *
+ * The frames of a video depend on each other, so a single thread decodes
+ * them, ahead of the capture.
+ */
+class VideoFileCapture : public FileCapture {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<VideoFileCapture>;
+
+  /** Used when the container does not tell the framerate. */
+  static constexpr double kDefaultFramerate = 30.0;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param path The video file.
+   * \param mode The playback mode, see SetPlaybackMode().
+   * \param prefetch_depth The number of frames decoded ahead.
+   *
+   * \throw IOException if the file cannot be opened.
+   * \throw std::invalid_argument if the depth is 0.
+   */
+  explicit VideoFileCapture(const std::string &path,
+                            PlaybackMode mode = PlaybackMode::REAL_TIME,
+                            size_t prefetch_depth = kDefaultPrefetchDepth);
+
+  ~VideoFileCapture() ATLAS_NOEXCEPT = default;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  static std::shared_ptr<cv::VideoCapture> Open(const std::string &path);
+
+  static double GetFramerate(cv::VideoCapture &video);
+
+  //============================================================================
+  // P R I V A T E   C / D T O R S
+
+  /** Delegated to once the video is open, to know its framerate. */
+  VideoFileCapture(std::shared_ptr<cv::VideoCapture> video, PlaybackMode mode,
+                   size_t prefetch_depth);
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/io/video_file_capture_inl.h>
+
+#endif  // LIB_ATLAS_IO_VIDEO_FILE_CAPTURE_H_
@@ -0,0 +1,83 @@
+/**
+ * \file	video_file_capture_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_IO_VIDEO_FILE_CAPTURE_H_
+#error This file may only be included from video_file_capture.h
+#endif
+
+#include <lib_atlas/exceptions/io_exception.h>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE VideoFileCapture::VideoFileCapture(const std::string &path,
+                                                PlaybackMode mode,
+                                                size_t prefetch_depth)
+    : VideoFileCapture(Open(path), mode, prefetch_depth) {}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE VideoFileCapture::VideoFileCapture(
+    std::shared_ptr<cv::VideoCapture> video, PlaybackMode mode,
+    size_t prefetch_depth)
+    : FileCapture(GetFramerate(*video), mode) {
+  // A single thread calls the decode function, in the order of the frames.
+  // The frames are read in the pooled images, whose buffers are reused.
+  StartPrefetch(
+      [video](size_t, cv::Mat &image) { return video->read(image); },
+      prefetch_depth, 1);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::shared_ptr<cv::VideoCapture> VideoFileCapture::Open(
+    const std::string &path) {
+  std::shared_ptr<cv::VideoCapture> video =
+      std::make_shared<cv::VideoCapture>(path);
+  if (!video->isOpened()) {
+    ATLAS_THROW(IOException, "Cannot open the video " << path);
+  }
+  return video;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE double VideoFileCapture::GetFramerate(cv::VideoCapture &video) {
+  double framerate = video.get(CV_CAP_PROP_FPS);
+  // Some containers report 0 or garbage.
+  if (!(framerate > 0 && framerate < 1000)) {
+    return kDefaultFramerate;
+  }
+  return framerate;
+}
+
+}  // namespace atlas
@@ -0,0 +1,278 @@
+/**
+ * \file	async_subject.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_ASYNC_SUBJECT_H_
+#define LIB_ATLAS_PATTERN_ASYNC_SUBJECT_H_
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/pattern/subject.h>
+#include <lib_atlas/pattern/thread_pool.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace atlas {
+
+namespace details {
+
+// std::index_sequence is C++14, this is enough to unpack a tuple.
+template <size_t... Indexes_>
+struct IndexSequence {};
+
+template <size_t Count_, size_t... Indexes_>
+struct MakeIndexSequence
+    : MakeIndexSequence<Count_ - 1, Count_ - 1, Indexes_...> {};
+
+template <size_t... Indexes_>
+struct MakeIndexSequence<0, Indexes_...> {
+  using type = IndexSequence<Indexes_...>;
+};
+
+}  // namespace details
+
+/**
+ * A Subject whose Notify() returns right away, the observers are called on
+ * a ThreadPool.
+ *
+ * Each observer has its own strand: its notifications are called one at a
+ * time and in the order of Notify(), while the different observers run in
+ * parallel on the threads of the pool. So a slow consumer does not delay
+ * the driver that notifies, nor the other consumers. An observer may be
+ * given a pool of its own, e.g. a single thread for a heavy consumer.
+ *
+ * The arguments are copied once in a tuple shared by the observers, which
+ * receive them by reference as with Subject, the temporaries are moved
+ * rather than copied. A reference argument is copied as well, as the
+ * referenced object may not outlive Notify().
+ *
+ * Detach() drops the notifications the observer did not receive yet and
+ * waits for the one it is running, so the observer may be destroyed once it
+ * returns. Flush() waits for all the notifications, for a deterministic
+ * shutdown:
+ *
+ *   driver.Stop();
+ *   subject.Flush();
+ *
+ * As with Subject, an observer that throws terminates the program.
+ */
+template <typename... Args_>
+class AsyncSubject : public Subject<Args_...> {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<AsyncSubject<Args_...>>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * Call the observers on a pool of its own.
+   */
+  explicit AsyncSubject(size_t thread_count = 1);
+
+  /**
+   * Call the observers on a pool shared with other subjects.
+   *
+   * \throw std::invalid_argument if the pool is null.
+   */
+  explicit AsyncSubject(ThreadPool::Ptr pool);
+
+  /**
+   * Drop the pending notifications and wait for the running ones.
+   */
+  ~AsyncSubject() ATLAS_NOEXCEPT;
+
+  AsyncSubject(const AsyncSubject<Args_...> &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  AsyncSubject<Args_...> &operator=(const AsyncSubject<Args_...> &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Queue a notification for each observer, this does not wait for them.
+   */
+  void Notify(NotificationParam<Args_>... args) ATLAS_NOEXCEPT override;
+
+  /**
+   * Queue a notification for each observer, the arguments are forwarded to
+   * the shared tuple, so the temporaries are moved in it.
+   *
+   * The overload above is still the one called with scalars, which are as
+   * cheap to copy.
+   */
+  template <typename... Params_>
+  void Notify(Params_ &&... args) ATLAS_NOEXCEPT;
+
+  size_t ObserverCount() const ATLAS_NOEXCEPT override;
+
+  void Attach(Observer<Args_...> &observer) override;
+
+  /**
+   * Attach an observer that is called on the given pool rather than the one
+   * of the subject. Keep a reference on the pool if the observer detaches
+   * itself from its callback, a pool cannot be destroyed by its threads.
+   *
+   * \throw std::invalid_argument if the pool is null.
+   */
+  void Attach(Observer<Args_...> &observer, ThreadPool::Ptr pool);
+
+  /**
+   * \throw std::invalid_argument if the observer is not attached.
+   */
+  void Detach(Observer<Args_...> &observer) override;
+
+  void DetachAll() ATLAS_NOEXCEPT override;
+
+  /**
+   * \return The number of notifications queued or running, for all the
+   *         observers.
+   */
+  size_t InFlightCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of notifications queued or running for an observer,
+   *         0 if it is not attached.
+   */
+  size_t InFlightCount(const Observer<Args_...> &observer) const;
+
+  /**
+   * Wait until no notification is queued or running. The notifying
+   * threads should be stopped first, or this waits for their notifications
+   * too.
+   *
+   * \throw std::logic_error if called from an observer of this subject,
+   *        which would wait for itself.
+   */
+  void Flush();
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  using ArgumentTuple = std::tuple<typename std::decay<Args_>::type...>;
+
+  using Arguments = std::shared_ptr<ArgumentTuple>;
+
+  /** The notifications of an observer, called one after the other. */
+  struct Strand {
+    Strand(AsyncSubject<Args_...> &strand_subject,
+           Observer<Args_...> &strand_observer, ThreadPool::Ptr strand_pool);
+
+    AsyncSubject<Args_...> *subject;
+
+    Observer<Args_...> *observer;
+
+    ThreadPool::Ptr pool;
+
+    std::mutex mutex;
+
+    /** Signaled when a notification is done. */
+    std::condition_variable done;
+
+    std::deque<Arguments> pending;
+
+    /** A task of the pool runs or will run the strand. */
+    bool scheduled;
+
+    /** The observer is being called by executing_thread. */
+    bool executing;
+
+    std::thread::id executing_thread;
+
+    /** Once set, the strand no longer uses the subject. */
+    bool detached;
+  };
+
+  /** The number of notifications a task runs before yielding the pool. */
+  static const size_t kBatchSize = 16;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void DetachNoCallback(Observer<Args_...> &observer) override;
+
+  /** Queue the arguments for each observer. */
+  void Enqueue(Arguments arguments) ATLAS_NOEXCEPT;
+
+  /**
+   * Remove the strand of the observer, drop its pending notifications and
+   * wait for the running one, unless it is the calling thread.
+   *
+   * \throw std::invalid_argument if the observer is not attached.
+   */
+  void Remove(Observer<Args_...> &observer);
+
+  /** Stop a strand that was removed from the list. */
+  void Retire(Strand &strand);
+
+  /** Schedule a task for the strand, its mutex must be held. */
+  static void Schedule(const std::shared_ptr<Strand> &strand);
+
+  /** The task of the pool, it calls the observer of the strand. */
+  static void Run(const std::shared_ptr<Strand> &strand) ATLAS_NOEXCEPT;
+
+  template <size_t... Indexes_>
+  void Invoke(Observer<Args_...> &observer, ArgumentTuple &arguments,
+              details::IndexSequence<Indexes_...>);
+
+  /** Count notifications that are done or dropped. */
+  void Complete(size_t count);
+
+  /** \return The subject whose observer runs on the calling thread. */
+  static const AsyncSubject<Args_...> *&ThreadSubject();
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  ThreadPool::Ptr pool_;
+
+  std::vector<std::shared_ptr<Strand>> strands_;
+
+  mutable std::mutex strands_mutex_;
+
+  std::atomic<size_t> in_flight_;
+
+  std::mutex flush_mutex_;
+
+  std::condition_variable flushed_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/async_subject_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_ASYNC_SUBJECT_H_
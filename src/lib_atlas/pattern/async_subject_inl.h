@@ -0,0 +1,364 @@
+/**
+ * \file	async_subject_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_ASYNC_SUBJECT_H_
+#error This file may only be included from async_subject.h
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE AsyncSubject<Args_...>::AsyncSubject(size_t thread_count)
+    : Subject<Args_...>(),
+      pool_(),
+      strands_(),
+      strands_mutex_(),
+      in_flight_(0),
+      flush_mutex_(),
+      flushed_() {
+  if (thread_count == 0) {
+    throw std::invalid_argument("The pool needs at least one thread.");
+  }
+  pool_ = std::make_shared<ThreadPool>(thread_count);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE AsyncSubject<Args_...>::AsyncSubject(ThreadPool::Ptr pool)
+    : Subject<Args_...>(),
+      pool_(std::move(pool)),
+      strands_(),
+      strands_mutex_(),
+      in_flight_(0),
+      flush_mutex_(),
+      flushed_() {
+  if (!pool_) {
+    throw std::invalid_argument("The pool is null.");
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE AsyncSubject<Args_...>::~AsyncSubject() ATLAS_NOEXCEPT {
+  // The strands no longer hold the pool once detached, so an owned pool is
+  // joined by the destruction of pool_ and never from one of its threads.
+  DetachAll();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE AsyncSubject<Args_...>::Strand::Strand(
+    AsyncSubject<Args_...> &strand_subject, Observer<Args_...> &strand_observer,
+    ThreadPool::Ptr strand_pool)
+    : subject(&strand_subject),
+      observer(&strand_observer),
+      pool(std::move(strand_pool)),
+      mutex(),
+      done(),
+      pending(),
+      scheduled(false),
+      executing(false),
+      executing_thread(),
+      detached(false) {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Notify(
+    NotificationParam<Args_>... args) ATLAS_NOEXCEPT {
+  if (ObserverCount() == 0) {
+    return;
+  }
+  // A single copy of the arguments, whatever the number of observers.
+  Enqueue(std::make_shared<ArgumentTuple>(args...));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+template <typename... Params_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Notify(Params_ &&... args)
+    ATLAS_NOEXCEPT {
+  static_assert(sizeof...(Params_) == sizeof...(Args_),
+                "The notification takes one value per argument.");
+  if (ObserverCount() == 0) {
+    return;
+  }
+  Enqueue(std::make_shared<ArgumentTuple>(std::forward<Params_>(args)...));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Enqueue(Arguments arguments)
+    ATLAS_NOEXCEPT {
+  std::lock_guard<std::mutex> lock(strands_mutex_);
+  for (const std::shared_ptr<Strand> &strand : strands_) {
+    std::lock_guard<std::mutex> strand_lock(strand->mutex);
+    strand->pending.push_back(arguments);
+    ++in_flight_;
+    if (!strand->scheduled) {
+      strand->scheduled = true;
+      Schedule(strand);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE size_t AsyncSubject<Args_...>::ObserverCount() const
+    ATLAS_NOEXCEPT {
+  std::lock_guard<std::mutex> lock(strands_mutex_);
+  return strands_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Attach(
+    Observer<Args_...> &observer) {
+  Attach(observer, pool_);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Attach(
+    Observer<Args_...> &observer, ThreadPool::Ptr pool) {
+  if (!pool) {
+    throw std::invalid_argument("The pool is null.");
+  }
+  std::lock_guard<std::mutex> lock(strands_mutex_);
+  for (const std::shared_ptr<Strand> &strand : strands_) {
+    if (strand->observer == &observer) {
+      throw std::invalid_argument("The element is already in the container.");
+    }
+  }
+  Subject<Args_...>::ConnectObserver(observer, *this);
+  strands_.push_back(
+      std::make_shared<Strand>(*this, observer, std::move(pool)));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Detach(
+    Observer<Args_...> &observer) {
+  Remove(observer);
+  Subject<Args_...>::DisconnectObserver(observer, *this);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::DetachNoCallback(
+    Observer<Args_...> &observer) {
+  Remove(observer);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::DetachAll() ATLAS_NOEXCEPT {
+  std::vector<std::shared_ptr<Strand>> strands;
+  {
+    std::lock_guard<std::mutex> lock(strands_mutex_);
+    strands.swap(strands_);
+  }
+  for (const std::shared_ptr<Strand> &strand : strands) {
+    Retire(*strand);
+    Subject<Args_...>::DisconnectObserver(*strand->observer, *this);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE size_t AsyncSubject<Args_...>::InFlightCount() const
+    ATLAS_NOEXCEPT {
+  return in_flight_.load();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE size_t AsyncSubject<Args_...>::InFlightCount(
+    const Observer<Args_...> &observer) const {
+  std::lock_guard<std::mutex> lock(strands_mutex_);
+  for (const std::shared_ptr<Strand> &strand : strands_) {
+    if (strand->observer == &observer) {
+      std::lock_guard<std::mutex> strand_lock(strand->mutex);
+      return strand->pending.size() + (strand->executing ? 1 : 0);
+    }
+  }
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Flush() {
+  if (ThreadSubject() == this) {
+    throw std::logic_error("Cannot flush a subject from its own observer.");
+  }
+  std::unique_lock<std::mutex> lock(flush_mutex_);
+  flushed_.wait(lock, [this] { return in_flight_.load() == 0; });
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Remove(
+    Observer<Args_...> &observer) {
+  std::shared_ptr<Strand> strand;
+  {
+    std::lock_guard<std::mutex> lock(strands_mutex_);
+    auto it = std::find_if(strands_.begin(), strands_.end(),
+                           [&observer](const std::shared_ptr<Strand> &s) {
+                             return s->observer == &observer;
+                           });
+    if (it == strands_.end()) {
+      throw std::invalid_argument("The element is not in the container.");
+    }
+    strand = *it;
+    strands_.erase(it);
+  }
+  Retire(*strand);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Retire(Strand &strand) {
+  // Released after the lock, the last task of the strand may still need it
+  // to return and the destruction of the pool joins its threads.
+  ThreadPool::Ptr pool;
+  std::unique_lock<std::mutex> lock(strand.mutex);
+  strand.detached = true;
+  const size_t dropped = strand.pending.size();
+  strand.pending.clear();
+  pool = std::move(strand.pool);
+  Complete(dropped);
+  // An observer may detach itself, it cannot wait for its own notification.
+  const std::thread::id this_thread = std::this_thread::get_id();
+  strand.done.wait(lock, [&strand, this_thread] {
+    return !strand.executing || strand.executing_thread == this_thread;
+  });
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Schedule(
+    const std::shared_ptr<Strand> &strand) {
+  std::shared_ptr<Strand> task_strand = strand;
+  strand->pool->Enqueue([task_strand]() { Run(task_strand); });
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Run(
+    const std::shared_ptr<Strand> &strand) ATLAS_NOEXCEPT {
+  std::unique_lock<std::mutex> lock(strand->mutex);
+  for (size_t i = 0;
+       i < kBatchSize && !strand->detached && !strand->pending.empty(); ++i) {
+    Arguments arguments = std::move(strand->pending.front());
+    strand->pending.pop_front();
+    strand->executing = true;
+    strand->executing_thread = std::this_thread::get_id();
+    AsyncSubject<Args_...> *subject = strand->subject;
+    lock.unlock();
+
+    // The subject cannot be destroyed before executing is reset, as the
+    // detach waits for it.
+    const AsyncSubject<Args_...> *&thread_subject = ThreadSubject();
+    const AsyncSubject<Args_...> *previous = thread_subject;
+    thread_subject = subject;
+    subject->Invoke(*strand->observer, *arguments,
+                    typename details::MakeIndexSequence<sizeof...(
+                        Args_)>::type());
+    thread_subject = previous;
+    subject->Complete(1);
+
+    lock.lock();
+    strand->executing = false;
+    strand->done.notify_all();
+  }
+  // Give the other strands of the pool a turn before the next batch.
+  if (!strand->detached && !strand->pending.empty()) {
+    Schedule(strand);
+  } else {
+    strand->scheduled = false;
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+template <size_t... Indexes_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Invoke(
+    Observer<Args_...> &observer, ArgumentTuple &arguments,
+    details::IndexSequence<Indexes_...>) {
+  Subject<Args_...>::NotifyObserver(observer, *this,
+                                    std::get<Indexes_>(arguments)...);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void AsyncSubject<Args_...>::Complete(size_t count) {
+  if (count != 0 && in_flight_.fetch_sub(count) == count) {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    flushed_.notify_all();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE const AsyncSubject<Args_...> *&
+AsyncSubject<Args_...>::ThreadSubject() {
+  static thread_local const AsyncSubject<Args_...> *subject = nullptr;
+  return subject;
+}
+
+}  // namespace atlas
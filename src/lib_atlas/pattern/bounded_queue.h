@@ -0,0 +1,153 @@
+/**
+ * \file	bounded_queue.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_BOUNDED_QUEUE_H_
+#define LIB_ATLAS_PATTERN_BOUNDED_QUEUE_H_
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/queue_policy.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace atlas {
+
+/**
+ * A bounded FIFO queue whose consumers wait for the elements.
+ *
+ * Unlike the LockFreeQueue, this one locks, but Pop() sleeps until an element
+ * is pushed, which is what a worker thread that handles a few elements per
+ * second needs. The QueuePolicy tells what Push() does when the queue is full.
+ *
+ * Close() wakes everybody up: the elements already in the queue can still be
+ * popped, then Pop() returns false, so the consumer can drain the queue and
+ * exit.
+ *
+ * \tparam Tp_ The type of the elements, it must be move constructible.
+ */
+template <class Tp_>
+class BoundedQueue {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<BoundedQueue<Tp_>>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \throw std::invalid_argument if the capacity is 0.
+   */
+  explicit BoundedQueue(size_t capacity,
+                        QueuePolicy policy = QueuePolicy::BLOCK);
+
+  ~BoundedQueue() ATLAS_NOEXCEPT = default;
+
+  BoundedQueue(const BoundedQueue<Tp_> &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  BoundedQueue<Tp_> &operator=(const BoundedQueue<Tp_> &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Move an element at the end of the queue, applying the policy if the
+   * queue is full.
+   *
+   * \return False if the element was refused, because of the policy or
+   *         because the queue is closed.
+   */
+  bool Push(Tp_ element);
+
+  /**
+   * Wait for an element and move it out of the queue.
+   *
+   * \return False if the queue is closed and empty.
+   */
+  bool Pop(Tp_ &element);
+
+  /**
+   * Move the first element of the queue out without waiting.
+   *
+   * \return False if the queue is empty.
+   */
+  bool TryPop(Tp_ &element);
+
+  /**
+   * Refuse the new elements and wake up the threads waiting on the queue.
+   */
+  void Close();
+
+  /**
+   * Accept elements again after Close().
+   */
+  void Reopen();
+
+  bool IsClosed() const;
+
+  size_t Size() const;
+
+  size_t Capacity() const ATLAS_NOEXCEPT;
+
+  QueuePolicy GetPolicy() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of elements discarded or refused by the policy.
+   */
+  uint64_t DropCount() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  const size_t capacity_;
+
+  const QueuePolicy policy_;
+
+  std::deque<Tp_> elements_;
+
+  bool closed_;
+
+  mutable std::mutex mutex_;
+
+  std::condition_variable not_empty_;
+
+  std::condition_variable not_full_;
+
+  std::atomic<uint64_t> drop_count_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/bounded_queue_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_BOUNDED_QUEUE_H_
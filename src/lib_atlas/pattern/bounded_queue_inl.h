@@ -0,0 +1,180 @@
+/**
+ * \file	bounded_queue_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_BOUNDED_QUEUE_H_
+#error This file may only be included from bounded_queue.h
+#endif
+
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE BoundedQueue<Tp_>::BoundedQueue(size_t capacity,
+                                             QueuePolicy policy)
+    : capacity_(capacity),
+      policy_(policy),
+      elements_(),
+      closed_(false),
+      mutex_(),
+      not_empty_(),
+      not_full_(),
+      drop_count_(0) {
+  if (capacity == 0) {
+    throw std::invalid_argument("The capacity of the queue must not be 0.");
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool BoundedQueue<Tp_>::Push(Tp_ element) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (policy_ == QueuePolicy::KEEP_LATEST) {
+      drop_count_ += elements_.size();
+      elements_.clear();
+    }
+    if (policy_ == QueuePolicy::BLOCK) {
+      not_full_.wait(lock, [this] {
+        return closed_ || elements_.size() < capacity_;
+      });
+    }
+    if (closed_) {
+      return false;
+    }
+    if (elements_.size() >= capacity_) {
+      ++drop_count_;
+      if (policy_ != QueuePolicy::DROP_OLDEST) {
+        return false;
+      }
+      elements_.pop_front();
+    }
+    elements_.push_back(std::move(element));
+  }
+  not_empty_.notify_one();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool BoundedQueue<Tp_>::Pop(Tp_ &element) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !elements_.empty(); });
+    if (elements_.empty()) {
+      return false;
+    }
+    element = std::move(elements_.front());
+    elements_.pop_front();
+  }
+  not_full_.notify_one();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool BoundedQueue<Tp_>::TryPop(Tp_ &element) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (elements_.empty()) {
+      return false;
+    }
+    element = std::move(elements_.front());
+    elements_.pop_front();
+  }
+  not_full_.notify_one();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void BoundedQueue<Tp_>::Close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  not_empty_.notify_all();
+  not_full_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE void BoundedQueue<Tp_>::Reopen() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  closed_ = false;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool BoundedQueue<Tp_>::IsClosed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return closed_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t BoundedQueue<Tp_>::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return elements_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t BoundedQueue<Tp_>::Capacity() const ATLAS_NOEXCEPT {
+  return capacity_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE QueuePolicy BoundedQueue<Tp_>::GetPolicy() const ATLAS_NOEXCEPT {
+  return policy_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE uint64_t BoundedQueue<Tp_>::DropCount() const ATLAS_NOEXCEPT {
+  return drop_count_;
+}
+
+}  // namespace atlas
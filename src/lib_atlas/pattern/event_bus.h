@@ -0,0 +1,266 @@
+/**
+ * \file	event_bus.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_EVENT_BUS_H_
+#define LIB_ATLAS_PATTERN_EVENT_BUS_H_
+
+#include <lib_atlas/macros.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * Routes events by their type between the modules of a process.
+ *
+ * A topic is a type, its events are instances of it:
+ *
+ *   struct DepthEvent {
+ *     int64_t stamp_ns;
+ *     double depth;
+ *   };
+ *
+ *   bus.Subscribe<DepthEvent>([](const DepthEvent &event) { ... });
+ *   bus.Publish(DepthEvent{now, 2.5});
+ *
+ * Each topic type is given a dense id the first time it is used, the same
+ * for all the buses of the process. So a publication indexes an array of
+ * topics and iterates a contiguous array of handlers, where a Subject
+ * would take a mutex and make a virtual call per observer. A batch of
+ * events is delivered with a single lookup.
+ *
+ * Publish() takes no lock and any number of threads may publish at once.
+ * The handlers of a topic are an immutable array replaced by Subscribe()
+ * and Unsubscribe(), which wait for the publications that may still use
+ * the previous array before freeing it. A publication registers in one of
+ * two reader counters, an update switches the publications to the other
+ * counter and waits for the first to drain, then does the same for the
+ * second, so a stream of publications cannot hold it back.
+ *
+ * When Unsubscribe() returns, the handler is not called anymore, except
+ * from a publication of the calling thread: a handler may unsubscribe
+ * itself, or subscribe others, the current publication still calls the
+ * handlers it started with.
+ */
+class EventBus {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<EventBus>;
+
+  /** Identifies a subscription of the bus, 0 is never used. */
+  using SubscriptionId = uint64_t;
+
+  template <typename Topic_>
+  using Handler = std::function<void(const Topic_ &)>;
+
+  /** The number of topic types a process may use. */
+  static const size_t kMaxTopicCount = 256;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  EventBus() ATLAS_NOEXCEPT;
+
+  /**
+   * No publication may be running.
+   */
+  ~EventBus() ATLAS_NOEXCEPT;
+
+  EventBus(const EventBus &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  EventBus &operator=(const EventBus &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Call the handler for the events of the topic, after the ones already
+   * subscribed.
+   *
+   * \throw std::invalid_argument if the handler is empty.
+   * \throw std::length_error if the process uses more than kMaxTopicCount
+   *        topics.
+   */
+  template <typename Topic_>
+  SubscriptionId Subscribe(Handler<Topic_> handler);
+
+  /**
+   * \throw std::invalid_argument if the subscription does not exist.
+   */
+  void Unsubscribe(SubscriptionId id);
+
+  /**
+   * Call the handlers of the topic of the event, on the calling thread.
+   */
+  template <typename Topic_>
+  void Publish(const Topic_ &event) const ATLAS_NOEXCEPT;
+
+  /**
+   * Deliver the events in order to each handler, one handler after the
+   * other.
+   */
+  template <typename Topic_>
+  void Publish(const Topic_ *events, size_t count) const ATLAS_NOEXCEPT;
+
+  template <typename Topic_>
+  void Publish(const std::vector<Topic_> &events) const ATLAS_NOEXCEPT;
+
+  template <typename Topic_>
+  size_t SubscriberCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The id of a topic, given in the order the topics are first
+   *         used in the process.
+   */
+  template <typename Topic_>
+  static size_t TopicId() ATLAS_NOEXCEPT;
+
+  /** \return The number of topics the process used so far. */
+  static size_t TopicCount() ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  /** The reader counters and the update of a topic, whatever its type. */
+  class TopicBase {
+   public:
+    TopicBase() ATLAS_NOEXCEPT;
+
+    virtual ~TopicBase() ATLAS_NOEXCEPT = default;
+
+    /** Register a publication, \return the counter to leave. */
+    size_t Enter() const ATLAS_NOEXCEPT;
+
+    void Leave(size_t counter) const ATLAS_NOEXCEPT;
+
+    /**
+     * Publish a copy of the array without the subscription, the bus mutex
+     * must be held.
+     *
+     * \return The generation to reclaim, 0 if the subscription is not in
+     *         this topic.
+     */
+    virtual uint64_t Remove(SubscriptionId id) = 0;
+
+    /**
+     * Free the arrays replaced up to a generation, once the publications
+     * that may use them are done. The bus mutex must not be held.
+     */
+    void Reclaim(std::mutex &mutex, uint64_t generation);
+
+   protected:
+    struct Retired {
+      std::shared_ptr<const void> array;
+      uint64_t generation;
+    };
+
+    /** Wait for the publications, \return false if some are our own. */
+    bool WaitForPublications();
+
+    std::vector<Retired> retired_;
+
+    uint64_t generation_;
+
+   private:
+    /** The publications of the calling thread, with their counter. */
+    static std::vector<std::pair<const TopicBase *, size_t>> &
+    ThreadPublications();
+
+    size_t WaitForCounter(size_t counter) const;
+
+    std::atomic<size_t> epoch_;
+
+    mutable std::array<std::atomic<size_t>, 2> readers_;
+  };
+
+  template <typename Topic_>
+  class Topic : public TopicBase {
+   public:
+    struct Subscriber {
+      SubscriptionId id;
+      Handler<Topic_> handler;
+    };
+
+    using SubscriberArray = std::vector<Subscriber>;
+
+    Topic() ATLAS_NOEXCEPT;
+
+    ~Topic() ATLAS_NOEXCEPT;
+
+    const SubscriberArray &Subscribers() const ATLAS_NOEXCEPT;
+
+    /**
+     * Publish a copy of the array with the subscriber, the bus mutex must be
+     * held. \return The generation to reclaim.
+     */
+    uint64_t Add(SubscriptionId id, Handler<Topic_> handler);
+
+    uint64_t Remove(SubscriptionId id) override;
+
+   private:
+    uint64_t Replace(SubscriberArray *subscribers);
+
+    std::atomic<const SubscriberArray *> subscribers_;
+  };
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /** \return The next topic id, used once by each TopicId(). */
+  static size_t NextTopicId() ATLAS_NOEXCEPT;
+
+  static std::atomic<size_t> &TopicCounter() ATLAS_NOEXCEPT;
+
+  template <typename Topic_>
+  const Topic<Topic_> *FindTopic() const ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /** Serializes the updates, never held by a publication. */
+  std::mutex mutex_;
+
+  std::array<std::atomic<TopicBase *>, kMaxTopicCount> topics_;
+
+  uint32_t next_subscription_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/event_bus_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_EVENT_BUS_H_
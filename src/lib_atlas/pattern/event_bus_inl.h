@@ -0,0 +1,350 @@
+/**
+ * \file	event_bus_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_EVENT_BUS_H_
+#error This file may only be included from event_bus.h
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE EventBus::EventBus() ATLAS_NOEXCEPT : mutex_(),
+                                                   topics_(),
+                                                   next_subscription_(0) {
+  for (std::atomic<TopicBase *> &topic : topics_) {
+    topic.store(nullptr);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE EventBus::~EventBus() ATLAS_NOEXCEPT {
+  for (std::atomic<TopicBase *> &topic : topics_) {
+    delete topic.load();
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE EventBus::TopicBase::TopicBase() ATLAS_NOEXCEPT : retired_(),
+                                                               generation_(0),
+                                                               epoch_(0),
+                                                               readers_() {
+  readers_[0].store(0);
+  readers_[1].store(0);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_INLINE EventBus::Topic<Topic_>::Topic() ATLAS_NOEXCEPT
+    : TopicBase(),
+      subscribers_(new SubscriberArray()) {}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_INLINE EventBus::Topic<Topic_>::~Topic() ATLAS_NOEXCEPT {
+  delete subscribers_.load();
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_INLINE EventBus::SubscriptionId EventBus::Subscribe(
+    Handler<Topic_> handler) {
+  if (!handler) {
+    throw std::invalid_argument("The handler is empty.");
+  }
+  const size_t topic_id = TopicId<Topic_>();
+  if (topic_id >= kMaxTopicCount) {
+    throw std::length_error("Too many event topics.");
+  }
+  Topic<Topic_> *topic;
+  SubscriptionId id;
+  uint64_t generation;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TopicBase *base = topics_[topic_id].load();
+    if (base == nullptr) {
+      base = new Topic<Topic_>();
+      topics_[topic_id].store(base);
+    }
+    topic = static_cast<Topic<Topic_> *>(base);
+    id = (static_cast<SubscriptionId>(topic_id + 1) << 32) |
+         ++next_subscription_;
+    generation = topic->Add(id, std::move(handler));
+  }
+  topic->Reclaim(mutex_, generation);
+  return id;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void EventBus::Unsubscribe(SubscriptionId id) {
+  const SubscriptionId topic_id = id >> 32;
+  TopicBase *topic = nullptr;
+  uint64_t generation = 0;
+  if (topic_id != 0 && topic_id <= kMaxTopicCount) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    topic = topics_[topic_id - 1].load();
+    if (topic != nullptr) {
+      generation = topic->Remove(id);
+    }
+  }
+  if (generation == 0) {
+    throw std::invalid_argument("The subscription does not exist.");
+  }
+  topic->Reclaim(mutex_, generation);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_ALWAYS_INLINE void EventBus::Publish(const Topic_ &event) const
+    ATLAS_NOEXCEPT {
+  Publish(&event, 1);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_ALWAYS_INLINE void EventBus::Publish(const Topic_ *events,
+                                           size_t count) const ATLAS_NOEXCEPT {
+  const Topic<Topic_> *topic = FindTopic<Topic_>();
+  if (topic == nullptr) {
+    return;
+  }
+  const size_t counter = topic->Enter();
+  for (const typename Topic<Topic_>::Subscriber &subscriber :
+       topic->Subscribers()) {
+    for (size_t i = 0; i < count; ++i) {
+      subscriber.handler(events[i]);
+    }
+  }
+  topic->Leave(counter);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_ALWAYS_INLINE void EventBus::Publish(
+    const std::vector<Topic_> &events) const ATLAS_NOEXCEPT {
+  Publish(events.data(), events.size());
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_INLINE size_t EventBus::SubscriberCount() const ATLAS_NOEXCEPT {
+  const Topic<Topic_> *topic = FindTopic<Topic_>();
+  if (topic == nullptr) {
+    return 0;
+  }
+  const size_t counter = topic->Enter();
+  const size_t count = topic->Subscribers().size();
+  topic->Leave(counter);
+  return count;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_ALWAYS_INLINE size_t EventBus::TopicId() ATLAS_NOEXCEPT {
+  static const size_t id = NextTopicId();
+  return id;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t EventBus::TopicCount() ATLAS_NOEXCEPT {
+  return TopicCounter().load();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t EventBus::NextTopicId() ATLAS_NOEXCEPT {
+  return TopicCounter()++;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::atomic<size_t> &EventBus::TopicCounter() ATLAS_NOEXCEPT {
+  static std::atomic<size_t> counter(0);
+  return counter;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_ALWAYS_INLINE const EventBus::Topic<Topic_> *EventBus::FindTopic() const
+    ATLAS_NOEXCEPT {
+  const size_t topic_id = TopicId<Topic_>();
+  if (topic_id >= kMaxTopicCount) {
+    return nullptr;
+  }
+  return static_cast<const Topic<Topic_> *>(
+      topics_[topic_id].load(std::memory_order_acquire));
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE size_t EventBus::TopicBase::Enter() const ATLAS_NOEXCEPT {
+  const size_t counter = epoch_.load() & 1;
+  readers_[counter].fetch_add(1);
+  ThreadPublications().emplace_back(this, counter);
+  return counter;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void EventBus::TopicBase::Leave(size_t counter) const
+    ATLAS_NOEXCEPT {
+  ThreadPublications().pop_back();
+  readers_[counter].fetch_sub(1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void EventBus::TopicBase::Reclaim(std::mutex &mutex,
+                                               uint64_t generation) {
+  // A publication of this thread may still use the arrays, a later update
+  // frees them.
+  if (!WaitForPublications()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                [generation](const Retired &retired) {
+                                  return retired.generation <= generation;
+                                }),
+                 retired_.end());
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool EventBus::TopicBase::WaitForPublications() {
+  // Whatever the updates running at the same time, both counters are seen
+  // drained after the array was replaced. Moving the new publications to
+  // the other counter first makes sure they drain.
+  const size_t first = epoch_.fetch_add(1) & 1;
+  size_t own_count = WaitForCounter(first);
+  epoch_.fetch_add(1);
+  own_count += WaitForCounter(first ^ 1);
+  return own_count == 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t
+EventBus::TopicBase::WaitForCounter(size_t counter) const {
+  const std::vector<std::pair<const TopicBase *, size_t>> &publications =
+      ThreadPublications();
+  const size_t own_count = static_cast<size_t>(
+      std::count(publications.begin(), publications.end(),
+                 std::make_pair(this, counter)));
+  for (int i = 0; readers_[counter].load() > own_count; ++i) {
+    // Most publications are short, do not sleep for them.
+    if (i < 100) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+  return own_count;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::vector<std::pair<const EventBus::TopicBase *, size_t>>
+    &EventBus::TopicBase::ThreadPublications() {
+  static thread_local std::vector<std::pair<const TopicBase *, size_t>>
+      publications;
+  return publications;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_ALWAYS_INLINE const typename EventBus::Topic<Topic_>::SubscriberArray &
+EventBus::Topic<Topic_>::Subscribers() const ATLAS_NOEXCEPT {
+  return *subscribers_.load();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_INLINE uint64_t EventBus::Topic<Topic_>::Add(SubscriptionId id,
+                                                   Handler<Topic_> handler) {
+  SubscriberArray *subscribers = new SubscriberArray(*subscribers_.load());
+  Subscriber subscriber;
+  subscriber.id = id;
+  subscriber.handler = std::move(handler);
+  subscribers->push_back(std::move(subscriber));
+  return Replace(subscribers);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_INLINE uint64_t EventBus::Topic<Topic_>::Remove(SubscriptionId id) {
+  const SubscriberArray &current = *subscribers_.load();
+  auto it = std::find_if(
+      current.begin(), current.end(),
+      [id](const Subscriber &subscriber) { return subscriber.id == id; });
+  if (it == current.end()) {
+    return 0;
+  }
+  SubscriberArray *subscribers = new SubscriberArray(current.begin(), it);
+  subscribers->insert(subscribers->end(), it + 1, current.end());
+  return Replace(subscribers);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename Topic_>
+ATLAS_INLINE uint64_t
+EventBus::Topic<Topic_>::Replace(SubscriberArray *subscribers) {
+  const SubscriberArray *previous = subscribers_.exchange(subscribers);
+  Retired retired;
+  retired.array = std::shared_ptr<const void>(previous);
+  retired.generation = ++generation_;
+  retired_.push_back(retired);
+  return retired.generation;
+}
+
+}  // namespace atlas
@@ -0,0 +1,140 @@
+/**
+ * \file	lock_free_queue.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_LOCK_FREE_QUEUE_H_
+#define LIB_ATLAS_PATTERN_LOCK_FREE_QUEUE_H_
+
+#include <lib_atlas/macros.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * A bounded multi producers, multi consumers FIFO queue that never locks.
+ *
+ * This is the algorithm of Dmitry Vyukov: each cell of a circular array
+ * holds a sequence number telling if it is ready to be written or read, so a
+ * producer or a consumer only has to win a compare and swap on its position
+ * counter to own a cell.
+ *
+ * The queue never waits, TryPush() fails when the queue is full and TryPop()
+ * fails when it is empty. How to wait is up to the user of the queue.
+ *
+ * For more informations:
+ * http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * \tparam Tp_ The type of the elements, it must be default constructible
+ *         and move assignable.
+ */
+template <class Tp_>
+class LockFreeQueue {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<LockFreeQueue<Tp_>>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param capacity The maximum number of elements, it is rounded up to the
+   *        next power of two.
+   */
+  explicit LockFreeQueue(size_t capacity);
+
+  ~LockFreeQueue() ATLAS_NOEXCEPT = default;
+
+  LockFreeQueue(const LockFreeQueue<Tp_> &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  LockFreeQueue<Tp_> &operator=(const LockFreeQueue<Tp_> &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Move an element at the end of the queue.
+   *
+   * \return False if the queue is full, the element is left untouched.
+   */
+  bool TryPush(Tp_ &&element);
+
+  /**
+   * Move the first element of the queue out.
+   *
+   * \return False if the queue is empty.
+   */
+  bool TryPop(Tp_ &element);
+
+  /**
+   * \return The number of elements in the queue. As the other threads keep
+   *         working, this is only an approximation.
+   */
+  size_t Size() const ATLAS_NOEXCEPT;
+
+  bool IsEmpty() const ATLAS_NOEXCEPT;
+
+  size_t Capacity() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    Tp_ element;
+  };
+
+  /** The size of a cache line, used to keep the counters apart. */
+  static const size_t kCacheLineSize = 64;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  std::vector<Cell> cells_;
+
+  size_t mask_;
+
+  // The producers and the consumers each hammer their own counter, the
+  // padding keeps them from invalidating the cache line of each other.
+  char padding_before_push_[kCacheLineSize];
+
+  std::atomic<size_t> push_position_;
+
+  char padding_before_pop_[kCacheLineSize];
+
+  std::atomic<size_t> pop_position_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/lock_free_queue_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_LOCK_FREE_QUEUE_H_
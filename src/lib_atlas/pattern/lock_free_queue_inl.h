@@ -0,0 +1,143 @@
+/**
+ * \file	lock_free_queue_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_LOCK_FREE_QUEUE_H_
+#error This file may only be included from lock_free_queue.h
+#endif
+
+#include <stdexcept>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE LockFreeQueue<Tp_>::LockFreeQueue(size_t capacity)
+    : cells_(),
+      mask_(0),
+      padding_before_push_(),
+      push_position_(0),
+      padding_before_pop_(),
+      pop_position_(0) {
+  if (capacity == 0) {
+    throw std::invalid_argument("The capacity of the queue must not be 0.");
+  }
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  // std::atomic cannot be copied, so the cells cannot be given a value.
+  std::vector<Cell> cells(size);
+  cells_.swap(cells);
+  for (size_t i = 0; i < size; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mask_ = size - 1;
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool LockFreeQueue<Tp_>::TryPush(Tp_ &&element) {
+  size_t position = push_position_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell &cell = cells_[position & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    intptr_t difference =
+        static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+    if (difference == 0) {
+      // The cell is free, try to take it.
+      if (push_position_.compare_exchange_weak(position, position + 1,
+                                               std::memory_order_relaxed)) {
+        cell.element = std::move(element);
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      // The cell still holds the element of the previous lap.
+      return false;
+    } else {
+      position = push_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool LockFreeQueue<Tp_>::TryPop(Tp_ &element) {
+  size_t position = pop_position_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell &cell = cells_[position & mask_];
+    size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    intptr_t difference = static_cast<intptr_t>(sequence) -
+                          static_cast<intptr_t>(position + 1);
+    if (difference == 0) {
+      if (pop_position_.compare_exchange_weak(position, position + 1,
+                                              std::memory_order_relaxed)) {
+        element = std::move(cell.element);
+        // Mark the cell free for the next lap of the producers.
+        cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (difference < 0) {
+      return false;
+    } else {
+      position = pop_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t LockFreeQueue<Tp_>::Size() const ATLAS_NOEXCEPT {
+  size_t pop = pop_position_.load(std::memory_order_acquire);
+  size_t push = push_position_.load(std::memory_order_acquire);
+  return push > pop ? push - pop : 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool LockFreeQueue<Tp_>::IsEmpty() const ATLAS_NOEXCEPT {
+  return Size() == 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t LockFreeQueue<Tp_>::Capacity() const ATLAS_NOEXCEPT {
+  return cells_.size();
+}
+
+}  // namespace atlas
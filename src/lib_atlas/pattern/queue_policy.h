@@ -0,0 +1,59 @@
+/**
+ * \file	queue_policy.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_QUEUE_POLICY_H_
+#define LIB_ATLAS_PATTERN_QUEUE_POLICY_H_
+
+namespace atlas {
+
+/**
+ * What a bounded queue does when an element is pushed while it is full.
+ */
+enum class QueuePolicy {
+  /** Wait until the consumer makes room for the element. */
+  BLOCK = 0,
+
+  /** Discard the oldest element of the queue to make room for the new one. */
+  DROP_OLDEST,
+
+  /** Refuse the new element and report it to the producer. */
+  FAIL,
+
+  /**
+   * Discard the new element, like FAIL, for the producers that do not care
+   * about the result of the push.
+   */
+  DROP_NEWEST,
+
+  /**
+   * Discard all the elements still in the queue when a new one is pushed,
+   * the consumer only ever sees the latest element.
+   */
+  KEEP_LATEST
+};
+
+}  // namespace atlas
+
+#endif  // LIB_ATLAS_PATTERN_QUEUE_POLICY_H_
@@ -0,0 +1,166 @@
+/**
+ * \file	rcu_subject.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_RCU_SUBJECT_H_
+#define LIB_ATLAS_PATTERN_RCU_SUBJECT_H_
+
+#include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/pattern/subject.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace atlas {
+
+namespace details {
+
+/**
+ * \return The number of RcuSubject notifications in progress on the calling
+ *         thread, whatever the type of the subjects.
+ */
+ATLAS_ALWAYS_INLINE int &RcuNotifyDepth() ATLAS_NOEXCEPT {
+  static thread_local int depth = 0;
+  return depth;
+}
+
+}  // namespace details
+
+/**
+ * A Subject whose Notify() does not take any lock while it calls the
+ * observers.
+ *
+ * The observers are kept in an immutable list shared by the notifications
+ * (read-copy-update): Notify() takes a reference on the current list and
+ * iterates it, Attach() and Detach() publish a modified copy. So a slow
+ * observer does not block the other notifier threads nor Attach(), and an
+ * observer may detach itself, or attach another one, from its callback.
+ *
+ * When Detach() returns, the notifications of the other threads that may
+ * still call the observer are done, so it can be destroyed. This means a
+ * Detach() waits for a slow observer, while Attach() never waits.
+ *
+ * A Detach() called from a notification, of any RcuSubject, does not wait:
+ * two threads detaching from their notifications would wait for each other.
+ * The observer is only removed for the next notifications then, it must
+ * not be destroyed while the others may still call it.
+ *
+ * The list is swapped with std::atomic_load() and std::atomic_store(), the
+ * standard library may implement them with a short internal lock that is
+ * never held while an observer runs.
+ */
+template <typename... Args_>
+class RcuSubject : public Subject<Args_...> {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<RcuSubject<Args_...>>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  RcuSubject() ATLAS_NOEXCEPT;
+
+  ~RcuSubject() ATLAS_NOEXCEPT;
+
+  RcuSubject(const RcuSubject<Args_...> &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  RcuSubject<Args_...> &operator=(const RcuSubject<Args_...> &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  void Notify(NotificationParam<Args_>... args) ATLAS_NOEXCEPT override;
+
+  size_t ObserverCount() const ATLAS_NOEXCEPT override;
+
+  void Attach(Observer<Args_...> &observer) override;
+
+  /**
+   * \throw std::invalid_argument if the observer is not attached.
+   */
+  void Detach(Observer<Args_...> &observer) override;
+
+  void DetachAll() ATLAS_NOEXCEPT override;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  using ObserverList = std::vector<Observer<Args_...> *>;
+
+  using Snapshot = std::shared_ptr<const ObserverList>;
+
+  using RetiredSnapshot = std::weak_ptr<const ObserverList>;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void DetachNoCallback(Observer<Args_...> &observer) override;
+
+  /**
+   * Publish a list without the observer and wait for the notifications that
+   * use the previous lists.
+   *
+   * \throw std::invalid_argument if the observer is not attached.
+   */
+  void Remove(Observer<Args_...> &observer);
+
+  /**
+   * Publish a list and retire the current one, the mutex must be held.
+   *
+   * \return The snapshots a removal must wait for.
+   */
+  std::vector<RetiredSnapshot> Publish(Snapshot list);
+
+  /**
+   * Wait until the notifications no longer use the given snapshots. Nothing
+   * is waited for if the calling thread is in a notification, as an
+   * observer may detach itself.
+   */
+  static void WaitForReaders(const std::vector<RetiredSnapshot> &retired);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /** Only accessed with std::atomic_load() and std::atomic_store(). */
+  Snapshot snapshot_;
+
+  /** The snapshots replaced while a notification may still use them. */
+  std::vector<RetiredSnapshot> retired_;
+
+  /** Serializes the updates of the list. */
+  std::mutex update_mutex_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/rcu_subject_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_RCU_SUBJECT_H_
@@ -0,0 +1,194 @@
+/**
+ * \file	rcu_subject_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_RCU_SUBJECT_H_
+#error This file may only be included from rcu_subject.h
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE RcuSubject<Args_...>::RcuSubject() ATLAS_NOEXCEPT
+    : Subject<Args_...>(),
+      snapshot_(std::make_shared<ObserverList>()),
+      retired_(),
+      update_mutex_() {}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE RcuSubject<Args_...>::~RcuSubject() ATLAS_NOEXCEPT {
+  DetachAll();
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void RcuSubject<Args_...>::Notify(
+    NotificationParam<Args_>... args) ATLAS_NOEXCEPT {
+  Snapshot snapshot = std::atomic_load(&snapshot_);
+  ++details::RcuNotifyDepth();
+  for (Observer<Args_...> *observer : *snapshot) {
+    Subject<Args_...>::NotifyObserver(*observer, *this, args...);
+  }
+  --details::RcuNotifyDepth();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE size_t RcuSubject<Args_...>::ObserverCount() const
+    ATLAS_NOEXCEPT {
+  return std::atomic_load(&snapshot_)->size();
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void RcuSubject<Args_...>::Attach(
+    Observer<Args_...> &observer) {
+  std::lock_guard<std::mutex> lock(update_mutex_);
+  Snapshot current = std::atomic_load(&snapshot_);
+  if (std::find(current->begin(), current->end(), &observer) !=
+      current->end()) {
+    throw std::invalid_argument("The element is already in the container.");
+  }
+  // Before publishing, as this throws if the observer is inconsistent.
+  Subject<Args_...>::ConnectObserver(observer, *this);
+  std::shared_ptr<ObserverList> list = std::make_shared<ObserverList>(*current);
+  list->push_back(&observer);
+  // The previous list only misses the new observer, there is no need to wait
+  // for it here, but a later removal will.
+  Publish(std::move(list));
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void RcuSubject<Args_...>::Detach(
+    Observer<Args_...> &observer) {
+  Remove(observer);
+  Subject<Args_...>::DisconnectObserver(observer, *this);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void RcuSubject<Args_...>::DetachNoCallback(
+    Observer<Args_...> &observer) {
+  Remove(observer);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void RcuSubject<Args_...>::DetachAll() ATLAS_NOEXCEPT {
+  ObserverList observers;
+  std::vector<RetiredSnapshot> retired;
+  {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    observers = *std::atomic_load(&snapshot_);
+    retired = Publish(std::make_shared<ObserverList>());
+  }
+  WaitForReaders(retired);
+  for (Observer<Args_...> *observer : observers) {
+    Subject<Args_...>::DisconnectObserver(*observer, *this);
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void RcuSubject<Args_...>::Remove(
+    Observer<Args_...> &observer) {
+  std::vector<RetiredSnapshot> retired;
+  {
+    std::lock_guard<std::mutex> lock(update_mutex_);
+    std::shared_ptr<ObserverList> list =
+        std::make_shared<ObserverList>(*std::atomic_load(&snapshot_));
+    auto it = std::find(list->begin(), list->end(), &observer);
+    if (it == list->end()) {
+      throw std::invalid_argument("The element is not in the container.");
+    }
+    list->erase(it);
+    retired = Publish(std::move(list));
+  }
+  WaitForReaders(retired);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE std::vector<typename RcuSubject<Args_...>::RetiredSnapshot>
+RcuSubject<Args_...>::Publish(Snapshot list) {
+  Snapshot previous = std::atomic_load(&snapshot_);
+  std::atomic_store(&snapshot_, std::move(list));
+  retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                [](const RetiredSnapshot &retired) {
+                                  return retired.expired();
+                                }),
+                 retired_.end());
+  retired_.push_back(previous);
+  // A notification may use any list replaced before, not only this one.
+  return retired_;
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void RcuSubject<Args_...>::WaitForReaders(
+    const std::vector<RetiredSnapshot> &retired) {
+  if (details::RcuNotifyDepth() > 0) {
+    // The notification of this thread only ends once the caller returns,
+    // and another thread may be waiting for it in turn.
+    return;
+  }
+  for (const RetiredSnapshot &entry : retired) {
+    for (int i = 0; entry.use_count() > 0; ++i) {
+      // Most notifications are short, do not sleep for them.
+      if (i < 100) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      }
+    }
+  }
+}
+
+}  // namespace atlas
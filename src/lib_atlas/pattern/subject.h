@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <mutex>
+#include <type_traits>
 #include <vector>
 
 #include <lib_atlas/macros.h>
@@ -36,6 +37,33 @@ namespace atlas {
 template <typename... Args_>
 class Observer;
 
+/**
+ * How a notification argument is given to the observers.
+ *
+ * Scalars are passed by value and references as they are declared. The
+ * other types are passed by const reference, so that a notification does
+ * not copy them, whatever the number of observers. An observer that keeps
+ * the value copies it, once.
+ *
+ * Specialize this for a class that is cheaper to pass by value.
+ */
+template <typename Tp_>
+struct NotificationTraits {
+  using Param = typename std::conditional<std::is_scalar<Tp_>::value ||
+                                              std::is_reference<Tp_>::value,
+                                          Tp_, const Tp_ &>::type;
+};
+
+/**
+ * The type of a notification argument in Subject::Notify() and
+ * Observer::OnSubjectNotify(), e.g. an Observer<cv::Mat, int> implements:
+ *
+ *   void OnSubjectNotify(Subject<cv::Mat, int> &subject,
+ *                        const cv::Mat &image, int value) override;
+ */
+template <typename Tp_>
+using NotificationParam = typename NotificationTraits<Tp_>::Param;
+
 /**
  * A subject is an object that will send notification when is internal state
  * have changed.
@@ -65,6 +93,9 @@ class Observer;
  *   bool must_stop_searching_ = {false};
  * };
  *
+ * Notify() holds a mutex while it calls the observers, see RcuSubject for a
+ * variant that does not lock while notifying.
+ *
  * \template Args_ A list of arguments to send when a notification is thown.
  * This will usually be the list of the member an observer wants to access --
  * e.g. A reference to an image if the subject is an image provider
@@ -106,27 +137,44 @@ class Subject {
    *
    * \param args The arguments that
    */
-  void Notify(Args_... args) ATLAS_NOEXCEPT;
+  virtual void Notify(NotificationParam<Args_>... args) ATLAS_NOEXCEPT;
 
   /**
    * Return the number of observers attached to this subject.
    */
-  size_t ObserverCount() const ATLAS_NOEXCEPT;
+  virtual size_t ObserverCount() const ATLAS_NOEXCEPT;
 
   /**
    * Add a new observer to the list. Return false if already in the attached.
    */
-  void Attach(Observer<Args_...> &observer);
+  virtual void Attach(Observer<Args_...> &observer);
 
   /**
    * Remove an observer from the list. Return false if it was not attached.
    */
-  void Detach(Observer<Args_...> &observer);
+  virtual void Detach(Observer<Args_...> &observer);
 
   /**
    * Remove an observer from the list. Return false if it was not attached.
    */
-  void DetachAll() ATLAS_NOEXCEPT;
+  virtual void DetachAll() ATLAS_NOEXCEPT;
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  // The callbacks of the observers are private and only Subject is their
+  // friend, the derived subjects call them through these.
+
+  static void NotifyObserver(Observer<Args_...> &observer,
+                             Subject<Args_...> &subject,
+                             NotificationParam<Args_>... args);
+
+  static void ConnectObserver(Observer<Args_...> &observer,
+                              Subject<Args_...> &subject);
+
+  static void DisconnectObserver(Observer<Args_...> &observer,
+                                 Subject<Args_...> &subject);
 
  private:
   //============================================================================
@@ -144,7 +192,7 @@ class Subject {
    *
    * \param observer The observer we want to detach from this subject.
    */
-  void DetachNoCallback(Observer<Args_...> &observer);
+  virtual void DetachNoCallback(Observer<Args_...> &observer);
 
   //============================================================================
   // P R I V A T E   M E M B E R S
@@ -136,8 +136,8 @@ ATLAS_ALWAYS_INLINE void Subject<Args_...>::DetachAll() ATLAS_NOEXCEPT {
 //------------------------------------------------------------------------------
 //
 template <typename... Args_>
-ATLAS_ALWAYS_INLINE void Subject<Args_...>::Notify(Args_... args)
-    ATLAS_NOEXCEPT {
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::Notify(
+    NotificationParam<Args_>... args) ATLAS_NOEXCEPT {
   std::unique_lock<std::mutex> locker(observers_mutex_);
   for (const auto &observer : observers_) {
     observer->OnSubjectNotify(*this, args...);
@@ -153,4 +153,29 @@ Subject<Args_...>::ObserverCount() const ATLAS_NOEXCEPT {
   return observers_.size();
 }
 
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::NotifyObserver(
+    Observer<Args_...> &observer, Subject<Args_...> &subject,
+    NotificationParam<Args_>... args) {
+  observer.OnSubjectNotify(subject, args...);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::ConnectObserver(
+    Observer<Args_...> &observer, Subject<Args_...> &subject) {
+  observer.OnSubjectConnected(subject);
+}
+
+//------------------------------------------------------------------------------
+//
+template <typename... Args_>
+ATLAS_ALWAYS_INLINE void Subject<Args_...>::DisconnectObserver(
+    Observer<Args_...> &observer, Subject<Args_...> &subject) {
+  observer.OnSubjectDisconnected(subject);
+}
+
 }  // namespace atlas
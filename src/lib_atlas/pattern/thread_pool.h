@@ -23,20 +23,25 @@
  * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 #ifndef LIB_ATLAS_PATTERN_THREAD_POOL_H_
 #define LIB_ATLAS_PATTERN_THREAD_POOL_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <stdexcept>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <lib_atlas/macros.h>
+#include <lib_atlas/pattern/lock_free_queue.h>
+#include <lib_atlas/pattern/work_stealing_deque.h>
 
 namespace atlas {
 
@@ -46,14 +51,25 @@ namespace atlas {
 /**
  * Creates a specific number of thread in order to perform a specific number
  * of tasks.
- * All the thread are organized in a queue an an amount of time will be assigned
- * one by one for the threads.
  *
  * Creating a thread pool can be particulary usefull when you need to create
  * an instance of a task in, for exemple, a loop. You could use a thread pool
  * for your application and simply add a thread in this pool fo your need.
  *
- * This thread pool is based on this open implementation from:
+ * The pool schedules by work stealing, so that many small tasks do not queue
+ * behind a single lock:
+ *  - Each worker has a WorkStealingDeque. A task enqueued from a worker goes
+ *    in its deque, and the worker runs the most recent one first.
+ *  - A task enqueued from another thread goes in a LockFreeQueue shared by
+ *    the workers, or in a locked overflow queue when it is full.
+ *  - A worker without tasks steals the oldest task of another worker,
+ *    starting from a random one.
+ *  - A worker that found nothing for a while sleeps on a condition, which
+ *    Enqueue() only signals when a worker sleeps.
+ *
+ * The tasks enqueued before the destruction are all run before it returns.
+ *
+ * This thread pool started from this open implementation:
  * https://github.com/progschj/ThreadPool
  */
 class ThreadPool {
@@ -70,6 +86,13 @@ class ThreadPool {
 
   ~ThreadPool() ATLAS_NOEXCEPT;
 
+  ThreadPool(const ThreadPool &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
   //============================================================================
   // P U B L I C  M E T H O D S
 
@@ -77,19 +100,66 @@ class ThreadPool {
   std::future<typename std::result_of<Tp_(Args_...)>::type> Enqueue(
       Tp_ &&f, Args_ &&... args);
 
+  size_t ThreadCount() const ATLAS_NOEXCEPT;
+
  private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  using Task = std::function<void()>;
+
+  struct Worker {
+    Worker() : deque(), random(0) {}
+
+    WorkStealingDeque<Task *> deque;
+
+    /** The state of the xorshift generator choosing the victims. */
+    uint64_t random;
+  };
+
+  /** The capacity of the queue of the tasks enqueued by other threads. */
+  static const size_t kInjectionCapacity = 1024;
+
+  /** The number of searches for a task before a worker goes to sleep. */
+  static const int kSpinCount = 64;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void Submit(Task *task);
+
+  void Run(size_t index);
+
+  /** \return A task to run, null if there is none. */
+  Task *FindTask(size_t index);
+
+  bool HasTask() const ATLAS_NOEXCEPT;
+
+  /** The pool and the index of the worker running on the calling thread. */
+  static std::pair<const ThreadPool *, size_t> &CurrentWorker();
+
   //============================================================================
   // P R I V A T E   M E M B E R S
 
-  std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  LockFreeQueue<Task *> injection_;
 
-  std::queue<std::function<void()>> tasks_;
+  std::deque<Task *> overflow_;
+
+  std::atomic<size_t> overflow_size_;
+
+  std::mutex overflow_mutex_;
+
+  std::atomic<size_t> sleeping_count_;
 
   mutable std::mutex queue_mutex_;
 
   std::condition_variable condition_;
 
-  bool is_stoped_;
+  std::atomic<bool> is_stoped_;
+
+  std::vector<std::thread> threads_;
 };
 
 //==============================================================================
@@ -97,43 +167,45 @@ class ThreadPool {
 
 //------------------------------------------------------------------------------
 //
-ThreadPool::ThreadPool(size_t threads) ATLAS_NOEXCEPT : workers_(),
-                                                        tasks_(),
-                                                        queue_mutex_(),
-                                                        condition_(),
-                                                        is_stoped_(false) {
+ATLAS_INLINE ThreadPool::ThreadPool(size_t threads) ATLAS_NOEXCEPT
+    : workers_(),
+      injection_(kInjectionCapacity),
+      overflow_(),
+      overflow_size_(0),
+      overflow_mutex_(),
+      sleeping_count_(0),
+      queue_mutex_(),
+      condition_(),
+      is_stoped_(false),
+      threads_() {
   for (size_t i = 0; i < threads; ++i) {
-    workers_.emplace_back([this] {
-      for (;;) {
-        std::function<void()> task;
-
-        {
-          auto lock = std::unique_lock<std::mutex>{queue_mutex_};
-          condition_.wait(lock,
-                          [this] { return is_stoped_ || !tasks_.empty(); });
-          if (is_stoped_ && tasks_.empty()) {
-            return;
-          }
-          task = std::move(tasks_.front());
-          tasks_.pop();
-        }
-
-        task();
-      }
-    });
+    workers_.emplace_back(new Worker());
+    workers_.back()->random = (i + 1) * 0x9E3779B97F4A7C15ULL;
+  }
+  // The workers must all exist before one of them steals.
+  for (size_t i = 0; i < threads; ++i) {
+    threads_.emplace_back([this, i] { Run(i); });
   }
 }
 
 //------------------------------------------------------------------------------
 //
-ThreadPool::~ThreadPool() ATLAS_NOEXCEPT {
+ATLAS_INLINE ThreadPool::~ThreadPool() ATLAS_NOEXCEPT {
   {
     auto lock = std::unique_lock<std::mutex>{queue_mutex_};
     is_stoped_ = true;
   }
   condition_.notify_all();
-  for (std::thread &worker : workers_) {
-    worker.join();
+  for (std::thread &thread : threads_) {
+    thread.join();
+  }
+  // Without workers, the tasks are dropped and their futures are broken.
+  Task *task = nullptr;
+  while (injection_.TryPop(task)) {
+    delete task;
+  }
+  for (Task *overflow_task : overflow_) {
+    delete overflow_task;
   }
 }
 
@@ -152,18 +224,126 @@ auto ThreadPool::Enqueue(Tp_ &&f, Args_ &&... args)
 
   std::future<return_type> res = task->get_future();
 
-  {
+  if (is_stoped_) {
+    throw std::runtime_error("enqueue on stopped ThreadPool");
+  }
+
+  Submit(new Task([task]() { (*task)(); }));
+  return res;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ThreadPool::ThreadCount() const ATLAS_NOEXCEPT {
+  return workers_.size();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::Submit(Task *task) {
+  const std::pair<const ThreadPool *, size_t> &current = CurrentWorker();
+  if (current.first == this) {
+    workers_[current.second]->deque.Push(task);
+  } else if (!injection_.TryPush(std::move(task))) {
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    overflow_.push_back(task);
+    ++overflow_size_;
+  }
+  // Pairs with the fence of a worker going to sleep: either it sees the
+  // task, or this sees it sleeping.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_count_.load(std::memory_order_relaxed) != 0) {
     auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    condition_.notify_one();
+  }
+}
 
-    if (is_stoped_) {
-      throw std::runtime_error("enqueue on stopped ThreadPool");
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ThreadPool::Run(size_t index) {
+  CurrentWorker() = std::make_pair(this, index);
+  int idle_count = 0;
+  for (;;) {
+    Task *task = FindTask(index);
+    if (task != nullptr) {
+      (*task)();
+      delete task;
+      idle_count = 0;
+      continue;
+    }
+    if (++idle_count < kSpinCount) {
+      std::this_thread::yield();
+      continue;
     }
 
-    tasks_.emplace([task]() { (*task)(); });
+    auto lock = std::unique_lock<std::mutex>{queue_mutex_};
+    ++sleeping_count_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!HasTask()) {
+      if (is_stoped_) {
+        --sleeping_count_;
+        return;
+      }
+      condition_.wait(lock);
+    }
+    --sleeping_count_;
+    idle_count = 0;
   }
+}
 
-  condition_.notify_one();
-  return res;
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ThreadPool::Task *ThreadPool::FindTask(size_t index) {
+  Worker &worker = *workers_[index];
+  Task *task = nullptr;
+  if (worker.deque.Pop(task) || injection_.TryPop(task)) {
+    return task;
+  }
+  if (overflow_size_.load(std::memory_order_relaxed) != 0) {
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    if (!overflow_.empty()) {
+      task = overflow_.front();
+      overflow_.pop_front();
+      --overflow_size_;
+      return task;
+    }
+  }
+
+  worker.random ^= worker.random << 13;
+  worker.random ^= worker.random >> 7;
+  worker.random ^= worker.random << 17;
+  const size_t count = workers_.size();
+  const size_t first = static_cast<size_t>(worker.random % count);
+  for (size_t i = 0; i < count; ++i) {
+    const size_t victim = (first + i) % count;
+    if (victim != index && workers_[victim]->deque.Steal(task)) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE bool ThreadPool::HasTask() const ATLAS_NOEXCEPT {
+  if (!injection_.IsEmpty() || overflow_size_.load() != 0) {
+    return true;
+  }
+  for (const std::unique_ptr<Worker> &worker : workers_) {
+    if (!worker->deque.IsEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::pair<const ThreadPool *, size_t>
+    &ThreadPool::CurrentWorker() {
+  static thread_local std::pair<const ThreadPool *, size_t> current(nullptr,
+                                                                    0);
+  return current;
 }
 
 }  // namespace atlas
@@ -0,0 +1,155 @@
+/**
+ * \file	work_stealing_deque.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_WORK_STEALING_DEQUE_H_
+#define LIB_ATLAS_PATTERN_WORK_STEALING_DEQUE_H_
+
+#include <lib_atlas/macros.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * The deque of a worker thread that the other workers steal from, without
+ * locking.
+ *
+ * The owner pushes and pops at the bottom, the last element first, so it
+ * keeps working on what is hot in its cache. The thieves take the oldest
+ * element from the top. Only the last element is contended, owner and
+ * thieves then race on a compare and swap of the top index.
+ *
+ * This is the Chase-Lev deque, with the memory orders of Le, Pop, Cohen and
+ * Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory
+ * Models". The array grows when full, the previous arrays are kept until the
+ * destruction as a thief may still read them.
+ *
+ * \tparam Tp_ The type of the elements, it must be trivially copyable, e.g.
+ *         a pointer.
+ */
+template <class Tp_>
+class WorkStealingDeque {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<WorkStealingDeque<Tp_>>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param capacity The initial capacity, it is rounded up to the next power
+   *        of two.
+   */
+  explicit WorkStealingDeque(size_t capacity = 64);
+
+  ~WorkStealingDeque() ATLAS_NOEXCEPT = default;
+
+  WorkStealingDeque(const WorkStealingDeque<Tp_> &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  WorkStealingDeque<Tp_> &operator=(const WorkStealingDeque<Tp_> &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Add an element at the bottom, only the owner may call this.
+   */
+  void Push(Tp_ element);
+
+  /**
+   * Take the element at the bottom, only the owner may call this.
+   *
+   * \return False if the deque is empty.
+   */
+  bool Pop(Tp_ &element) ATLAS_NOEXCEPT;
+
+  /**
+   * Take the element at the top, any thread may call this.
+   *
+   * \return False if the deque is empty or another thread took the element.
+   */
+  bool Steal(Tp_ &element) ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of elements in the deque. As the other threads keep
+   *         working, this is only an approximation.
+   */
+  size_t Size() const ATLAS_NOEXCEPT;
+
+  bool IsEmpty() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   T Y P E S
+
+  struct Array {
+    explicit Array(size_t capacity);
+
+    Tp_ Get(int64_t index) const ATLAS_NOEXCEPT;
+
+    void Put(int64_t index, Tp_ element) ATLAS_NOEXCEPT;
+
+    size_t mask;
+
+    std::unique_ptr<std::atomic<Tp_>[]> cells;
+  };
+
+  /** The size of a cache line, used to keep the indexes apart. */
+  static const size_t kCacheLineSize = 64;
+
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  /** Copy the elements in an array twice as large, owner only. */
+  Array *Grow(Array *array, int64_t top, int64_t bottom);
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  // The thieves only write the top, the owner mostly writes the bottom.
+  std::atomic<int64_t> top_;
+
+  char padding_before_bottom_[kCacheLineSize];
+
+  std::atomic<int64_t> bottom_;
+
+  std::atomic<Array *> array_;
+
+  /** The current array and the previous ones, written by the owner. */
+  std::vector<std::unique_ptr<Array>> arrays_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/pattern/work_stealing_deque_inl.h>
+
+#endif  // LIB_ATLAS_PATTERN_WORK_STEALING_DEQUE_H_
@@ -0,0 +1,177 @@
+/**
+ * \file	work_stealing_deque_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_PATTERN_WORK_STEALING_DEQUE_H_
+#error This file may only be included from work_stealing_deque.h
+#endif
+
+#include <stdexcept>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE WorkStealingDeque<Tp_>::WorkStealingDeque(size_t capacity)
+    : top_(0),
+      padding_before_bottom_(),
+      bottom_(0),
+      array_(nullptr),
+      arrays_() {
+  if (capacity == 0) {
+    throw std::invalid_argument("The capacity of the deque must not be 0.");
+  }
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  arrays_.emplace_back(new Array(size));
+  array_.store(arrays_.back().get(), std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE WorkStealingDeque<Tp_>::Array::Array(size_t capacity)
+    : mask(capacity - 1), cells(new std::atomic<Tp_>[capacity]) {}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void WorkStealingDeque<Tp_>::Push(Tp_ element) {
+  const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  const int64_t top = top_.load(std::memory_order_acquire);
+  Array *array = array_.load(std::memory_order_relaxed);
+  if (bottom - top > static_cast<int64_t>(array->mask)) {
+    array = Grow(array, top, bottom);
+  }
+  array->Put(bottom, element);
+  // A release store rather than the fence of the paper, the same on x86 and
+  // understood by the thread sanitizer.
+  bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE bool WorkStealingDeque<Tp_>::Pop(Tp_ &element)
+    ATLAS_NOEXCEPT {
+  const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  Array *array = array_.load(std::memory_order_relaxed);
+  // Reserve the bottom element before looking at what the thieves took.
+  bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = top_.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return false;
+  }
+  element = array->Get(bottom);
+  if (top == bottom) {
+    // The last element, a thief may be taking it as well.
+    const bool won = top_.compare_exchange_strong(
+        top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE bool WorkStealingDeque<Tp_>::Steal(Tp_ &element)
+    ATLAS_NOEXCEPT {
+  int64_t top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64_t bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) {
+    return false;
+  }
+  Array *array = array_.load(std::memory_order_acquire);
+  Tp_ stolen = array->Get(top);
+  if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return false;
+  }
+  element = stolen;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE size_t WorkStealingDeque<Tp_>::Size() const ATLAS_NOEXCEPT {
+  const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  const int64_t top = top_.load(std::memory_order_relaxed);
+  return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE bool WorkStealingDeque<Tp_>::IsEmpty() const ATLAS_NOEXCEPT {
+  return Size() == 0;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_INLINE typename WorkStealingDeque<Tp_>::Array *
+WorkStealingDeque<Tp_>::Grow(Array *array, int64_t top, int64_t bottom) {
+  arrays_.emplace_back(new Array((array->mask + 1) * 2));
+  Array *grown = arrays_.back().get();
+  for (int64_t i = top; i < bottom; ++i) {
+    grown->Put(i, array->Get(i));
+  }
+  array_.store(grown, std::memory_order_release);
+  return grown;
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE Tp_ WorkStealingDeque<Tp_>::Array::Get(int64_t index) const
+    ATLAS_NOEXCEPT {
+  return cells[static_cast<size_t>(index) & mask].load(
+      std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+template <class Tp_>
+ATLAS_ALWAYS_INLINE void WorkStealingDeque<Tp_>::Array::Put(
+    int64_t index, Tp_ element) ATLAS_NOEXCEPT {
+  cells[static_cast<size_t>(index) & mask].store(element,
+                                                 std::memory_order_relaxed);
+}
+
+}  // namespace atlas
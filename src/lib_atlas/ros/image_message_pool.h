@@ -0,0 +1,157 @@
+/**
+ * \file	image_message_pool.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_ROS_IMAGE_MESSAGE_POOL_H_
+#define LIB_ATLAS_ROS_IMAGE_MESSAGE_POOL_H_
+
+#include <cv_bridge/cv_bridge.h>
+#include <lib_atlas/macros.h>
+#include <sensor_msgs/Image.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <opencv2/core/core.hpp>
+#include <string>
+#include <vector>
+
+namespace atlas {
+
+/**
+ * A set of image messages that are reused from one publication to the next.
+ *
+ * cv_bridge::CvImage::toImageMsg() allocates a new message and copies the
+ * pixels in it for every image. The messages of the pool are only allocated
+ * once, and ToImage() gives a cv::Mat that writes directly in the data of a
+ * message, so an image processed in place is published without any copy.
+ *
+ * A message goes back to the pool when roscpp and the subscribers of the
+ * same process have released it. When every message is in use, Acquire()
+ * allocates a message that is not part of the pool and counts a miss.
+ */
+class ImageMessagePool {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<ImageMessagePool>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  /**
+   * \param encoding The encoding of the messages, see
+   *        sensor_msgs::image_encodings.
+   * \param capacity The number of messages in the pool.
+   *
+   * \throw std::invalid_argument if the capacity is 0.
+   * \throw cv_bridge::Exception if OpenCV has no type for the encoding.
+   */
+  ImageMessagePool(const std::string &encoding, size_t capacity);
+
+  ~ImageMessagePool() ATLAS_NOEXCEPT = default;
+
+  ImageMessagePool(const ImageMessagePool &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  ImageMessagePool &operator=(const ImageMessagePool &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Get a message that nobody uses, with a data buffer for an image of the
+   * given size. Its content is the one of the last image it held.
+   */
+  sensor_msgs::ImagePtr Acquire(int rows, int cols);
+
+  /**
+   * Copy an image in a message of the pool.
+   *
+   * \throw std::invalid_argument if the type of the image is not the one of
+   *        the encoding.
+   */
+  sensor_msgs::ImagePtr FromImage(const cv::Mat &image);
+
+  /**
+   * \return An image that uses the data of the message, it must not outlive
+   *         the message.
+   */
+  static cv::Mat ToImage(const sensor_msgs::ImagePtr &message);
+
+  const std::string &GetEncoding() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The OpenCV type of the encoding, e.g. CV_8UC3 for bgr8.
+   */
+  int GetType() const ATLAS_NOEXCEPT;
+
+  size_t Capacity() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of Acquire() served by the pool.
+   */
+  uint64_t HitCount() const ATLAS_NOEXCEPT;
+
+  /**
+   * \return The number of Acquire() that had to allocate a message.
+   */
+  uint64_t MissCount() const ATLAS_NOEXCEPT;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  void Prepare(sensor_msgs::Image &message, int rows, int cols) const;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  const std::string encoding_;
+
+  const int type_;
+
+  const size_t capacity_;
+
+  /** Grows up to the capacity as the messages are needed. */
+  std::vector<sensor_msgs::ImagePtr> messages_;
+
+  /** Where the search of a free message starts. */
+  size_t next_;
+
+  std::mutex mutex_;
+
+  std::atomic<uint64_t> hit_count_;
+
+  std::atomic<uint64_t> miss_count_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/ros/image_message_pool_inl.h>
+
+#endif  // LIB_ATLAS_ROS_IMAGE_MESSAGE_POOL_H_
@@ -0,0 +1,162 @@
+/**
+ * \file	image_message_pool_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_ROS_IMAGE_MESSAGE_POOL_H_
+#error This file may only be included from image_message_pool.h
+#endif
+
+#include <boost/make_shared.hpp>
+#include <string.h>
+#include <stdexcept>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE ImageMessagePool::ImageMessagePool(const std::string &encoding,
+                                                size_t capacity)
+    : encoding_(encoding),
+      type_(cv_bridge::getCvType(encoding)),
+      capacity_(capacity),
+      messages_(),
+      next_(0),
+      mutex_(),
+      hit_count_(0),
+      miss_count_(0) {
+  if (capacity == 0) {
+    throw std::invalid_argument("The capacity must be greater than 0.");
+  }
+  messages_.reserve(capacity);
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE sensor_msgs::ImagePtr ImageMessagePool::Acquire(int rows,
+                                                             int cols) {
+  sensor_msgs::ImagePtr message;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < messages_.size() && message == nullptr; ++i) {
+      size_t index = (next_ + i) % messages_.size();
+      if (messages_[index].use_count() == 1) {
+        message = messages_[index];
+        next_ = (index + 1) % messages_.size();
+      }
+    }
+    if (message == nullptr && messages_.size() < capacity_) {
+      messages_.push_back(boost::make_shared<sensor_msgs::Image>());
+      message = messages_.back();
+    }
+  }
+  if (message != nullptr) {
+    ++hit_count_;
+  } else {
+    ++miss_count_;
+    message = boost::make_shared<sensor_msgs::Image>();
+  }
+  // Only reallocates the data if the size of the images changed.
+  Prepare(*message, rows, cols);
+  return message;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE sensor_msgs::ImagePtr ImageMessagePool::FromImage(
+    const cv::Mat &image) {
+  if (image.type() != type_) {
+    throw std::invalid_argument("The image does not match the encoding.");
+  }
+  sensor_msgs::ImagePtr message = Acquire(image.rows, image.cols);
+  size_t row_size = message->step;
+  if (image.isContinuous()) {
+    memcpy(message->data.data(), image.data, row_size * image.rows);
+  } else {
+    for (int row = 0; row < image.rows; ++row) {
+      memcpy(message->data.data() + row * row_size, image.ptr(row),
+             row_size);
+    }
+  }
+  return message;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE cv::Mat ImageMessagePool::ToImage(
+    const sensor_msgs::ImagePtr &message) {
+  return cv::Mat(message->height, message->width,
+                 cv_bridge::getCvType(message->encoding),
+                 message->data.data(), message->step);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void ImageMessagePool::Prepare(sensor_msgs::Image &message,
+                                            int rows, int cols) const {
+  message.height = static_cast<uint32_t>(rows);
+  message.width = static_cast<uint32_t>(cols);
+  message.encoding = encoding_;
+  message.is_bigendian = 0;
+  message.step = static_cast<uint32_t>(cols * CV_ELEM_SIZE(type_));
+  message.data.resize(static_cast<size_t>(message.step) * rows);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE const std::string &ImageMessagePool::GetEncoding() const
+    ATLAS_NOEXCEPT {
+  return encoding_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int ImageMessagePool::GetType() const ATLAS_NOEXCEPT {
+  return type_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t ImageMessagePool::Capacity() const ATLAS_NOEXCEPT {
+  return capacity_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t ImageMessagePool::HitCount() const ATLAS_NOEXCEPT {
+  return hit_count_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t ImageMessagePool::MissCount() const ATLAS_NOEXCEPT {
+  return miss_count_;
+}
+
+}  // namespace atlas
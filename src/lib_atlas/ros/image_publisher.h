@@ -30,6 +30,7 @@
 #include <image_transport/image_transport.h>
 #include <lib_atlas/io/image_sequence_writer.h>
 #include <lib_atlas/macros.h>
+#include <lib_atlas/ros/image_message_pool.h>
 #include <ros/ros.h>
 #include <memory>
 #include <mutex>
@@ -48,10 +49,46 @@ class ImagePublisher : public ImageSequenceWriter {
   //============================================================================
   // C O N S T R U C T O R S   A N D   D E S T R U C T O R
 
-  explicit ImagePublisher(const std::string &topic_name) ATLAS_NOEXCEPT;
+  /**
+   * \param topic_name The topic to advertise.
+   * \param encoding The encoding of the published images, the images given
+   *        to the writer must have the matching OpenCV type.
+   * \param queue_size The number of messages roscpp keeps for a slow
+   *        subscriber.
+   *
+   * \throw cv_bridge::Exception if OpenCV has no type for the encoding.
+   */
+  explicit ImagePublisher(const std::string &topic_name,
+                          const std::string &encoding = "bgr8",
+                          uint32_t queue_size = 1);
 
   ~ImagePublisher() ATLAS_NOEXCEPT;
 
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Get a message to write an image in before publishing it, see
+   * ImageMessagePool::ToImage(). This saves the copy WriteFrame() does.
+   */
+  sensor_msgs::ImagePtr AcquireMessage(int rows, int cols);
+
+  /**
+   * Stamp and publish a message without copying it.
+   */
+  void Publish(const sensor_msgs::ImagePtr &message);
+
+  /**
+   * Publish a message without copying it, stamped with the time the image
+   * was captured rather than the time it is published.
+   *
+   * \param capture_ns CLOCK_MONOTONIC when the image was captured, see
+   *        ImageFrame.
+   */
+  void Publish(const sensor_msgs::ImagePtr &message, int64_t capture_ns);
+
+  const ImageMessagePool &GetMessagePool() const ATLAS_NOEXCEPT;
+
  private:
   //============================================================================
   // P R I V A T E   M E T H O D S
@@ -62,15 +99,18 @@ class ImagePublisher : public ImageSequenceWriter {
    * This is using the paradigm of ImageSequenceWriter for publishing the image
    * on the topic.
    *
-   * If this image writer is streaming and listening a Subject<const cv::Mat &>,
+   * If this image writer is streaming and listening a Subject<ImageFrame>,
    * this method will be called for every image that is streamed by the
-   * provider.
+   * provider. The message is stamped with the capture time of the frame and
+   * carries its sequence number.
    *
    * For exemple, you could attach this ImageSequenceWriter to a class that
    * stream the content of a video file in order to publish it to a topic:
    * Everything is going to be handled by the system.
+   *
+   * The image is copied once in a message of the pool, nothing is allocated.
    */
-  void WriteImage(const cv::Mat &image) ATLAS_NOEXCEPT override;
+  void WriteFrame(const ImageFrame &frame) ATLAS_NOEXCEPT override;
 
   //============================================================================
   // P R I V A T E   M E M B E R S
@@ -80,6 +120,8 @@ class ImagePublisher : public ImageSequenceWriter {
   image_transport::ImageTransport img_transport_;
 
   image_transport::Publisher publisher_;
+
+  ImageMessagePool message_pool_;
 };
 
 }  // namespace atlas
@@ -27,8 +27,10 @@
 #error This file may only be included from image_publisher.h
 #endif
 
+#include <lib_atlas/io/details/deadline.h>
 #include <algorithm>
 #include <cassert>
+#include <stdexcept>
 
 namespace atlas {
 
@@ -38,14 +40,20 @@ namespace atlas {
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE ImagePublisher::ImagePublisher(
-    const std::string &topic_name) ATLAS_NOEXCEPT
+    const std::string &topic_name, const std::string &encoding,
+    uint32_t queue_size)
     : topic_name_(topic_name),
       img_transport_(ros::NodeHandle()),
-      publisher_(img_transport_.advertise(topic_name_, 1)) {}
+      publisher_(img_transport_.advertise(topic_name_, queue_size)),
+      // The messages roscpp keeps, the one being published and the one being
+      // written.
+      message_pool_(encoding, queue_size + 2) {}
 
 //------------------------------------------------------------------------------
 //
 ATLAS_ALWAYS_INLINE ImagePublisher::~ImagePublisher() ATLAS_NOEXCEPT {
+  // The worker thread of the writer publishes until it is stopped.
+  Stop();
   publisher_.shutdown();
 }
 
@@ -54,14 +62,52 @@ ATLAS_ALWAYS_INLINE ImagePublisher::~ImagePublisher() ATLAS_NOEXCEPT {
 
 //------------------------------------------------------------------------------
 //
-ATLAS_ALWAYS_INLINE void ImagePublisher::WriteImage(const cv::Mat &image)
+ATLAS_ALWAYS_INLINE sensor_msgs::ImagePtr ImagePublisher::AcquireMessage(
+    int rows, int cols) {
+  return message_pool_.Acquire(rows, cols);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void ImagePublisher::Publish(
+    const sensor_msgs::ImagePtr &message) {
+  message->header.stamp = ros::Time::now();
+  publisher_.publish(message);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void ImagePublisher::Publish(
+    const sensor_msgs::ImagePtr &message, int64_t capture_ns) {
+  // ROS stamps are on the wall clock, go back from now by the age of the
+  // image on the monotonic clock.
+  message->header.stamp =
+      ros::Time::now() -
+      ros::Duration().fromNSec(Deadline::Now() - capture_ns);
+  publisher_.publish(message);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE const ImageMessagePool &ImagePublisher::GetMessagePool()
+    const ATLAS_NOEXCEPT {
+  return message_pool_;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_ALWAYS_INLINE void ImagePublisher::WriteFrame(const ImageFrame &frame)
     ATLAS_NOEXCEPT {
-  if (!image.empty()) {
-    sensor_msgs::ImagePtr msg =
-        cv_bridge::CvImage(std_msgs::Header(), "bgr8", image).toImageMsg();
-    msg->header.stamp = ros::Time::now();
-    publisher_.publish(msg);
-    cv::waitKey(1);
+  if (frame.image.empty()) {
+    return;
+  }
+  try {
+    sensor_msgs::ImagePtr message = message_pool_.FromImage(frame.image);
+    message->header.seq = static_cast<uint32_t>(frame.sequence);
+    Publish(message, frame.capture_ns);
+  } catch (const std::invalid_argument &) {
+    ROS_ERROR("Unable to publish the image as %s",
+              message_pool_.GetEncoding().c_str());
   }
 }
 
@@ -29,15 +29,34 @@
 #include <cv_bridge/cv_bridge.h>
 #include <image_transport/image_transport.h>
 #include <ros/ros.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <opencv2/opencv.hpp>
+#include <string>
 
+#include <lib_atlas/io/details/deadline.h>
+#include <lib_atlas/io/frame_pool.h>
 #include <lib_atlas/io/image_sequence_capture.h>
 #include <lib_atlas/macros.h>
+#include <lib_atlas/sys/latency_histogram.h>
 
 namespace atlas {
 
+/**
+ * Receive the images of a topic.
+ *
+ * The ROS callback only converts the message and swaps the pointer to the
+ * latest image, it never waits for the readers. A reader gets a reference
+ * counted image with GetFrame(), so the image cannot change or be freed
+ * while it is used.
+ *
+ * As an ImageSequenceCapture, the subscriber streams each received image
+ * once, without copying it. The frames hold the image, see
+ * ImageFrame::buffer, so the observers may keep them as long as they need.
+ */
 class ImageSubscriber : public ImageSequenceCapture {
  public:
   //==========================================================================
@@ -45,49 +64,239 @@ class ImageSubscriber : public ImageSequenceCapture {
 
   using Ptr = std::shared_ptr<ImageSubscriber>;
 
+  using Image = std::shared_ptr<const cv::Mat>;
+
+  enum class ReceiveMode {
+    /**
+     * Keep the message and use its data as the image when it already has
+     * the encoding, nothing is copied.
+     */
+    SHARE = 0,
+
+    /**
+     * Copy the message in a frame of a FramePool, the message is released
+     * right away.
+     */
+    COPY
+  };
+
   //============================================================================
   // C O N S T R U C T O R S   A N D   D E S T R U C T O R
 
-  explicit ImageSubscriber(const std::string &topic_name)
+  explicit ImageSubscriber(const std::string &topic_name,
+                           ReceiveMode mode = ReceiveMode::SHARE,
+                           const std::string &encoding = "bgr8")
       : topic_name_(topic_name),
+        mode_(mode),
+        encoding_(encoding),
         img_transport_(ros::NodeHandle()),
         subscriber_(img_transport_.subscribe(
             topic_name_, 1, &ImageSubscriber::ImageCallback, this)),
-        image_(),
-        topic_mutex_() {}
+        pool_(),
+        latest_(),
+        received_count_(0),
+        received_mutex_(),
+        received_cv_(),
+        callback_latency_(),
+        read_image_(),
+        streamed_(),
+        streamed_count_(0),
+        empty_image_() {}
 
-  virtual ~ImageSubscriber() = default;
+  virtual ~ImageSubscriber() ATLAS_NOEXCEPT {
+    Stop();
+    subscriber_.shutdown();
+  }
 
   //============================================================================
   // P U B L I C   M E T H O D S
 
-  ATLAS_ALWAYS_INLINE const cv::Mat &GetImage() const { return image_; }
+  /**
+   * \return The last image received without copying it, an empty image if
+   *         none was. The reference is valid until the next call, use
+   *         GetFrame() to keep the image longer or from several threads.
+   */
+  ATLAS_ALWAYS_INLINE const cv::Mat &GetImage() const {
+    Image frame = GetFrame();
+    std::atomic_store(&read_image_, frame);
+    return frame == nullptr ? empty_image_ : *frame;
+  }
+
+  /**
+   * \return The last image received without copying it, nullptr if none
+   *         was. The image stays valid after the next one is received.
+   */
+  ATLAS_ALWAYS_INLINE Image GetFrame() const {
+    return std::atomic_load(&latest_);
+  }
+
+  /**
+   * \return The number of images received, a reader can compare it with
+   *         the one of its last GetFrame() to know if there is a new image.
+   */
+  ATLAS_ALWAYS_INLINE uint64_t GetReceivedCount() const ATLAS_NOEXCEPT {
+    return received_count_;
+  }
+
+  ATLAS_ALWAYS_INLINE ReceiveMode GetReceiveMode() const ATLAS_NOEXCEPT {
+    return mode_;
+  }
+
+  /**
+   * \return The pool the images are copied in, nullptr until the first
+   *         image is received or if the mode is not COPY.
+   */
+  ATLAS_ALWAYS_INLINE FramePool::Ptr GetFramePool() const {
+    return std::atomic_load(&pool_);
+  }
+
+  /**
+   * \return The distribution of the time spent in the ROS callback.
+   */
+  ATLAS_ALWAYS_INLINE const LatencyHistogram &GetCallbackLatency() const
+      ATLAS_NOEXCEPT {
+    return callback_latency_;
+  }
+
+  /**
+   * Use the data of the message as the image if it has the encoding, the
+   * image keeps the message alive.
+   *
+   * \throw cv_bridge::Exception if the message cannot be converted.
+   */
+  static Image ShareImage(const sensor_msgs::ImageConstPtr &msg,
+                          const std::string &encoding) {
+    cv_bridge::CvImageConstPtr cv_image = cv_bridge::toCvShare(msg, encoding);
+    // cv_bridge uses boost::shared_ptr, the deleter holds the reference.
+    return Image(&cv_image->image, [cv_image](const cv::Mat *) {});
+  }
+
+  /**
+   * Copy the message in a frame of the pool, the pool is replaced if the
+   * geometry of the images changed.
+   *
+   * \throw cv_bridge::Exception if the message cannot be converted.
+   */
+  static Image CopyImage(const sensor_msgs::ImageConstPtr &msg,
+                         const std::string &encoding, FramePool::Ptr &pool) {
+    // Converts in a temporary image only if the encoding differs.
+    cv_bridge::CvImageConstPtr cv_image = cv_bridge::toCvShare(msg, encoding);
+    const cv::Mat &image = cv_image->image;
+    if (pool == nullptr || !pool->Matches(image.size(), image.type())) {
+      size_t capacity = kFramePoolCapacity;
+      pool = std::make_shared<FramePool>(image.size(), image.type(), capacity);
+    }
+    FramePool::Frame frame = pool->Acquire();
+    image.copyTo(*frame);
+    return frame;
+  }
+
+ protected:
+  //============================================================================
+  // P R O T E C T E D   M E T H O D S
+
+  /**
+   * When streaming, wait for an image that was not sent yet. The image is
+   * empty if the streaming stops in the meantime.
+   */
+  const cv::Mat &GetNextImage() const override {
+    const int period_ms = kStopCheckPeriodMs;
+    std::unique_lock<std::mutex> lock(received_mutex_);
+    while (IsStreaming() && IsRunning() &&
+           received_count_ == streamed_count_) {
+      received_cv_.wait_for(lock, std::chrono::milliseconds(period_ms));
+    }
+    if (IsStreaming() && received_count_ == streamed_count_) {
+      streamed_.reset();
+      return empty_image_;
+    }
+    streamed_ = GetFrame();
+    streamed_count_ = received_count_;
+    return streamed_ == nullptr ? empty_image_ : *streamed_;
+  }
+
+  /**
+   * The streamed image is never written once received, whether it is in a
+   * frame of the pool or in a message, so the frame holds it as its buffer.
+   */
+  FramePool::Frame GetImageBuffer() const override {
+    return std::const_pointer_cast<cv::Mat>(streamed_);
+  }
 
  private:
   //============================================================================
   // P R I V A T E   M E T H O D S
 
   void ImageCallback(const sensor_msgs::ImageConstPtr &msg) {
+    int64_t start_ns = Deadline::Now();
     try {
-      auto cv_image_ptr = cv_bridge::toCvCopy(msg, "bgr8");
-      image_ = cv_image_ptr->image;
+      Image image;
+      if (mode_ == ReceiveMode::SHARE) {
+        image = ShareImage(msg, encoding_);
+      } else {
+        // The callbacks of a subscriber never run at the same time, only
+        // the readers of GetFramePool() need the atomic access.
+        FramePool::Ptr pool = std::atomic_load(&pool_);
+        image = CopyImage(msg, encoding_, pool);
+        std::atomic_store(&pool_, pool);
+      }
+      {
+        // Held only to swap the image, the count and the image match for
+        // the streaming thread.
+        std::lock_guard<std::mutex> lock(received_mutex_);
+        std::atomic_store(&latest_, image);
+        ++received_count_;
+      }
+      received_cv_.notify_one();
     } catch (cv_bridge::Exception &e) {
-      ROS_ERROR("Unable to convert %s image to bgr8", msg->encoding.c_str());
+      ROS_ERROR("Unable to convert %s image to %s", msg->encoding.c_str(),
+                encoding_.c_str());
     }
+    callback_latency_.Record(Deadline::Now() - start_ns);
   }
 
   //============================================================================
   // P R I V A T E   M E M B E R S
 
+  /**
+   * The last image and the ones still used by the consumers, at the rate of
+   * a camera this is enough for the pool to serve all the images.
+   */
+  static const size_t kFramePoolCapacity = 4;
+
   const std::string topic_name_;
 
+  const ReceiveMode mode_;
+
+  const std::string encoding_;
+
   image_transport::ImageTransport img_transport_;
 
   image_transport::Subscriber subscriber_;
 
-  cv::Mat image_;
+  FramePool::Ptr pool_;
+
+  /** Only accessed with std::atomic_load() and std::atomic_store(). */
+  Image latest_;
+
+  std::atomic<uint64_t> received_count_;
+
+  /** Notified when an image is received, for the streaming thread. */
+  mutable std::mutex received_mutex_;
+
+  mutable std::condition_variable received_cv_;
+
+  LatencyHistogram callback_latency_;
+
+  /** The image returned by GetImage(), it keeps the image alive. */
+  mutable Image read_image_;
+
+  /** The image given to the streaming thread and its received count. */
+  mutable Image streamed_;
+
+  mutable uint64_t streamed_count_;
 
-  mutable std::mutex topic_mutex_;
+  const cv::Mat empty_image_;
 };
 
 }  // namespace atlas
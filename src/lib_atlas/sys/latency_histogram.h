@@ -0,0 +1,134 @@
+/**
+ * \file	latency_histogram.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_LATENCY_HISTOGRAM_H_
+#define LIB_ATLAS_SYS_LATENCY_HISTOGRAM_H_
+
+#include <lib_atlas/macros.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace atlas {
+
+/**
+ * Distribution of latencies in nanoseconds, with percentiles.
+ *
+ * The values are counted in logarithmic buckets: each power of two is
+ * split in 16 linear buckets, so a percentile is known within 3% whatever
+ * the magnitude, and recording a value is a few instructions and an atomic
+ * increment, without any allocation. It can thus be used in the hot path
+ * of a driver.
+ *
+ * A single thread or several threads can record values, and another thread
+ * can read the statistics at the same time.
+ */
+class LatencyHistogram {
+ public:
+  //==========================================================================
+  // T Y P E D E F   A N D   E N U M
+
+  using Ptr = std::shared_ptr<LatencyHistogram>;
+
+  //============================================================================
+  // P U B L I C   C / D T O R S
+
+  LatencyHistogram() ATLAS_NOEXCEPT;
+
+  ~LatencyHistogram() ATLAS_NOEXCEPT = default;
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+
+  //============================================================================
+  // P U B L I C   O P E R A T O R S
+
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  //============================================================================
+  // P U B L I C   M E T H O D S
+
+  /**
+   * Add a value, the negative values are counted as 0.
+   */
+  void Record(int64_t value_ns) ATLAS_NOEXCEPT;
+
+  void Reset() ATLAS_NOEXCEPT;
+
+  uint64_t Count() const ATLAS_NOEXCEPT;
+
+  int64_t Min() const ATLAS_NOEXCEPT;
+
+  int64_t Max() const ATLAS_NOEXCEPT;
+
+  double Mean() const ATLAS_NOEXCEPT;
+
+  /**
+   * \param percentile The percentile in [0, 100], e.g. 99.9.
+   *
+   * \return The value under which the given percentage of the values are, or
+   *         0 if nothing was recorded.
+   */
+  int64_t Percentile(double percentile) const ATLAS_NOEXCEPT;
+
+  /**
+   * \return A one line summary of the distribution in microseconds.
+   */
+  std::string Report() const;
+
+ private:
+  //============================================================================
+  // P R I V A T E   M E T H O D S
+
+  static size_t BucketIndex(uint64_t value) ATLAS_NOEXCEPT;
+
+  /** \return The value in the middle of a bucket. */
+  static int64_t BucketValue(size_t index) ATLAS_NOEXCEPT;
+
+  //============================================================================
+  // P R I V A T E   M E M B E R S
+
+  /** The number of linear buckets in each power of two. */
+  static const size_t kSubBucketCount = 16;
+
+  /** Enough buckets for the values up to 2^63. */
+  static const size_t kBucketCount = 60 * kSubBucketCount;
+
+  std::atomic<uint64_t> buckets_[kBucketCount];
+
+  std::atomic<uint64_t> count_;
+
+  std::atomic<int64_t> sum_;
+
+  std::atomic<int64_t> min_;
+
+  std::atomic<int64_t> max_;
+};
+
+}  // namespace atlas
+
+#include <lib_atlas/sys/latency_histogram_inl.h>
+
+#endif  // LIB_ATLAS_SYS_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,183 @@
+/**
+ * \file	latency_histogram_inl.h
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_ATLAS_SYS_LATENCY_HISTOGRAM_H_
+#error This file may only be included from latency_histogram.h
+#endif
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+namespace atlas {
+
+//==============================================================================
+// C / D T O R S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE LatencyHistogram::LatencyHistogram() ATLAS_NOEXCEPT
+    : count_(0),
+      sum_(0),
+      min_(std::numeric_limits<int64_t>::max()),
+      max_(0) {
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    buckets_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+//==============================================================================
+// M E T H O D S   S E C T I O N
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void LatencyHistogram::Record(int64_t value_ns) ATLAS_NOEXCEPT {
+  if (value_ns < 0) {
+    value_ns = 0;
+  }
+  buckets_[BucketIndex(static_cast<uint64_t>(value_ns))].fetch_add(
+      1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value_ns, std::memory_order_relaxed);
+  int64_t min = min_.load(std::memory_order_relaxed);
+  while (value_ns < min &&
+         !min_.compare_exchange_weak(min, value_ns,
+                                     std::memory_order_relaxed)) {
+  }
+  int64_t max = max_.load(std::memory_order_relaxed);
+  while (value_ns > max &&
+         !max_.compare_exchange_weak(max, value_ns,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE void LatencyHistogram::Reset() ATLAS_NOEXCEPT {
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    buckets_[i].store(0, std::memory_order_relaxed);
+  }
+  count_ = 0;
+  sum_ = 0;
+  min_ = std::numeric_limits<int64_t>::max();
+  max_ = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE uint64_t LatencyHistogram::Count() const ATLAS_NOEXCEPT {
+  return count_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t LatencyHistogram::Min() const ATLAS_NOEXCEPT {
+  return Count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t LatencyHistogram::Max() const ATLAS_NOEXCEPT {
+  return max_.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE double LatencyHistogram::Mean() const ATLAS_NOEXCEPT {
+  uint64_t count = Count();
+  if (count == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+         static_cast<double>(count);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t LatencyHistogram::Percentile(double percentile) const
+    ATLAS_NOEXCEPT {
+  uint64_t count = Count();
+  if (count == 0) {
+    return 0;
+  }
+  // The rank of the value, counted from 1.
+  uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * count + 0.5);
+  if (rank <= 1) {
+    return Min();
+  }
+  if (rank >= count) {
+    return Max();
+  }
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      // The exact extremes are known, do not report beyond them.
+      return std::max(Min(), std::min(Max(), BucketValue(i)));
+    }
+  }
+  return Max();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE std::string LatencyHistogram::Report() const {
+  std::stringstream ss;
+  ss << "count " << Count() << ", min " << Min() / 1e3 << " us, p50 "
+     << Percentile(50) / 1e3 << " us, p90 " << Percentile(90) / 1e3
+     << " us, p99 " << Percentile(99) / 1e3 << " us, p99.9 "
+     << Percentile(99.9) / 1e3 << " us, max " << Max() / 1e3 << " us";
+  return ss.str();
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE size_t LatencyHistogram::BucketIndex(uint64_t value)
+    ATLAS_NOEXCEPT {
+  if (value < kSubBucketCount) {
+    return static_cast<size_t>(value);
+  }
+  // The 4 bits below the most significant one select the linear bucket.
+  size_t msb = 63 - static_cast<size_t>(__builtin_clzll(value));
+  size_t sub_bucket = static_cast<size_t>(value >> (msb - 4)) & 15;
+  size_t index = (msb - 3) * kSubBucketCount + sub_bucket;
+  return std::min(index, kBucketCount - 1);
+}
+
+//------------------------------------------------------------------------------
+//
+ATLAS_INLINE int64_t LatencyHistogram::BucketValue(size_t index)
+    ATLAS_NOEXCEPT {
+  if (index < kSubBucketCount) {
+    return static_cast<int64_t>(index);
+  }
+  size_t msb = index / kSubBucketCount + 3;
+  uint64_t sub_bucket = index % kSubBucketCount;
+  uint64_t width = uint64_t(1) << (msb - 4);
+  return static_cast<int64_t>((kSubBucketCount + sub_bucket) * width +
+                              width / 2);
+}
+
+}  // namespace atlas
@@ -0,0 +1,106 @@
+/**
+ * \file	bounded_queue_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <thread>
+#include "gtest/gtest.h"
+#include <lib_atlas/pattern/bounded_queue.h>
+
+using namespace atlas;
+
+namespace {
+
+void PushRange(BoundedQueue<int> &queue, int first, int last) {
+  for (int i = first; i < last; ++i) {
+    queue.Push(i);
+  }
+}
+
+TEST(BoundedQueueTest, policies) {
+  int value = 0;
+
+  BoundedQueue<int> drop_oldest(2, QueuePolicy::DROP_OLDEST);
+  PushRange(drop_oldest, 0, 4);
+  EXPECT_EQ(drop_oldest.DropCount(), 2);
+  ASSERT_TRUE(drop_oldest.TryPop(value));
+  EXPECT_EQ(value, 2);
+
+  BoundedQueue<int> drop_newest(2, QueuePolicy::DROP_NEWEST);
+  PushRange(drop_newest, 0, 3);
+  EXPECT_FALSE(drop_newest.Push(3));
+  EXPECT_EQ(drop_newest.DropCount(), 2);
+  ASSERT_TRUE(drop_newest.TryPop(value));
+  EXPECT_EQ(value, 0);
+
+  BoundedQueue<int> keep_latest(2, QueuePolicy::KEEP_LATEST);
+  PushRange(keep_latest, 0, 4);
+  EXPECT_EQ(keep_latest.Size(), 1);
+  EXPECT_EQ(keep_latest.DropCount(), 3);
+  ASSERT_TRUE(keep_latest.TryPop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(keep_latest.TryPop(value));
+
+  ASSERT_THROW(BoundedQueue<int>(0), std::invalid_argument);
+}
+
+TEST(BoundedQueueTest, blockUntilPopped) {
+  BoundedQueue<int> queue(2, QueuePolicy::BLOCK);
+  std::thread producer([&queue] { PushRange(queue, 0, 100); });
+  int expected = 0;
+  int value = 0;
+  while (expected < 100 && queue.Pop(value)) {
+    ASSERT_EQ(value, expected++);
+    ASSERT_LE(queue.Size(), 2);
+  }
+  producer.join();
+  EXPECT_EQ(queue.DropCount(), 0);
+}
+
+TEST(BoundedQueueTest, closeWakesUpAndDrains) {
+  BoundedQueue<int> queue(1, QueuePolicy::BLOCK);
+  queue.Push(1);
+  bool pushed = true;
+  std::thread producer([&] { pushed = queue.Push(2); });
+  usleep(10000);
+  queue.Close();
+  producer.join();
+  EXPECT_FALSE(pushed);
+
+  // The element pushed before Close() can still be popped.
+  int value = 0;
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_FALSE(queue.Pop(value));
+
+  queue.Reopen();
+  EXPECT_TRUE(queue.Push(3));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,237 @@
+/**
+ * \file	event_bus_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/details/deadline.h>
+#include <lib_atlas/pattern/event_bus.h>
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/pattern/subject.h>
+
+using namespace atlas;
+
+namespace {
+
+struct DepthEvent {
+  int64_t value;
+};
+
+struct PressureEvent {
+  int64_t value;
+};
+
+struct UnusedEvent {};
+
+TEST(EventBusTest, topicIdsAreDense) {
+  const size_t depth_id = EventBus::TopicId<DepthEvent>();
+  const size_t pressure_id = EventBus::TopicId<PressureEvent>();
+  EXPECT_NE(depth_id, pressure_id);
+  EXPECT_EQ(EventBus::TopicId<DepthEvent>(), depth_id);
+  EXPECT_LT(depth_id, EventBus::TopicCount());
+  EXPECT_LT(pressure_id, EventBus::TopicCount());
+  EXPECT_LE(EventBus::TopicCount(), 16);
+}
+
+TEST(EventBusTest, subscribeAndPublish) {
+  EventBus bus;
+  std::vector<int64_t> first, second, pressures;
+  EventBus::SubscriptionId first_id = bus.Subscribe<DepthEvent>(
+      [&first](const DepthEvent &event) { first.push_back(event.value); });
+  bus.Subscribe<DepthEvent>(
+      [&second](const DepthEvent &event) { second.push_back(event.value); });
+  bus.Subscribe<PressureEvent>([&pressures](const PressureEvent &event) {
+    pressures.push_back(event.value);
+  });
+  EXPECT_EQ(bus.SubscriberCount<DepthEvent>(), 2);
+  EXPECT_EQ(bus.SubscriberCount<UnusedEvent>(), 0);
+  ASSERT_THROW(bus.Subscribe<DepthEvent>(EventBus::Handler<DepthEvent>()),
+               std::invalid_argument);
+
+  bus.Publish(DepthEvent{1});
+  bus.Publish(PressureEvent{2});
+  bus.Publish(UnusedEvent());
+  EXPECT_EQ(first, std::vector<int64_t>({1}));
+  EXPECT_EQ(second, std::vector<int64_t>({1}));
+  EXPECT_EQ(pressures, std::vector<int64_t>({2}));
+
+  bus.Unsubscribe(first_id);
+  ASSERT_THROW(bus.Unsubscribe(first_id), std::invalid_argument);
+  ASSERT_THROW(bus.Unsubscribe(0), std::invalid_argument);
+  bus.Publish(DepthEvent{3});
+  EXPECT_EQ(first, std::vector<int64_t>({1}));
+  EXPECT_EQ(second, std::vector<int64_t>({1, 3}));
+}
+
+TEST(EventBusTest, batchIsDeliveredInOrder) {
+  EventBus bus;
+  std::vector<int64_t> values;
+  bus.Subscribe<DepthEvent>(
+      [&values](const DepthEvent &event) { values.push_back(event.value); });
+  std::vector<DepthEvent> events;
+  for (int64_t i = 0; i < 100; ++i) {
+    events.push_back(DepthEvent{i});
+  }
+  bus.Publish(events);
+  ASSERT_EQ(values.size(), 100);
+  for (int64_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+}
+
+TEST(EventBusTest, handlerUnsubscribesItself) {
+  EventBus bus;
+  int count = 0;
+  int other_count = 0;
+  EventBus::SubscriptionId id = 0;
+  id = bus.Subscribe<DepthEvent>([&](const DepthEvent &event) {
+    ++count;
+    bus.Unsubscribe(id);
+    bus.Subscribe<DepthEvent>(
+        [&other_count](const DepthEvent &event) { ++other_count; });
+  });
+  // The publication calls the handlers it started with.
+  bus.Publish(DepthEvent{1});
+  EXPECT_EQ(count, 1);
+  EXPECT_EQ(other_count, 0);
+  bus.Publish(DepthEvent{2});
+  EXPECT_EQ(count, 1);
+  EXPECT_EQ(other_count, 1);
+}
+
+TEST(EventBusTest, unsubscribeWaitsForPublications) {
+  EventBus bus;
+  std::atomic<bool> stop(false);
+  std::atomic<uint64_t> published(0);
+  std::vector<std::thread> producers;
+  for (int i = 0; i < 4; ++i) {
+    producers.emplace_back([&] {
+      while (!stop) {
+        bus.Publish(DepthEvent{1});
+        ++published;
+      }
+    });
+  }
+  for (int i = 0; i < 50; ++i) {
+    std::unique_ptr<std::atomic<int64_t>> sum(new std::atomic<int64_t>(0));
+    std::atomic<int64_t> *target = sum.get();
+    EventBus::SubscriptionId id = bus.Subscribe<DepthEvent>(
+        [target](const DepthEvent &event) { *target += event.value; });
+    std::this_thread::yield();
+    bus.Unsubscribe(id);
+    // No publication may use the handler once unsubscribed.
+    sum.reset();
+  }
+  stop = true;
+  for (std::thread &producer : producers) {
+    producer.join();
+  }
+  EXPECT_GT(published, 0);
+  EXPECT_EQ(bus.SubscriberCount<DepthEvent>(), 0);
+}
+
+class DepthObserver : public Observer<const DepthEvent &> {
+ public:
+  DepthObserver() : sum_(0) {}
+
+  std::atomic<int64_t> sum_;
+
+ protected:
+  void OnSubjectNotify(Subject<const DepthEvent &> &subject,
+                       const DepthEvent &event) override {
+    sum_.fetch_add(event.value, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * Delivers events to n subscribers through a Subject and through the bus,
+ * from one thread and then from 4 producers.
+ */
+void RunFanOutBenchmark(size_t subscriber_count, size_t producer_count) {
+  const int64_t event_count = 2000000 / subscriber_count / producer_count;
+
+  Subject<const DepthEvent &> subject;
+  std::vector<std::unique_ptr<DepthObserver>> observers;
+  EventBus bus;
+  std::vector<std::unique_ptr<std::atomic<int64_t>>> sums;
+  for (size_t i = 0; i < subscriber_count; ++i) {
+    observers.emplace_back(new DepthObserver);
+    observers.back()->Observe(subject);
+    sums.emplace_back(new std::atomic<int64_t>(0));
+    std::atomic<int64_t> *sum = sums.back().get();
+    bus.Subscribe<DepthEvent>([sum](const DepthEvent &event) {
+      sum->fetch_add(event.value, std::memory_order_relaxed);
+    });
+  }
+
+  auto run = [&](const std::function<void(const DepthEvent &)> &publish) {
+    std::vector<std::thread> producers;
+    int64_t start_ns = Deadline::Now();
+    for (size_t p = 0; p < producer_count; ++p) {
+      producers.emplace_back([&] {
+        for (int64_t i = 0; i < event_count; ++i) {
+          publish(DepthEvent{1});
+        }
+      });
+    }
+    for (std::thread &producer : producers) {
+      producer.join();
+    }
+    double seconds = static_cast<double>(Deadline::Now() - start_ns) /
+                     Deadline::kNanosecondsPerSecond;
+    return event_count * producer_count * subscriber_count / seconds;
+  };
+
+  double subject_rate =
+      run([&subject](const DepthEvent &event) { subject.Notify(event); });
+  double bus_rate =
+      run([&bus](const DepthEvent &event) { bus.Publish(event); });
+  for (const std::unique_ptr<std::atomic<int64_t>> &sum : sums) {
+    EXPECT_EQ(*sum, event_count * static_cast<int64_t>(producer_count));
+  }
+  std::cout << "[ BENCH    ] " << subscriber_count << " subscribers, "
+            << producer_count << " producers: Subject " << subject_rate
+            << " deliveries/s, EventBus " << bus_rate << " deliveries/s"
+            << std::endl;
+}
+
+TEST(EventBusTest, DISABLED_fanOutBenchmark) {
+  for (size_t subscriber_count : {1, 8, 64}) {
+    RunFanOutBenchmark(subscriber_count, 1);
+    RunFanOutBenchmark(subscriber_count, 4);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,186 @@
+/**
+ * \file	file_capture_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/image_directory_capture.h>
+#include <lib_atlas/pattern/observer.h>
+#include <opencv2/highgui/highgui.hpp>
+
+using namespace atlas;
+
+namespace {
+
+class FrameCollector : public Observer<ImageFrame> {
+ public:
+  /** The first byte of the images, which is their index. */
+  std::vector<int> indexes_;
+
+  /** The number of frames that hold a pooled buffer. */
+  int pooled_count_ = 0;
+
+  int empty_count_ = 0;
+
+ protected:
+  void OnSubjectNotify(Subject<ImageFrame> &subject,
+                       const ImageFrame &frame) override {
+    if (frame.image.empty()) {
+      ++empty_count_;
+      return;
+    }
+    indexes_.push_back(frame.image.data[0]);
+    pooled_count_ += frame.buffer != nullptr;
+  }
+};
+
+const int kImageCount = 40;
+
+class ImageDirectoryCaptureTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    char directory[] = "/tmp/atlas_file_capture_XXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    directory_ = directory;
+    for (int i = 0; i < kImageCount; ++i) {
+      char name[32];
+      snprintf(name, sizeof(name), "/frame_%03d.png", i);
+      cv::Mat image(16, 16, CV_8UC3, cv::Scalar(i, i, i));
+      ASSERT_TRUE(cv::imwrite(directory_ + name, image));
+      files_.push_back(directory_ + name);
+    }
+    FILE *notes = fopen((directory_ + "/notes.txt").c_str(), "w");
+    fclose(notes);
+    files_.push_back(directory_ + "/notes.txt");
+  }
+
+  virtual void TearDown() {
+    for (const std::string &file : files_) {
+      unlink(file.c_str());
+    }
+    rmdir(directory_.c_str());
+  }
+
+  /** Stream the whole directory and wait for the end. */
+  void Replay(ImageDirectoryCapture &capture, FrameCollector &collector) {
+    collector.Observe(capture);
+    capture.Start();
+    capture.SetStreamingMode(true);
+    for (int i = 0; i < 500 && !capture.IsAtEnd(); ++i) {
+      usleep(10000);
+    }
+    capture.Stop();
+  }
+
+  std::string directory_;
+  std::vector<std::string> files_;
+};
+
+TEST_F(ImageDirectoryCaptureTest, listImages) {
+  ImageDirectoryCapture capture(directory_, 30);
+  ASSERT_EQ(capture.GetFiles().size(), kImageCount);
+  EXPECT_EQ(capture.GetFiles().front(), directory_ + "/frame_000.png");
+  EXPECT_EQ(capture.GetFiles().back(), directory_ + "/frame_039.png");
+
+  EXPECT_TRUE(ImageDirectoryCapture::IsImageFile("left.JPG"));
+  EXPECT_FALSE(ImageDirectoryCapture::IsImageFile("notes.txt"));
+  EXPECT_FALSE(ImageDirectoryCapture::IsImageFile("png"));
+  ASSERT_THROW(ImageDirectoryCapture(directory_ + "/missing", 30),
+               IOException);
+}
+
+TEST_F(ImageDirectoryCaptureTest, fastPlayback) {
+  ImageDirectoryCapture capture(directory_, 30,
+                                PlaybackMode::AS_FAST_AS_POSSIBLE, 8, 2);
+  FrameCollector collector;
+  Replay(capture, collector);
+
+  ASSERT_TRUE(capture.IsAtEnd());
+  // The streaming stops by itself at the end of the directory.
+  EXPECT_FALSE(capture.IsStreaming());
+  ASSERT_EQ(collector.indexes_.size(), kImageCount);
+  for (int i = 0; i < kImageCount; ++i) {
+    EXPECT_EQ(collector.indexes_[i], i);
+  }
+  EXPECT_EQ(collector.empty_count_, 0);
+  EXPECT_EQ(capture.GetFrameCount(), kImageCount);
+  // The images are decoded in the buffers of the pool, which the frames hold
+  // while they are in use.
+  EXPECT_EQ(collector.pooled_count_, kImageCount);
+  FramePool::Ptr pool = capture.GetFramePool();
+  ASSERT_NE(pool, nullptr);
+  EXPECT_GE(pool->HitCount(), kImageCount / 2);
+  DecodeStats stats = capture.GetDecodeStats();
+  EXPECT_EQ(stats.frame_count, kImageCount);
+  std::cout << "[ BENCH    ] decode: " << stats.throughput << " fps, "
+            << stats.stall_count << " stalls, "
+            << capture.GetDecodeLatency().Report() << std::endl;
+  std::cout << "[ BENCH    ] playback: " << capture.GetPacingStats().framerate
+            << " fps" << std::endl;
+}
+
+TEST_F(ImageDirectoryCaptureTest, realTimePlayback) {
+  const double framerate = 100;
+  ImageDirectoryCapture capture(directory_, framerate);
+  ASSERT_EQ(capture.GetPlaybackMode(), PlaybackMode::REAL_TIME);
+  ASSERT_EQ(capture.GetMaxFramerate(), framerate);
+  FrameCollector collector;
+  Replay(capture, collector);
+
+  ASSERT_EQ(collector.indexes_.size(), kImageCount);
+  EXPECT_NEAR(capture.GetPacingStats().framerate, framerate,
+              framerate * 0.05);
+  // The images were decoded long before they were needed, except maybe the
+  // first one, which is asked for right after the creation.
+  EXPECT_LE(capture.GetDecodeStats().stall_count, 1);
+}
+
+/** A capture whose prefetch was never started. */
+class IdleCapture : public FileCapture {
+ public:
+  IdleCapture() : FileCapture(30, PlaybackMode::REAL_TIME) {}
+
+  ~IdleCapture() ATLAS_NOEXCEPT { Stop(); }
+};
+
+TEST(FileCaptureTest, withoutPrefetch) {
+  IdleCapture capture;
+  EXPECT_TRUE(capture.IsAtEnd());
+  EXPECT_EQ(capture.GetDecodeStats().frame_count, 0);
+  EXPECT_EQ(capture.GetDecodeLatency().Count(), 0);
+  EXPECT_EQ(capture.GetFramePool(), nullptr);
+  EXPECT_TRUE(capture.GetImage().empty());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,211 @@
+/**
+ * \file	frame_pool_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/resource.h>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/details/deadline.h>
+#include <lib_atlas/io/frame_pool.h>
+#include <lib_atlas/sys/latency_histogram.h>
+
+using namespace atlas;
+
+namespace {
+
+// Number of page faults of the process so far, every image that is
+// allocated and written for the first time costs one per page.
+long MinorFaultCount() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_minflt;
+}
+
+TEST(FramePoolTest, reuseReleasedFrames) {
+  FramePool pool(cv::Size(64, 48), CV_8UC3, 2);
+  ASSERT_EQ(pool.Capacity(), 2);
+  ASSERT_TRUE(pool.Matches(cv::Size(64, 48), CV_8UC3));
+  ASSERT_FALSE(pool.Matches(cv::Size(64, 48), CV_8UC1));
+  ASSERT_EQ(pool.OutstandingCount(), 0);
+
+  FramePool::Frame first = pool.Acquire();
+  const uint8_t *first_data = first->data;
+  EXPECT_EQ(first->size(), cv::Size(64, 48));
+  EXPECT_EQ(first->type(), CV_8UC3);
+  FramePool::Frame second = pool.Acquire();
+  EXPECT_NE(second->data, first_data);
+  EXPECT_EQ(pool.OutstandingCount(), 2);
+
+  // The pool is empty, the frame is allocated rather than waited for.
+  FramePool::Frame third = pool.Acquire();
+  EXPECT_NE(third->data, first_data);
+  EXPECT_NE(third->data, second->data);
+  EXPECT_EQ(pool.OutstandingCount(), 2);
+  EXPECT_EQ(pool.HitCount(), 2);
+  EXPECT_EQ(pool.MissCount(), 1);
+
+  // A copy of the frame held by another consumer keeps it out of the pool.
+  FramePool::Frame copy = first;
+  first.reset();
+  third.reset();
+  EXPECT_EQ(pool.OutstandingCount(), 2);
+  copy.reset();
+  EXPECT_EQ(pool.OutstandingCount(), 1);
+  FramePool::Frame reused = pool.Acquire();
+  EXPECT_EQ(reused->data, first_data);
+  EXPECT_EQ(pool.HitCount(), 3);
+  EXPECT_EQ(pool.MissCount(), 1);
+
+  ASSERT_THROW(FramePool(cv::Size(64, 48), CV_8UC3, 0),
+               std::invalid_argument);
+}
+
+TEST(FramePoolTest, releaseFromAnotherThread) {
+  FramePool pool(cv::Size(16, 16), CV_8UC1, 4);
+  std::vector<FramePool::Frame> frames;
+  for (int i = 0; i < 4; ++i) {
+    frames.push_back(pool.Acquire());
+  }
+  std::thread consumer([&frames] { frames.clear(); });
+  consumer.join();
+  EXPECT_EQ(pool.OutstandingCount(), 0);
+  pool.Acquire();
+  EXPECT_EQ(pool.MissCount(), 0);
+}
+
+TEST(FramePoolTest, heldFramesAreNotReused) {
+  FramePool pool(cv::Size(64, 1), CV_8UC1, 2);
+  std::mutex mutex;
+  std::deque<FramePool::Frame> queue;
+  std::atomic<bool> done(false);
+  int corrupted = 0;
+  std::thread consumer([&] {
+    while (true) {
+      FramePool::Frame frame;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!queue.empty()) {
+          frame = queue.front();
+          queue.pop_front();
+        }
+      }
+      if (frame == nullptr) {
+        if (done) {
+          return;
+        }
+        std::this_thread::yield();
+        continue;
+      }
+      // The producer keeps acquiring frames while this copy is checked.
+      uint8_t value = frame->data[0];
+      std::this_thread::yield();
+      for (int i = 0; i < frame->cols; ++i) {
+        corrupted += frame->data[i] != value;
+      }
+    }
+  });
+  for (int i = 0; i < 10000; ++i) {
+    FramePool::Frame frame = pool.Acquire();
+    memset(frame->data, i & 0xFF, frame->cols);
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(std::move(frame));
+  }
+  done = true;
+  consumer.join();
+  EXPECT_EQ(corrupted, 0);
+  EXPECT_EQ(pool.OutstandingCount(), 0);
+}
+
+TEST(FramePoolTest, framesOutliveThePool) {
+  FramePool::Frame frame;
+  {
+    FramePool pool(cv::Size(16, 16), CV_8UC1, 2);
+    frame = pool.Acquire();
+  }
+  memset(frame->data, 1, frame->step * frame->rows);
+  frame.reset();
+}
+
+/**
+ * A source produces 1080p images while the last three ones are still held
+ * down the pipeline. The latency is the time to get a frame and fill it.
+ */
+void RunFrameBenchmark(const char *name, FramePool *pool) {
+  const cv::Size size(1920, 1080);
+  const size_t frame_count = 200;
+  const size_t in_flight = 3;
+
+  std::deque<FramePool::Frame> pipeline;
+  LatencyHistogram latency;
+  size_t allocations = 0;
+  long faults = MinorFaultCount();
+  for (size_t i = 0; i < frame_count; ++i) {
+    int64_t start = Deadline::Now();
+    FramePool::Frame frame;
+    if (pool != nullptr) {
+      uint64_t misses = pool->MissCount();
+      frame = pool->Acquire();
+      allocations += pool->MissCount() - misses;
+    } else {
+      frame = std::make_shared<cv::Mat>(size, CV_8UC3);
+      ++allocations;
+    }
+    memset(frame->data, static_cast<int>(i), frame->step * frame->rows);
+    latency.Record(Deadline::Now() - start);
+
+    pipeline.push_back(frame);
+    if (pipeline.size() > in_flight) {
+      pipeline.pop_front();
+    }
+  }
+  faults = MinorFaultCount() - faults;
+
+  std::cout << "[ BENCH    ] " << name << ": " << allocations
+            << " image allocations, " << faults << " page faults, p99 "
+            << latency.Percentile(99) / 1e3 << " us" << std::endl;
+  std::cout << "[ BENCH    ] " << name << ": " << latency.Report()
+            << std::endl;
+}
+
+TEST(FramePoolTest, DISABLED_poolBenchmark) {
+  RunFrameBenchmark("without pool", nullptr);
+
+  FramePool pool(cv::Size(1920, 1080), CV_8UC3, 4);
+  RunFrameBenchmark("with pool", &pool);
+  EXPECT_EQ(pool.MissCount(), 0);
+  EXPECT_EQ(pool.HitCount(), 200);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,330 @@
+/**
+ * \file	frame_reader_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/frame_reader.h>
+#include <lib_atlas/sys/timer.h>
+
+#if defined(OS_LINUX)
+#include <pty.h>
+#else
+#include <util.h>
+#endif
+
+using namespace atlas;
+
+namespace {
+
+const FrameFormat kFormats[] = {FrameFormat::COBS, FrameFormat::SLIP,
+                                FrameFormat::LENGTH_CRC16,
+                                FrameFormat::LENGTH_CRC32};
+
+std::vector<uint8_t> MakePayload(size_t size, uint8_t seed) {
+  std::vector<uint8_t> payload(size);
+  for (size_t i = 0; i < size; ++i) {
+    // Plenty of zeros and of the special bytes of each format.
+    static const uint8_t special[] = {0x00, 0xC0, 0xDB, 0xA5};
+    payload[i] = (i + seed) % 5 == 0 ? special[(i / 5) % 4]
+                                     : static_cast<uint8_t>(i * 31 + seed);
+  }
+  return payload;
+}
+
+std::string ToString(const FrameView &frame) {
+  return std::string(reinterpret_cast<const char *>(frame.data), frame.size);
+}
+
+TEST(CrcTest, checkValues) {
+  const uint8_t *check = reinterpret_cast<const uint8_t *>("123456789");
+  EXPECT_EQ(Crc16(check, 9), 0x29B1);
+  EXPECT_EQ(Crc32(check, 9), 0xCBF43926);
+
+  // The computation can be split and the slicing must match the bytewise one.
+  std::vector<uint8_t> data = MakePayload(1000, 3);
+  uint32_t crc32 = Crc32(data.data(), data.size());
+  uint16_t crc16 = Crc16(data.data(), data.size());
+  for (size_t split = 0; split < 20; ++split) {
+    EXPECT_EQ(Crc32(data.data() + split, data.size() - split,
+                    Crc32(data.data(), split)),
+              crc32);
+    EXPECT_EQ(Crc16(data.data() + split, data.size() - split,
+                    Crc16(data.data(), split)),
+              crc16);
+  }
+}
+
+TEST(FrameReaderTest, roundTripAllFormats) {
+  for (FrameFormat format : kFormats) {
+    std::vector<uint8_t> stream;
+    std::vector<std::vector<uint8_t>> payloads;
+    for (size_t size : {0, 1, 2, 253, 254, 255, 508, 1000}) {
+      if (size == 0 && format == FrameFormat::SLIP) {
+        continue;  // SLIP cannot tell an empty frame from a separator.
+      }
+      payloads.push_back(MakePayload(size, static_cast<uint8_t>(size)));
+      FrameReader::Encode(format, payloads.back().data(), size, stream);
+    }
+
+    // Feed the bytes in small pieces to cut the frames everywhere.
+    FrameReader reader(format, 1000);
+    size_t received = 0;
+    for (size_t offset = 0; offset < stream.size(); offset += 7) {
+      reader.Feed(stream.data() + offset,
+                  std::min<size_t>(7, stream.size() - offset));
+      FrameView frame;
+      while (reader.Parse(frame)) {
+        ASSERT_LT(received, payloads.size());
+        EXPECT_EQ(std::vector<uint8_t>(frame.data, frame.data + frame.size),
+                  payloads[received]);
+        ++received;
+      }
+    }
+    EXPECT_EQ(received, payloads.size());
+    EXPECT_EQ(reader.FrameCount(), payloads.size());
+    EXPECT_EQ(reader.ErrorCount(), 0);
+  }
+}
+
+TEST(FrameReaderTest, resynchronizeAfterErrors) {
+  const std::string good("good frame");
+  const uint8_t *data = reinterpret_cast<const uint8_t *>(good.data());
+  for (FrameFormat format : kFormats) {
+    std::vector<uint8_t> stream;
+    if (format == FrameFormat::LENGTH_CRC16 ||
+        format == FrameFormat::LENGTH_CRC32) {
+      // Line noise, only the length prefixed frames can tell it apart.
+      stream = {0x12, 0x34};
+    }
+    FrameReader::Encode(format, data, good.size(), stream);
+    size_t corrupted = stream.size();
+    FrameReader::Encode(format, data, good.size(), stream);
+    if (format == FrameFormat::SLIP) {
+      stream[corrupted + 3] = 0xDB;  // Invalid escape sequence.
+    } else if (format == FrameFormat::COBS) {
+      stream[corrupted] = 0xFE;  // Block longer than the frame.
+    } else {
+      stream[corrupted + 5] ^= 0x01;  // Bad CRC.
+    }
+    FrameReader::Encode(format, data, good.size(), stream);
+
+    FrameReader reader(format);
+    reader.Feed(stream.data(), stream.size());
+    FrameView frame;
+    ASSERT_TRUE(reader.Parse(frame));
+    EXPECT_EQ(ToString(frame), good);
+    ASSERT_TRUE(reader.Parse(frame));
+    EXPECT_EQ(ToString(frame), good);
+    EXPECT_FALSE(reader.Parse(frame));
+    EXPECT_EQ(reader.FrameCount(), 2);
+    EXPECT_EQ(reader.ErrorCount(), 1);
+    EXPECT_GT(reader.DiscardedBytes(), 0);
+
+    // The same stream can be reported with exceptions.
+    FrameReader throwing(format, 1024, true);
+    throwing.Feed(stream.data(), stream.size());
+    ASSERT_TRUE(throwing.Parse(frame));
+    ASSERT_THROW(throwing.Parse(frame), CorruptedDataException);
+    ASSERT_TRUE(throwing.Parse(frame));
+    EXPECT_EQ(ToString(frame), good);
+  }
+}
+
+TEST(FrameReaderTest, dropFramesTooLong) {
+  for (FrameFormat format : kFormats) {
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> big = MakePayload(5000, 1);
+    FrameReader::Encode(format, big.data(), big.size(), stream);
+    FrameReader::Encode(format, big.data(), 10, stream);
+
+    FrameReader reader(format, 100);
+    FrameView frame;
+    size_t frames = 0;
+    for (size_t offset = 0; offset < stream.size(); offset += 64) {
+      reader.Feed(stream.data() + offset,
+                  std::min<size_t>(64, stream.size() - offset));
+      while (reader.Parse(frame)) {
+        EXPECT_EQ(frame.size, 10);
+        ++frames;
+      }
+    }
+    EXPECT_EQ(frames, 1);
+    EXPECT_GE(reader.ErrorCount(), 1);
+  }
+}
+
+TEST(FrameReaderTest, frameTimestamps) {
+  for (FrameFormat format : kFormats) {
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> payload = MakePayload(40, 2);
+    for (int i = 0; i < 3; ++i) {
+      FrameReader::Encode(format, payload.data(), payload.size(), stream);
+    }
+    // Each frame is stamped with the chunk holding its first byte.
+    FrameReader reader(format);
+    size_t frame_size = stream.size() / 3;
+    FrameView frame;
+    size_t split = frame_size / 2;
+    reader.Feed(stream.data(), split, 100);
+    EXPECT_FALSE(reader.Parse(frame));
+    reader.Feed(stream.data() + split, frame_size + 1, 200);
+    ASSERT_TRUE(reader.Parse(frame));
+    EXPECT_EQ(frame.timestamp_ns, 100);
+    ASSERT_FALSE(reader.Parse(frame));
+    size_t fed = split + frame_size + 1;
+    reader.Feed(stream.data() + fed, stream.size() - fed, 300);
+    ASSERT_TRUE(reader.Parse(frame));
+    EXPECT_EQ(frame.timestamp_ns, 200);
+    ASSERT_TRUE(reader.Parse(frame));
+    EXPECT_EQ(frame.timestamp_ns, 300);
+  }
+}
+
+class FrameReaderSerialTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    char name[100];
+    ASSERT_NE(openpty(&master_fd, &slave_fd, name, NULL, NULL), -1);
+    port = new Serial(std::string(name), 115200, Timeout::SimpleTimeout(250));
+  }
+
+  virtual void TearDown() {
+    delete port;
+    close(slave_fd);
+    close(master_fd);
+  }
+
+  Serial *port;
+  int master_fd;
+  int slave_fd;
+};
+
+TEST_F(FrameReaderSerialTest, readFromPort) {
+  FrameReader reader(*port, FrameFormat::COBS);
+  FrameView frame;
+  EXPECT_FALSE(reader.Next(frame, 20));
+
+  std::vector<uint8_t> stream;
+  const std::string message("hello\0world", 11);
+  FrameReader::Encode(FrameFormat::COBS,
+                      reinterpret_cast<const uint8_t *>(message.data()),
+                      message.size(), stream);
+  ASSERT_EQ(write(master_fd, stream.data(), stream.size()),
+            static_cast<ssize_t>(stream.size()));
+  ASSERT_TRUE(reader.Next(frame, 250));
+  EXPECT_EQ(ToString(frame), message);
+  EXPECT_EQ(frame.timestamp_ns, 0);
+
+  port->SetTimestamping(true);
+  int64_t sent = Deadline::Now();
+  ASSERT_EQ(write(master_fd, stream.data(), stream.size()),
+            static_cast<ssize_t>(stream.size()));
+  ASSERT_TRUE(reader.Next(frame, 250));
+  EXPECT_EQ(ToString(frame), message);
+  EXPECT_GE(frame.timestamp_ns, sent);
+  EXPECT_LE(frame.timestamp_ns, Deadline::Now());
+
+  FrameReader feed_only(FrameFormat::COBS);
+  EXPECT_THROW(feed_only.Next(frame, 0), std::logic_error);
+}
+
+TEST(FrameReaderTest, DISABLED_crcBenchmark) {
+  std::vector<uint8_t> data = MakePayload(1 << 20, 7);
+  const int iterations = 20;
+  volatile uint32_t sink = 0;
+  NanoTimer timer;
+  timer.Start();
+  for (int i = 0; i < iterations; ++i) {
+    sink = sink + Crc32(data.data(), data.size());
+  }
+  double crc32_seconds = timer.Time<std::chrono::nanoseconds>();
+  timer.Reset();
+  for (int i = 0; i < iterations; ++i) {
+    sink = sink + Crc16(data.data(), data.size());
+  }
+  double crc16_seconds = timer.Time<std::chrono::nanoseconds>();
+  double megabytes = iterations * data.size() / 1e6;
+  std::cout << "[ BENCH    ] CRC-32 slice-by-8: " << megabytes / crc32_seconds
+            << " MB/s, CRC-16 table: " << megabytes / crc16_seconds << " MB/s"
+            << std::endl;
+}
+
+/**
+ * A thread writes encoded frames on the master side of a pty while the
+ * reader decodes them from the serial port.
+ */
+TEST_F(FrameReaderSerialTest, DISABLED_loopbackBenchmark) {
+  const size_t frame_count = 5000;
+  const size_t frame_size = 64;
+  for (FrameFormat format : kFormats) {
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> payload = MakePayload(frame_size, 9);
+    for (size_t i = 0; i < frame_count; ++i) {
+      FrameReader::Encode(format, payload.data(), payload.size(), stream);
+    }
+
+    FrameReader reader(*port, format);
+    NanoTimer timer;
+    timer.Start();
+    int fd = master_fd;
+    std::thread writer([fd, &stream] {
+      size_t written = 0;
+      while (written < stream.size()) {
+        ssize_t n = write(fd, stream.data() + written,
+                          std::min<size_t>(4096, stream.size() - written));
+        if (n <= 0) {
+          return;
+        }
+        written += static_cast<size_t>(n);
+      }
+    });
+    FrameView frame;
+    size_t received = 0;
+    while (received < frame_count && reader.Next(frame, 1000)) {
+      ASSERT_EQ(frame.size, frame_size);
+      ++received;
+    }
+    double seconds = timer.Time<std::chrono::nanoseconds>();
+    writer.join();
+
+    ASSERT_EQ(received, frame_count);
+    EXPECT_EQ(reader.ErrorCount(), 0);
+    std::cout << "[ BENCH    ] format " << static_cast<int>(format) << ": "
+              << received / seconds << " frames/s, "
+              << stream.size() / seconds / 1e6 << " MB/s" << std::endl;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,216 @@
+/**
+ * \file	frame_sampler_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/frame_sampler.h>
+#include <lib_atlas/io/image_sequence_capture.h>
+
+using namespace atlas;
+
+namespace {
+
+const int64_t kNanosecondsPerMillisecond = 1000000;
+
+class FrameSource : public Subject<ImageFrame> {
+ public:
+  FrameSource() : image_(48, 64, CV_8UC1), sequence_(0) {}
+
+  /** Notify a frame captured at the given time, with its own pyramid. */
+  void Send(int64_t capture_ns) {
+    ImageFrame frame(image_, capture_ns, sequence_++, 0);
+    frame.pyramid = std::make_shared<ImagePyramid>(image_);
+    last_pyramid_ = frame.pyramid;
+    Notify(frame);
+  }
+
+  cv::Mat image_;
+  uint64_t sequence_;
+  ImagePyramid::Ptr last_pyramid_;
+};
+
+class FrameCollector : public Observer<ImageFrame> {
+ public:
+  std::vector<ImageFrame> frames_;
+
+ protected:
+  void OnSubjectNotify(Subject<ImageFrame> &subject,
+                       const ImageFrame &frame) override {
+    frames_.push_back(frame);
+  }
+};
+
+class FakeCapture : public ImageSequenceCapture {
+ public:
+  FakeCapture() : image_(48, 64, CV_8UC1) {}
+
+  ~FakeCapture() ATLAS_NOEXCEPT { Stop(); }
+
+ protected:
+  const cv::Mat &GetNextImage() const override { return image_; }
+
+ private:
+  cv::Mat image_;
+};
+
+TEST(FrameSamplerTest, configuration) {
+  FrameSampler sampler;
+  EXPECT_EQ(sampler.GetDecimation(), 1);
+  EXPECT_EQ(sampler.GetMaxFramerate(), 0);
+  EXPECT_EQ(sampler.GetPyramidLevel(), 0);
+  EXPECT_EQ(sampler.GetRegionOfInterest().area(), 0);
+  ASSERT_THROW(sampler.SetDecimation(0), std::invalid_argument);
+  ASSERT_THROW(sampler.SetMaxFramerate(-1), std::invalid_argument);
+  ASSERT_THROW(sampler.SetPyramidLevel(FrameSampler::kMaxPyramidLevel + 1),
+               std::invalid_argument);
+  ASSERT_THROW(sampler.SetRegionOfInterest(cv::Rect(-1, 0, 4, 4)),
+               std::invalid_argument);
+}
+
+TEST(FrameSamplerTest, keepEveryNthFrame) {
+  FrameSource source;
+  FrameSampler sampler;
+  sampler.SetDecimation(3);
+  FrameCollector collector;
+  sampler.Observe(source);
+  collector.Observe(sampler);
+  for (int i = 0; i < 30; ++i) {
+    source.Send(i * 10 * kNanosecondsPerMillisecond);
+  }
+  ASSERT_EQ(collector.frames_.size(), 10);
+  for (size_t i = 0; i < collector.frames_.size(); ++i) {
+    EXPECT_EQ(collector.frames_[i].sequence, 3 * i);
+    // Without downscale nor crop, the frame is forwarded untouched.
+    EXPECT_EQ(collector.frames_[i].image.data, source.image_.data);
+  }
+  EXPECT_EQ(sampler.GetReceivedCount(), 30);
+  EXPECT_EQ(sampler.GetForwardedCount(), 10);
+}
+
+TEST(FrameSamplerTest, keepFramesOnCaptureTime) {
+  FrameSource source;
+  FrameSampler sampler;
+  // 30 fps to 10 fps, with a capture that is not exactly on time.
+  sampler.SetMaxFramerate(10);
+  FrameCollector collector;
+  sampler.Observe(source);
+  collector.Observe(sampler);
+  const int64_t start_ns = 1000 * kNanosecondsPerMillisecond;
+  for (int64_t i = 0; i < 300; ++i) {
+    int64_t jitter_ns = (i % 2 ? -1 : 1) * kNanosecondsPerMillisecond;
+    source.Send(start_ns + i * 33333333 + jitter_ns);
+  }
+  // 10 s of capture, the frames late by jitter do not make it drift.
+  EXPECT_NEAR(collector.frames_.size(), 100, 1);
+
+  // A pause does not cause a burst.
+  collector.frames_.clear();
+  const int64_t resume_ns = start_ns + 60000 * kNanosecondsPerMillisecond;
+  for (int64_t i = 0; i < 30; ++i) {
+    source.Send(resume_ns + i * 33333333);
+  }
+  EXPECT_NEAR(collector.frames_.size(), 10, 1);
+}
+
+TEST(FrameSamplerTest, downscaleAndCrop) {
+  FrameSource source;
+  FrameSampler sampler;
+  sampler.SetPyramidLevel(1);
+  sampler.SetRegionOfInterest(cv::Rect(8, 4, 15, 8));
+  FrameCollector collector;
+  sampler.Observe(source);
+  collector.Observe(sampler);
+  source.Send(0);
+
+  ASSERT_EQ(collector.frames_.size(), 1);
+  const cv::Mat &image = collector.frames_[0].image;
+  // The region is rounded outwards in the half resolution image.
+  EXPECT_EQ(image.cols, 8);
+  EXPECT_EQ(image.rows, 4);
+  cv::Mat level = source.last_pyramid_->GetLevel(1);
+  EXPECT_EQ(image.data, level.ptr(2) + 4);
+
+  // A region out of the image drops the frame.
+  sampler.SetRegionOfInterest(cv::Rect(100, 100, 10, 10));
+  source.Send(1);
+  EXPECT_EQ(collector.frames_.size(), 1);
+}
+
+/**
+ * Two consumers of the same level of a frame get the same downscale, it is
+ * computed once.
+ */
+TEST(FrameSamplerTest, shareDownscales) {
+  FrameSource source;
+  FrameSampler previews[2];
+  FrameCollector collectors[2];
+  for (int i = 0; i < 2; ++i) {
+    previews[i].SetPyramidLevel(2);
+    previews[i].Observe(source);
+    collectors[i].Observe(previews[i]);
+  }
+  FrameSampler half;
+  half.SetPyramidLevel(1);
+  half.Observe(source);
+  source.Send(0);
+
+  ASSERT_EQ(collectors[0].frames_.size(), 1);
+  ASSERT_EQ(collectors[1].frames_.size(), 1);
+  EXPECT_EQ(collectors[0].frames_[0].image.cols, 16);
+  EXPECT_EQ(collectors[0].frames_[0].image.data,
+            collectors[1].frames_[0].image.data);
+  // Level 2 is computed from level 1, which serves the third sampler.
+  EXPECT_EQ(source.last_pyramid_->ComputedLevelCount(), 2);
+}
+
+TEST(FrameSamplerTest, sampleStreamingCapture) {
+  FakeCapture capture;
+  FrameSampler sampler;
+  sampler.SetDecimation(2);
+  sampler.SetPyramidLevel(1);
+  FrameCollector collector;
+  sampler.Observe(capture);
+  collector.Observe(sampler);
+  capture.SetMaxFramerate(200);
+  capture.Start();
+  capture.SetStreamingMode(true);
+  usleep(100000);
+  capture.SetStreamingMode(false);
+  capture.Stop();
+
+  EXPECT_EQ(sampler.GetReceivedCount(), capture.GetFrameCount());
+  EXPECT_EQ(collector.frames_.size(), (capture.GetFrameCount() + 1) / 2);
+  ASSERT_FALSE(collector.frames_.empty());
+  EXPECT_EQ(collector.frames_[0].image.cols, 32);
+  EXPECT_NE(collector.frames_[0].pyramid, nullptr);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+/**
+ * \file	image_message_pool_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cv_bridge/cv_bridge.h>
+#include <deque>
+#include <iostream>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/details/deadline.h>
+#include <lib_atlas/ros/image_message_pool.h>
+#include <lib_atlas/sys/latency_histogram.h>
+
+using namespace atlas;
+
+namespace {
+
+TEST(ImageMessagePoolTest, reuseReleasedMessages) {
+  ImageMessagePool pool("bgr8", 2);
+  ASSERT_EQ(pool.GetType(), CV_8UC3);
+
+  sensor_msgs::ImagePtr first = pool.Acquire(48, 64);
+  EXPECT_EQ(first->height, 48);
+  EXPECT_EQ(first->width, 64);
+  EXPECT_EQ(first->step, 64 * 3);
+  EXPECT_EQ(first->data.size(), 48 * 64 * 3);
+  const uint8_t *first_data = first->data.data();
+
+  // The image writes in the message.
+  cv::Mat image = ImageMessagePool::ToImage(first);
+  EXPECT_EQ(image.data, first_data);
+  EXPECT_EQ(image.type(), CV_8UC3);
+
+  sensor_msgs::ImagePtr second = pool.Acquire(48, 64);
+  sensor_msgs::ImagePtr third = pool.Acquire(48, 64);
+  EXPECT_EQ(pool.HitCount(), 2);
+  EXPECT_EQ(pool.MissCount(), 1);
+
+  first.reset();
+  sensor_msgs::ImagePtr reused = pool.Acquire(48, 64);
+  EXPECT_EQ(reused->data.data(), first_data);
+
+  cv::Mat gray(48, 64, CV_8UC1);
+  ASSERT_THROW(pool.FromImage(gray), std::invalid_argument);
+  ASSERT_THROW(ImageMessagePool("bgr8", 0), std::invalid_argument);
+}
+
+/**
+ * The messages of 1080p images are built the way ImagePublisher::WriteImage
+ * used to, then from the pool, while the last two are still held by roscpp.
+ */
+TEST(ImageMessagePoolTest, DISABLED_publishRateBenchmark) {
+  const size_t message_count = 300;
+  const size_t in_flight = 2;
+  cv::Mat image(1080, 1920, CV_8UC3, cv::Scalar(1, 2, 3));
+  ImageMessagePool pool("bgr8", in_flight + 2);
+
+  for (int use_pool = 0; use_pool < 2; ++use_pool) {
+    std::deque<sensor_msgs::ImagePtr> published;
+    LatencyHistogram latency;
+    int64_t start = Deadline::Now();
+    for (size_t i = 0; i < message_count; ++i) {
+      int64_t message_start = Deadline::Now();
+      sensor_msgs::ImagePtr message =
+          use_pool ? pool.FromImage(image)
+                   : cv_bridge::CvImage(std_msgs::Header(), "bgr8", image)
+                         .toImageMsg();
+      latency.Record(Deadline::Now() - message_start);
+      published.push_back(message);
+      if (published.size() > in_flight) {
+        published.pop_front();
+      }
+    }
+    double seconds =
+        static_cast<double>(Deadline::Now() - start) / 1e9;
+    std::cout << "[ BENCH    ] " << (use_pool ? "pool" : "toImageMsg")
+              << ": " << message_count / seconds << " msg/s, "
+              << latency.Report() << std::endl;
+  }
+  EXPECT_EQ(pool.MissCount(), 0);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
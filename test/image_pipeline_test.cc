@@ -0,0 +1,199 @@
+/**
+ * \file	image_pipeline_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/image_pipeline.h>
+#include <lib_atlas/io/image_sequence_capture.h>
+#include <lib_atlas/io/image_sequence_writer.h>
+
+using namespace atlas;
+
+namespace {
+
+uint32_t GetSequence(const cv::Mat &image) {
+  uint32_t sequence;
+  memcpy(&sequence, image.data, sizeof(sequence));
+  return sequence;
+}
+
+/**
+ * Every image is a new one that carries its sequence number.
+ */
+class CountingCapture : public ImageSequenceCapture {
+ public:
+  CountingCapture() : sequence_(0), image_() {}
+
+  ~CountingCapture() ATLAS_NOEXCEPT { Stop(); }
+
+ protected:
+  const cv::Mat &GetNextImage() const override {
+    CountingCapture *self = const_cast<CountingCapture *>(this);
+    self->image_ = cv::Mat(4, 4, CV_8UC1);
+    uint32_t sequence = self->sequence_++;
+    memcpy(self->image_.data, &sequence, sizeof(sequence));
+    return image_;
+  }
+
+ private:
+  uint32_t sequence_;
+  cv::Mat image_;
+};
+
+class OrderChecker : public ImageSequenceWriter {
+ public:
+  OrderChecker()
+      : ImageSequenceWriter(64, QueuePolicy::BLOCK),
+        last_sequence_(-1),
+        out_of_order_(0) {}
+
+  ~OrderChecker() ATLAS_NOEXCEPT { Stop(); }
+
+  int64_t last_sequence_;
+  uint64_t out_of_order_;
+
+ protected:
+  void WriteFrame(const ImageFrame &frame) override {
+    int64_t sequence = GetSequence(frame.image);
+    // The frame keeps the sequence number of the captured image.
+    if (sequence <= last_sequence_ ||
+        frame.sequence != static_cast<uint64_t>(sequence)) {
+      ++out_of_order_;
+    }
+    last_sequence_ = sequence;
+  }
+};
+
+/**
+ * A stage that takes the given time and outputs a copy of its input.
+ */
+ImagePipeline::StageFunction SleepingStage(useconds_t duration_us) {
+  return [duration_us](const cv::Mat &image) {
+    usleep(duration_us);
+    return image.clone();
+  };
+}
+
+TEST(ImagePipelineTest, configuration) {
+  ImagePipeline pipeline;
+  ASSERT_THROW(pipeline.Start(), std::logic_error);
+  pipeline.AddStage("copy", SleepingStage(0));
+  ASSERT_EQ(pipeline.StageCount(), 1);
+  pipeline.Start();
+  ASSERT_TRUE(pipeline.IsRunning());
+  ASSERT_THROW(pipeline.AddStage("copy", SleepingStage(0)),
+               std::logic_error);
+  ASSERT_THROW(pipeline.GetStageStats(1), std::out_of_range);
+  pipeline.Stop();
+  ASSERT_FALSE(pipeline.IsRunning());
+  ASSERT_THROW(ImagePipeline(0), std::invalid_argument);
+}
+
+TEST(ImagePipelineTest, failingStageDropsImage) {
+  CountingCapture capture;
+  ImagePipeline pipeline(8, QueuePolicy::BLOCK);
+  pipeline.AddStage("odd", [](const cv::Mat &image) {
+    if (GetSequence(image) % 2 == 0) {
+      throw std::runtime_error("even image");
+    }
+    return image;
+  });
+  OrderChecker sink;
+  pipeline.Observe(capture);
+  sink.Observe(pipeline);
+  sink.SetStreamingMode(true);
+  sink.Start();
+  pipeline.Start();
+  capture.SetMaxFramerate(1000);
+  capture.Start();
+  capture.SetStreamingMode(true);
+  usleep(50000);
+  capture.Stop();
+  pipeline.Stop();
+  sink.Stop();
+
+  PipelineStageStats stats = pipeline.GetStageStats(0);
+  EXPECT_GT(stats.error_count, 0);
+  EXPECT_EQ(stats.frame_count + stats.error_count, capture.GetFrameCount());
+  EXPECT_EQ(sink.FrameCount(), stats.frame_count);
+}
+
+/**
+ * Three stages of 4 ms each behind a capture at 200 fps: run one after the
+ * other, they could only sustain 83 fps.
+ */
+TEST(ImagePipelineTest, pipelinedThroughput) {
+  const double framerate = 200;
+  const useconds_t stage_duration_us = 4000;
+
+  CountingCapture capture;
+  ImagePipeline pipeline(4, QueuePolicy::DROP_OLDEST);
+  pipeline.AddStage("undistort", SleepingStage(stage_duration_us));
+  pipeline.AddStage("convert", SleepingStage(stage_duration_us));
+  pipeline.AddStage("threshold", SleepingStage(stage_duration_us));
+  OrderChecker sink;
+  pipeline.Observe(capture);
+  sink.Observe(pipeline);
+  sink.SetStreamingMode(true);
+  sink.Start();
+  pipeline.Start();
+  capture.SetMaxFramerate(framerate);
+  capture.Start();
+  capture.SetStreamingMode(true);
+  usleep(1000000);
+  capture.Stop();
+  double throughput = pipeline.GetStageStats(2).throughput;
+  pipeline.Stop();
+  sink.Stop();
+
+  EXPECT_EQ(sink.out_of_order_, 0);
+  EXPECT_EQ(sink.FrameCount(), pipeline.GetStageStats(2).frame_count);
+  EXPECT_GT(throughput, 0.8 * framerate);
+  EXPECT_LT(pipeline.GetStageStats(0).drop_count,
+            capture.GetFrameCount() / 10);
+  for (size_t i = 0; i < pipeline.StageCount(); ++i) {
+    PipelineStageStats stats = pipeline.GetStageStats(i);
+    EXPECT_LE(stats.max_queue_depth, 4);
+    std::cout << "[ BENCH    ] " << stats.name << ": " << stats.throughput
+              << " fps, queue mean " << stats.mean_queue_depth << " max "
+              << stats.max_queue_depth << ", " << stats.drop_count
+              << " dropped, " << pipeline.GetStageLatency(i).Report()
+              << std::endl;
+  }
+  std::cout << "[ BENCH    ] pipeline: " << throughput
+            << " fps at the output, " << pipeline.GetLatency().Report()
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
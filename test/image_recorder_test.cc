@@ -0,0 +1,215 @@
+/**
+ * \file	image_recorder_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/details/deadline.h>
+#include <lib_atlas/io/image_log.h>
+#include <lib_atlas/io/image_recorder.h>
+#include <lib_atlas/io/image_sequence_capture.h>
+
+using namespace atlas;
+
+namespace {
+
+const char *kLogPath = "/tmp/image_recorder_test.ilog";
+
+const char *kCrashPath = "/tmp/image_recorder_test_crash.ilog";
+
+class FakeCapture : public ImageSequenceCapture {
+ public:
+  FakeCapture() : image_(1080, 1920, CV_8UC3, cv::Scalar(7)) {}
+
+  ~FakeCapture() ATLAS_NOEXCEPT { Stop(); }
+
+ protected:
+  const cv::Mat &GetNextImage() const override { return image_; }
+
+ private:
+  cv::Mat image_;
+};
+
+/** An image whose pixels depend on its index, to check what is read. */
+cv::Mat MakeImage(int index) {
+  cv::Mat image(20 + index, 30 + 3 * index, index % 2 ? CV_8UC3 : CV_8UC1);
+  for (int row = 0; row < image.rows; ++row) {
+    for (size_t col = 0; col < image.cols * image.elemSize(); ++col) {
+      image.ptr(row)[col] = static_cast<uint8_t>(index + row + col);
+    }
+  }
+  return image;
+}
+
+bool IsSameImage(const cv::Mat &a, const cv::Mat &b) {
+  if (a.rows != b.rows || a.cols != b.cols || a.type() != b.type()) {
+    return false;
+  }
+  for (int row = 0; row < a.rows; ++row) {
+    if (memcmp(a.ptr(row), b.ptr(row), a.cols * a.elemSize()) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void CopyFile(const char *from, const char *to) {
+  std::ifstream input(from, std::ios::binary);
+  std::ofstream output(to, std::ios::binary);
+  output << input.rdbuf();
+}
+
+class ImageRecorderTest : public ::testing::Test {
+ protected:
+  virtual void TearDown() {
+    unlink(kLogPath);
+    unlink(kCrashPath);
+  }
+};
+
+TEST_F(ImageRecorderTest, readFramesBack) {
+  const int frame_count = 10;
+  int64_t before_ns = Deadline::Now();
+  {
+    // A small buffer, so the frames span several writes.
+    ImageRecorder recorder(kLogPath, 4, QueuePolicy::BLOCK, 8192);
+    recorder.Start();
+    for (int i = 0; i < frame_count; ++i) {
+      recorder.Write(MakeImage(i));
+    }
+    // A region of interest is not continuous.
+    cv::Mat image = MakeImage(frame_count);
+    recorder.Write(image(cv::Rect(2, 3, 10, 5)));
+    EXPECT_EQ(recorder.GetErrorCount(), 0);
+  }
+
+  ImageLogReader reader(kLogPath);
+  ASSERT_EQ(reader.GetFrameCount(), frame_count + 1);
+  EXPECT_FALSE(reader.IsRecovered());
+  EXPECT_EQ(reader.GetHeader().alignment, 4096);
+  for (int i = frame_count - 1; i >= 0; --i) {
+    EXPECT_TRUE(IsSameImage(reader.GetImage(i), MakeImage(i)));
+    EXPECT_EQ(reader.GetEntry(i).offset % 4096, kImageLogEntrySize);
+  }
+  cv::Mat roi = MakeImage(frame_count)(cv::Rect(2, 3, 10, 5));
+  EXPECT_TRUE(IsSameImage(reader.GetImage(frame_count), roi));
+  ASSERT_THROW(reader.GetImage(frame_count + 1), std::out_of_range);
+
+  EXPECT_GE(reader.GetEntry(0).timestamp_ns, before_ns);
+  EXPECT_EQ(reader.Find(0), 0);
+  EXPECT_EQ(reader.Find(reader.GetEntry(4).timestamp_ns), 4);
+  EXPECT_EQ(reader.Find(reader.GetEntry(4).timestamp_ns + 1), 5);
+  EXPECT_EQ(reader.Find(Deadline::Now()), frame_count + 1);
+}
+
+TEST_F(ImageRecorderTest, recoverInterruptedRecording) {
+  ImageRecorder recorder(kLogPath, 4, QueuePolicy::BLOCK);
+  recorder.Start();
+  for (int i = 0; i < 5; ++i) {
+    recorder.Write(MakeImage(i));
+  }
+  recorder.Flush();
+  // What a crash leaves: the frames are on the disk, not the index.
+  CopyFile(kLogPath, kCrashPath);
+
+  ImageLogReader reader(kCrashPath);
+  EXPECT_TRUE(reader.IsRecovered());
+  ASSERT_EQ(reader.GetFrameCount(), 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(IsSameImage(reader.GetImage(i), MakeImage(i)));
+  }
+}
+
+TEST_F(ImageRecorderTest, rejectOtherFiles) {
+  ASSERT_THROW(ImageLogReader("/nonexistent/log"), IOException);
+  {
+    std::ofstream file(kLogPath);
+    file << std::string(4096, 'x');
+  }
+  ASSERT_THROW(ImageLogReader reader(kLogPath), CorruptedDataException);
+  ASSERT_THROW(ImageRecorder("/nonexistent/log"), IOException);
+}
+
+/**
+ * A camera streams 1080p images as fast as it can to the recorder, which
+ * must keep up with a bounded queue that drops the oldest images.
+ */
+TEST_F(ImageRecorderTest, DISABLED_sustainedRecordingBenchmark) {
+  for (bool direct_io : {false, true}) {
+    FakeCapture capture;
+    uint64_t byte_count = 0;
+    uint64_t frame_count = 0;
+    uint64_t drop_count = 0;
+    double seconds = 0;
+    bool is_direct_io = false;
+    {
+      ImageRecorder recorder(kLogPath, 8, QueuePolicy::DROP_OLDEST,
+                             ImageRecorder::kDefaultBufferSize,
+                             ImageRecorder::kDefaultPreallocationSize,
+                             direct_io);
+      is_direct_io = recorder.IsDirectIO();
+      recorder.Observe(capture);
+      recorder.SetStreamingMode(true);
+      recorder.Start();
+      int64_t start_ns = Deadline::Now();
+      capture.SetMaxFramerate(1000);
+      capture.Start();
+      capture.SetStreamingMode(true);
+      usleep(1000000);
+      capture.SetStreamingMode(false);
+      capture.Stop();
+      recorder.Stop();
+      recorder.Close();
+      seconds = static_cast<double>(Deadline::Now() - start_ns) /
+                Deadline::kNanosecondsPerSecond;
+      byte_count = recorder.GetByteCount();
+      frame_count = recorder.FrameCount();
+      drop_count = recorder.DropCount();
+      EXPECT_EQ(recorder.GetErrorCount(), 0);
+      EXPECT_EQ(frame_count + drop_count, capture.GetFrameCount());
+    }
+
+    ImageLogReader reader(kLogPath);
+    ASSERT_EQ(reader.GetFrameCount(), frame_count);
+    ASSERT_GT(frame_count, 0);
+    EXPECT_TRUE(IsSameImage(reader.GetImage(frame_count - 1),
+                            cv::Mat(1080, 1920, CV_8UC3, cv::Scalar(7))));
+    std::cout << "[ BENCH    ] " << (is_direct_io ? "O_DIRECT" : "buffered")
+              << ": " << byte_count / seconds / 1e6 << " MB/s, "
+              << frame_count / seconds << " fps, " << drop_count
+              << " dropped of " << frame_count + drop_count << std::endl;
+    unlink(kLogPath);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,170 @@
+/**
+ * \file	image_sequence_capture_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <ctime>
+#include <atomic>
+#include <thread>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/image_sequence_capture.h>
+#include <lib_atlas/pattern/observer.h>
+
+using namespace atlas;
+
+namespace {
+
+class FakeCapture : public ImageSequenceCapture {
+ public:
+  FakeCapture()
+      : grab_count_(0), empty_(false), image_(4, 4, CV_8UC1), empty_image_() {}
+
+  ~FakeCapture() ATLAS_NOEXCEPT { Stop(); }
+
+  std::atomic<uint64_t> grab_count_;
+
+  /** Return empty images while staying in streaming mode. */
+  std::atomic<bool> empty_;
+
+ protected:
+  const cv::Mat &GetNextImage() const override {
+    ++const_cast<FakeCapture *>(this)->grab_count_;
+    return empty_ ? empty_image_ : image_;
+  }
+
+ private:
+  cv::Mat image_;
+  cv::Mat empty_image_;
+};
+
+/** Does not call Stop() in its destructor. */
+class UnstoppedCapture : public ImageSequenceCapture {
+ protected:
+  const cv::Mat &GetNextImage() const override { return image_; }
+
+ private:
+  cv::Mat image_;
+};
+
+class FrameCounter : public Observer<ImageFrame> {
+ public:
+  FrameCounter() : count_(0) {}
+
+  std::atomic<uint64_t> count_;
+
+ protected:
+  void OnSubjectNotify(Subject<ImageFrame> &subject,
+                       const ImageFrame &frame) override {
+    ++count_;
+  }
+};
+
+TEST(ImageSequenceCaptureTest, pausedDoesNotSpin) {
+  FakeCapture capture;
+  capture.Start();
+  ASSERT_TRUE(capture.IsRunning());
+  clock_t cpu = clock();
+  usleep(100000);
+  // A spinning thread would use the whole 100 ms.
+  EXPECT_LT(static_cast<double>(clock() - cpu) / CLOCKS_PER_SEC, 0.01);
+  EXPECT_EQ(capture.grab_count_, 0);
+
+  capture.SetStreamingMode(true);
+  for (int i = 0; i < 100 && capture.grab_count_ == 0; ++i) {
+    usleep(1000);
+  }
+  capture.SetStreamingMode(false);
+  EXPECT_GT(capture.grab_count_, 0);
+  capture.Stop();
+  EXPECT_FALSE(capture.IsRunning());
+}
+
+TEST(ImageSequenceCaptureTest, emptyImagesAreNotSentNorSpun) {
+  FakeCapture capture;
+  FrameCounter counter;
+  counter.Observe(capture);
+  capture.empty_ = true;
+  capture.Start();
+  capture.SetStreamingMode(true);
+  clock_t cpu = clock();
+  usleep(300000);
+  EXPECT_LT(static_cast<double>(clock() - cpu) / CLOCKS_PER_SEC, 0.03);
+  // Tried again every kStopCheckPeriodMs without a max framerate.
+  EXPECT_GE(capture.grab_count_, 1);
+  EXPECT_LE(capture.grab_count_, 5);
+  EXPECT_EQ(counter.count_, 0);
+
+  // The streaming resumes with the first image.
+  capture.empty_ = false;
+  for (int i = 0; i < 500 && counter.count_ == 0; ++i) {
+    usleep(1000);
+  }
+  EXPECT_GT(counter.count_, 0);
+  capture.Stop();
+}
+
+TEST(ImageSequenceCaptureTest, destroyedWithoutStop) {
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_DEATH(
+      {
+        UnstoppedCapture capture;
+        capture.Start();
+      },
+      "call Stop\\(\\) in the destructor");
+  // Stopped by the derived class, or never started, is fine.
+  { UnstoppedCapture capture; }
+}
+
+TEST(ImageSequenceCaptureTest, maxFramerate) {
+  const double framerate = 200;
+  FakeCapture capture;
+  FrameCounter counter;
+  counter.Observe(capture);
+  capture.SetMaxFramerate(framerate);
+  capture.Start();
+  capture.SetStreamingMode(true);
+  usleep(500000);
+  capture.SetStreamingMode(false);
+  capture.Stop();
+
+  FramePacingStats stats = capture.GetPacingStats();
+  EXPECT_EQ(stats.frame_count, counter.count_);
+  EXPECT_EQ(stats.frame_count, capture.GetFrameCount());
+  EXPECT_NEAR(stats.framerate, framerate, framerate * 0.05);
+  EXPECT_NEAR(static_cast<double>(stats.frame_count), framerate / 2, 10);
+  std::cout << "[ BENCH    ] " << stats.framerate << " fps, jitter "
+            << stats.jitter_ns / 1e3 << " us, " << stats.overrun_count
+            << " overruns" << std::endl;
+
+  capture.ResetPacingStats();
+  EXPECT_EQ(capture.GetPacingStats().frame_count, 0);
+  ASSERT_THROW(capture.SetMaxFramerate(-1), std::invalid_argument);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
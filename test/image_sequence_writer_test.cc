@@ -0,0 +1,286 @@
+/**
+ * \file	image_sequence_writer_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/details/deadline.h>
+#include <lib_atlas/io/image_sequence_capture.h>
+#include <lib_atlas/io/image_sequence_writer.h>
+
+using namespace atlas;
+
+namespace {
+
+class FakeCapture : public ImageSequenceCapture {
+ public:
+  FakeCapture() : image_(4, 4, CV_8UC1) {}
+
+  ~FakeCapture() ATLAS_NOEXCEPT { Stop(); }
+
+ protected:
+  const cv::Mat &GetNextImage() const override { return image_; }
+
+ private:
+  cv::Mat image_;
+};
+
+/** Writes each image in the buffer of the previous one. */
+class ReusingCapture : public ImageSequenceCapture {
+ public:
+  ReusingCapture() : image_(4, 4, CV_8UC1), count_(0) {}
+
+  ~ReusingCapture() ATLAS_NOEXCEPT { Stop(); }
+
+ protected:
+  const cv::Mat &GetNextImage() const override {
+    image_.setTo(cv::Scalar(count_++ % 256));
+    return image_;
+  }
+
+ private:
+  mutable cv::Mat image_;
+  mutable int count_;
+};
+
+class SleepingWriter : public ImageSequenceWriter {
+ public:
+  SleepingWriter(useconds_t write_duration_us, size_t queue_capacity,
+                 QueuePolicy policy)
+      : ImageSequenceWriter(queue_capacity, policy),
+        max_depth_(0),
+        write_duration_us_(write_duration_us) {}
+
+  ~SleepingWriter() ATLAS_NOEXCEPT { Stop(); }
+
+  std::atomic<size_t> max_depth_;
+
+  /** Only read once the writer is stopped. */
+  std::vector<ImageFrame> frames_;
+
+ protected:
+  void WriteFrame(const ImageFrame &frame) override {
+    max_depth_ = std::max<size_t>(max_depth_, QueueDepth());
+    frames_.push_back(frame);
+    usleep(write_duration_us_);
+  }
+
+ private:
+  useconds_t write_duration_us_;
+};
+
+TEST(ImageSequenceWriterTest, writeOutsideOfStreaming) {
+  SleepingWriter writer(0, 1, QueuePolicy::BLOCK);
+  cv::Mat image(4, 4, CV_8UC1);
+  ASSERT_THROW(writer.Write(image), std::logic_error);
+  writer.Start();
+  writer.Write(image);
+  EXPECT_EQ(writer.FrameCount(), 1);
+  writer.SetStreamingMode(true);
+  ASSERT_THROW(writer.Write(image), std::logic_error);
+}
+
+/**
+ * A writer ten times slower than the camera is attached next to a fast one,
+ * neither the capture nor the fast writer must notice.
+ */
+TEST(ImageSequenceWriterTest, slowWriterDoesNotStallCapture) {
+  const double framerate = 200;
+  FakeCapture capture;
+  SleepingWriter fast(100, 4, QueuePolicy::DROP_OLDEST);
+  SleepingWriter slow(50000, 4, QueuePolicy::DROP_OLDEST);
+  SleepingWriter latest(50000, 4, QueuePolicy::KEEP_LATEST);
+  for (SleepingWriter *writer : {&fast, &slow, &latest}) {
+    writer->Observe(capture);
+    writer->SetStreamingMode(true);
+    writer->Start();
+  }
+  capture.SetMaxFramerate(framerate);
+  capture.Start();
+  capture.SetStreamingMode(true);
+  usleep(500000);
+  capture.SetStreamingMode(false);
+  capture.Stop();
+  for (SleepingWriter *writer : {&fast, &slow, &latest}) {
+    writer->Stop();
+  }
+
+  FramePacingStats stats = capture.GetPacingStats();
+  EXPECT_NEAR(stats.framerate, framerate, framerate * 0.05);
+  EXPECT_EQ(fast.FrameCount() + fast.DropCount(), stats.frame_count);
+  EXPECT_EQ(fast.DropCount(), 0);
+  EXPECT_EQ(slow.FrameCount() + slow.DropCount(), stats.frame_count);
+  EXPECT_GT(slow.DropCount(), 0);
+  EXPECT_LE(slow.max_depth_, slow.QueueCapacity());
+  // At most one image waits, so it is never older than one write.
+  EXPECT_LE(latest.max_depth_, 1);
+  EXPECT_LT(latest.GetLatency().Percentile(50),
+            slow.GetLatency().Percentile(50));
+
+  std::cout << "[ BENCH    ] capture: " << stats.framerate << " fps"
+            << std::endl;
+  std::cout << "[ BENCH    ] fast writer: " << fast.GetLatency().Report()
+            << std::endl;
+  std::cout << "[ BENCH    ] slow writer: " << slow.DropCount()
+            << " dropped, " << slow.GetLatency().Report() << std::endl;
+  std::cout << "[ BENCH    ] keep latest writer: " << latest.DropCount()
+            << " dropped, " << latest.GetLatency().Report() << std::endl;
+}
+
+TEST(ImageSequenceWriterTest, framesCarryCaptureMetadata) {
+  FakeCapture capture;
+  capture.SetSourceId(7);
+  SleepingWriter writer(2000, 64, QueuePolicy::BLOCK);
+  writer.Observe(capture);
+  writer.SetStreamingMode(true);
+  writer.Start();
+  capture.SetMaxFramerate(200);
+  int64_t start_ns = Deadline::Now();
+  capture.Start();
+  capture.SetStreamingMode(true);
+  usleep(100000);
+  capture.SetStreamingMode(false);
+  capture.Stop();
+  writer.Stop();
+
+  ASSERT_EQ(writer.frames_.size(), capture.GetFrameCount());
+  int64_t last_capture_ns = start_ns;
+  for (size_t i = 0; i < writer.frames_.size(); ++i) {
+    const ImageFrame &frame = writer.frames_[i];
+    EXPECT_EQ(frame.sequence, i);
+    EXPECT_EQ(frame.source_id, 7);
+    EXPECT_GE(frame.capture_ns, last_capture_ns);
+    last_capture_ns = frame.capture_ns;
+  }
+  // The latency counts from the capture, so it includes the write.
+  EXPECT_EQ(writer.GetLatency().Count(), writer.frames_.size());
+  EXPECT_GE(writer.GetLatency().Percentile(50), 2000000);
+  std::cout << "[ BENCH    ] capture to write: "
+            << writer.GetLatency().Report() << std::endl;
+
+  // A frame given to Write() is accounted for from its own capture time.
+  writer.SetStreamingMode(false);
+  writer.ResetLatency();
+  writer.Start();
+  cv::Mat image(4, 4, CV_8UC1);
+  writer.Write(ImageFrame(image, Deadline::Now() - 50000000, 3, 1));
+  EXPECT_GE(writer.GetLatency().Min(), 50000000);
+  EXPECT_EQ(writer.frames_.back().sequence, 3);
+}
+
+TEST(ImageSequenceWriterTest, stopWritesQueuedImages) {
+  FakeCapture capture;
+  SleepingWriter writer(10000, 8, QueuePolicy::BLOCK);
+  writer.Observe(capture);
+  writer.SetStreamingMode(true);
+  writer.Start();
+  capture.SetMaxFramerate(1000);
+  capture.Start();
+  capture.SetStreamingMode(true);
+  usleep(100000);
+  capture.SetStreamingMode(false);
+  capture.Stop();
+  writer.Stop();
+
+  // The capture waited for the writer rather than dropping images.
+  EXPECT_EQ(writer.DropCount(), 0);
+  EXPECT_EQ(writer.FrameCount(), capture.GetFrameCount());
+  EXPECT_EQ(writer.QueueDepth(), 0);
+}
+
+TEST(ImageSequenceWriterTest, queuedImagesAreNotOverwritten) {
+  ReusingCapture capture;
+  SleepingWriter writer(2000, 64, QueuePolicy::BLOCK);
+  writer.Observe(capture);
+  writer.SetStreamingMode(true);
+  writer.Start();
+  capture.SetMaxFramerate(1000);
+  capture.Start();
+  capture.SetStreamingMode(true);
+  usleep(100000);
+  capture.SetStreamingMode(false);
+  capture.Stop();
+  writer.Stop();
+
+  // The capture wrote the next images while these ones were queued.
+  ASSERT_GT(writer.frames_.size(), 1);
+  for (size_t i = 0; i < writer.frames_.size(); ++i) {
+    const ImageFrame &frame = writer.frames_[i];
+    EXPECT_EQ(frame.image.at<uchar>(0, 0), frame.sequence % 256);
+  }
+}
+
+class ThrowingWriter : public ImageSequenceWriter {
+ public:
+  ThrowingWriter() : ImageSequenceWriter(8, QueuePolicy::BLOCK) {}
+
+  ~ThrowingWriter() ATLAS_NOEXCEPT { Stop(); }
+
+ protected:
+  void WriteFrame(const ImageFrame &frame) override {
+    if (frame.sequence % 2 == 0) {
+      throw std::runtime_error("Disk full.");
+    }
+  }
+};
+
+TEST(ImageSequenceWriterTest, writeFailuresAreCounted) {
+  FakeCapture capture;
+  ThrowingWriter writer;
+  writer.Observe(capture);
+  writer.SetStreamingMode(true);
+  writer.Start();
+  capture.SetMaxFramerate(1000);
+  capture.Start();
+  capture.SetStreamingMode(true);
+  usleep(50000);
+  capture.SetStreamingMode(false);
+  capture.Stop();
+  writer.Stop();
+
+  // The worker kept writing after the failures.
+  uint64_t count = capture.GetFrameCount();
+  ASSERT_GT(count, 1);
+  EXPECT_EQ(writer.FailureCount(), (count + 1) / 2);
+  EXPECT_EQ(writer.FrameCount(), count / 2);
+  EXPECT_EQ(writer.GetLastFailure(), "Disk full.");
+
+  // Write() is not on the worker, the caller gets the exception.
+  writer.SetStreamingMode(false);
+  writer.Start();
+  EXPECT_THROW(writer.Write(ImageFrame(cv::Mat(4, 4, CV_8UC1), 0, 0, 0)),
+               std::runtime_error);
+  EXPECT_EQ(writer.FailureCount(), (count + 1) / 2);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
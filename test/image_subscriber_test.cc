@@ -0,0 +1,158 @@
+/**
+ * \file	image_subscriber_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/ros/image_subscriber.h>
+
+using namespace atlas;
+
+namespace {
+
+sensor_msgs::ImagePtr MakeMessage(int rows, int cols, uint8_t value) {
+  sensor_msgs::ImagePtr msg = boost::make_shared<sensor_msgs::Image>();
+  msg->height = rows;
+  msg->width = cols;
+  msg->encoding = "bgr8";
+  msg->step = cols * 3;
+  msg->data.assign(msg->step * rows, value);
+  return msg;
+}
+
+TEST(ImageSubscriberTest, shareKeepsTheMessage) {
+  sensor_msgs::ImagePtr msg = MakeMessage(48, 64, 7);
+  const uint8_t *data = msg->data.data();
+  ImageSubscriber::Image image = ImageSubscriber::ShareImage(msg, "bgr8");
+  EXPECT_EQ(image->data, data);
+  msg.reset();
+  // The image holds the last reference on the message.
+  EXPECT_EQ(image->at<uint8_t>(47, 64 * 3 - 1), 7);
+}
+
+TEST(ImageSubscriberTest, copyInThePool) {
+  FramePool::Ptr pool;
+  sensor_msgs::ImagePtr msg = MakeMessage(48, 64, 7);
+  ImageSubscriber::Image first = ImageSubscriber::CopyImage(msg, "bgr8", pool);
+  ASSERT_NE(pool, nullptr);
+  EXPECT_NE(first->data, msg->data.data());
+  EXPECT_EQ(first->at<uint8_t>(47, 64 * 3 - 1), 7);
+  first.reset();
+  for (size_t i = 0; i < 2 * pool->Capacity(); ++i) {
+    ImageSubscriber::CopyImage(msg, "bgr8", pool);
+  }
+  EXPECT_EQ(pool->MissCount(), 0);
+
+  FramePool::Ptr previous = pool;
+  ImageSubscriber::CopyImage(MakeMessage(24, 32, 1), "bgr8", pool);
+  EXPECT_NE(pool, previous);
+}
+
+/**
+ * A callback receives 1080p images as fast as it can while a reader keeps
+ * taking the latest one. The reader checks that every image it sees is
+ * uniform, a torn image would mix two messages.
+ */
+void RunCallbackBenchmark(const char *name, bool copy_to_pool) {
+  const size_t message_count = 300;
+  const int rows = 1080;
+  const int cols = 1920;
+  std::vector<sensor_msgs::ImagePtr> messages;
+  for (uint8_t i = 0; i < 8; ++i) {
+    messages.push_back(MakeMessage(rows, cols, i));
+  }
+
+  ImageSubscriber::Image latest;
+  std::atomic<bool> done(false);
+  std::atomic<size_t> torn_count(0);
+  std::atomic<size_t> read_count(0);
+  std::thread reader([&] {
+    while (!done) {
+      ImageSubscriber::Image image = std::atomic_load(&latest);
+      if (image != nullptr) {
+        if (image->at<uint8_t>(0, 0) !=
+            image->at<uint8_t>(rows - 1, cols * 3 - 1)) {
+          ++torn_count;
+        }
+        ++read_count;
+      }
+      std::this_thread::yield();
+    }
+  });
+
+  FramePool::Ptr pool;
+  LatencyHistogram latency;
+  for (size_t i = 0; i < message_count; ++i) {
+    const sensor_msgs::ImagePtr &msg = messages[i % messages.size()];
+    int64_t start = Deadline::Now();
+    ImageSubscriber::Image image =
+        copy_to_pool ? ImageSubscriber::CopyImage(msg, "bgr8", pool)
+                     : ImageSubscriber::ShareImage(msg, "bgr8");
+    std::atomic_store(&latest, image);
+    latency.Record(Deadline::Now() - start);
+  }
+  while (read_count == 0) {
+    std::this_thread::yield();
+  }
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(torn_count, 0);
+  EXPECT_GT(read_count, 0);
+  // The callback writes every byte of the image once when it copies.
+  double bytes = copy_to_pool ? static_cast<double>(rows) * cols * 3 : 0;
+  std::cout << "[ BENCH    ] " << name << ": " << bytes / 1e6
+            << " MB written per frame at "
+            << bytes / latency.Percentile(50) << " GB/s" << std::endl;
+  std::cout << "[ BENCH    ] " << name << ": callback " << latency.Report()
+            << std::endl;
+}
+
+TEST(ImageSubscriberTest, DISABLED_callbackBenchmark) {
+  // The previous callback, for reference.
+  sensor_msgs::ImagePtr msg = MakeMessage(1080, 1920, 1);
+  LatencyHistogram latency;
+  cv::Mat image;
+  for (size_t i = 0; i < 100; ++i) {
+    int64_t start = Deadline::Now();
+    image = cv_bridge::toCvCopy(msg, "bgr8")->image;
+    latency.Record(Deadline::Now() - start);
+  }
+  std::cout << "[ BENCH    ] toCvCopy: callback " << latency.Report()
+            << std::endl;
+
+  RunCallbackBenchmark("copy", true);
+  RunCallbackBenchmark("share", false);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+/**
+ * \file	latency_histogram_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/sys/latency_histogram.h>
+
+using namespace atlas;
+
+namespace {
+
+TEST(LatencyHistogramTest, statistics) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Count(), 0);
+  EXPECT_EQ(histogram.Percentile(50), 0);
+  EXPECT_EQ(histogram.Min(), 0);
+
+  // 1 us to 1 ms, uniformly.
+  for (int64_t i = 1; i <= 1000; ++i) {
+    histogram.Record(i * 1000);
+  }
+  EXPECT_EQ(histogram.Count(), 1000);
+  EXPECT_EQ(histogram.Min(), 1000);
+  EXPECT_EQ(histogram.Max(), 1000000);
+  EXPECT_DOUBLE_EQ(histogram.Mean(), 500500.0);
+  // The buckets are within 1/16 of the value.
+  EXPECT_NEAR(histogram.Percentile(50), 500000, 500000 / 16);
+  EXPECT_NEAR(histogram.Percentile(99), 990000, 990000 / 16);
+  EXPECT_EQ(histogram.Percentile(100), 1000000);
+  EXPECT_EQ(histogram.Percentile(0), 1000);
+  std::cout << "[ REPORT   ] " << histogram.Report() << std::endl;
+
+  // The small values are exact and the negative ones are clamped.
+  histogram.Reset();
+  histogram.Record(-5);
+  histogram.Record(3);
+  histogram.Record(7);
+  EXPECT_EQ(histogram.Count(), 3);
+  EXPECT_EQ(histogram.Min(), 0);
+  EXPECT_EQ(histogram.Percentile(50), 3);
+  EXPECT_EQ(histogram.Max(), 7);
+}
+
+TEST(LatencyHistogramTest, concurrentRecords) {
+  const int thread_count = 4;
+  const int value_count = 100000;
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&histogram, t] {
+      for (int i = 0; i < value_count; ++i) {
+        histogram.Record(t * value_count + i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(histogram.Count(), thread_count * value_count);
+  EXPECT_EQ(histogram.Min(), 0);
+  EXPECT_EQ(histogram.Max(), thread_count * value_count - 1);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+/**
+ * \file	lock_free_queue_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/pattern/lock_free_queue.h>
+
+using namespace atlas;
+
+namespace {
+
+TEST(LockFreeQueueTest, fifoOrder) {
+  LockFreeQueue<int> queue(3);
+  ASSERT_EQ(queue.Capacity(), 4);
+  ASSERT_TRUE(queue.IsEmpty());
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.TryPush(std::move(i)));
+  }
+  int element = 42;
+  ASSERT_FALSE(queue.TryPush(std::move(element)));
+  ASSERT_EQ(queue.Size(), 4);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.TryPop(element));
+    EXPECT_EQ(element, i);
+  }
+  ASSERT_FALSE(queue.TryPop(element));
+  ASSERT_THROW(LockFreeQueue<int>(0), std::invalid_argument);
+}
+
+TEST(LockFreeQueueTest, multipleProducersAndConsumers) {
+  const int thread_count = 4;
+  const int element_count = 100000;
+  LockFreeQueue<int> queue(64);
+  std::atomic<long long> sum(0);
+  std::atomic<int> popped(0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([&queue, t] {
+      for (int i = t; i < element_count; i += thread_count) {
+        int element = i;
+        while (!queue.TryPush(std::move(element))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    threads.emplace_back([&] {
+      int element;
+      while (popped < element_count) {
+        if (queue.TryPop(element)) {
+          sum += element;
+          ++popped;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(popped, element_count);
+  long long expected = static_cast<long long>(element_count) *
+                       (element_count - 1) / 2;
+  EXPECT_EQ(sum, expected);
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,7 +23,13 @@
  * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
 #include "gtest/gtest.h"
+#include <lib_atlas/io/details/deadline.h>
 #include <lib_atlas/pattern/observer.h>
 #include <lib_atlas/pattern/subject.h>
 
@@ -46,6 +52,50 @@ class ConcreteSubject : public atlas::Subject<const std::string &, int> {
   void DoSomething(std::string s, int i) { Notify(s, i); }
 };
 
+static_assert(std::is_same<atlas::NotificationParam<int>, int>::value,
+              "Scalars are passed by value");
+static_assert(std::is_same<atlas::NotificationParam<const char *>,
+                           const char *>::value,
+              "Pointers are passed by value");
+static_assert(std::is_same<atlas::NotificationParam<std::string>,
+                           const std::string &>::value,
+              "Classes are passed by const reference");
+static_assert(std::is_same<atlas::NotificationParam<std::string &>,
+                           std::string &>::value,
+              "References are passed as declared");
+
+/** Counts its copies, to check that a notification does not copy it. */
+struct Payload {
+  static int copy_count;
+
+  explicit Payload(size_t size) : data(size, 0) {}
+  Payload(const Payload &other) : data(other.data) { ++copy_count; }
+
+  std::vector<uint8_t> data;
+};
+
+int Payload::copy_count = 0;
+
+class PayloadObserver : public atlas::Observer<Payload> {
+ public:
+  explicit PayloadObserver(bool keep) : keep_(keep), sum_(0), kept_() {}
+
+  bool keep_;
+  size_t sum_;
+  std::vector<Payload> kept_;
+
+ protected:
+  void OnSubjectNotify(atlas::Subject<Payload> &subject,
+                       const Payload &payload) override {
+    sum_ += payload.data.size();
+    // The observers that need the payload later pay for their copy.
+    if (keep_) {
+      kept_.clear();
+      kept_.push_back(payload);
+    }
+  }
+};
+
 TEST(Observer, attachToSubject) {
   ConcreteSubject subject = {};
   ConcreateObserver observer = {};
@@ -107,6 +157,52 @@ TEST(Observer, notify) {
   ASSERT_TRUE(observer.i_ == 42);
 }
 
+TEST(Observer, notifyDoesNotCopy) {
+  atlas::Subject<Payload> subject;
+  PayloadObserver first(false), second(false), keeper(true);
+  first.Observe(subject);
+  second.Observe(subject);
+
+  Payload payload(1024);
+  Payload::copy_count = 0;
+  subject.Notify(payload);
+  EXPECT_EQ(Payload::copy_count, 0);
+  EXPECT_EQ(first.sum_, 1024);
+  EXPECT_EQ(second.sum_, 1024);
+
+  keeper.Observe(subject);
+  subject.Notify(payload);
+  EXPECT_EQ(Payload::copy_count, 1);
+}
+
+/**
+ * Notifies a 4 MiB payload to 4 observers, when they only read it and when
+ * they each copy it, as they did when the arguments were passed by value.
+ */
+TEST(Observer, DISABLED_largePayloadBenchmark) {
+  const int iterations = 50;
+  for (bool keep : {false, true}) {
+    atlas::Subject<Payload> subject;
+    std::vector<std::unique_ptr<PayloadObserver>> observers;
+    for (int i = 0; i < 4; ++i) {
+      observers.emplace_back(new PayloadObserver(keep));
+      observers.back()->Observe(subject);
+    }
+    Payload payload(4 << 20);
+    Payload::copy_count = 0;
+    int64_t start_ns = atlas::Deadline::Now();
+    for (int i = 0; i < iterations; ++i) {
+      subject.Notify(payload);
+    }
+    int64_t elapsed_ns = atlas::Deadline::Now() - start_ns;
+    std::cout << "[ BENCH    ] " << (keep ? "copying" : "reading")
+              << " observers: "
+              << static_cast<double>(elapsed_ns) / iterations / 1000
+              << " us/notify, " << Payload::copy_count / iterations
+              << " copies/notify" << std::endl;
+  }
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,302 @@
+/**
+ * \file	rcu_subject_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/details/deadline.h>
+#include <lib_atlas/pattern/rcu_subject.h>
+#include <lib_atlas/sys/latency_histogram.h>
+
+using namespace atlas;
+
+namespace {
+
+class CountingObserver : public Observer<int> {
+ public:
+  CountingObserver() : count_(0), sum_(0), inside_(false), sleep_us_(0) {}
+
+  std::atomic<uint64_t> count_;
+  std::atomic<int64_t> sum_;
+  std::atomic<bool> inside_;
+  useconds_t sleep_us_;
+
+ protected:
+  void OnSubjectNotify(Subject<int> &subject, int value) override {
+    inside_ = true;
+    if (sleep_us_ != 0) {
+      usleep(sleep_us_);
+    }
+    sum_ += value;
+    ++count_;
+    inside_ = false;
+  }
+};
+
+/** Detaches itself from the subject the first time it is notified. */
+class SelfDetachingObserver : public Observer<int> {
+ public:
+  SelfDetachingObserver() : count_(0) {}
+
+  int count_;
+
+ protected:
+  void OnSubjectNotify(Subject<int> &subject, int value) override {
+    ++count_;
+    subject.Detach(*this);
+  }
+};
+
+TEST(RcuSubjectTest, attachAndDetach) {
+  RcuSubject<int> subject;
+  CountingObserver first, second;
+  first.Observe(subject);
+  subject.Attach(second);
+  ASSERT_EQ(subject.ObserverCount(), 2);
+  ASSERT_TRUE(first.IsAttached(subject));
+  ASSERT_THROW(subject.Attach(first), std::invalid_argument);
+
+  subject.Notify(3);
+  EXPECT_EQ(first.sum_, 3);
+  EXPECT_EQ(second.sum_, 3);
+
+  subject.Detach(first);
+  ASSERT_EQ(subject.ObserverCount(), 1);
+  ASSERT_FALSE(first.IsAttached(subject));
+  ASSERT_THROW(subject.Detach(first), std::invalid_argument);
+  subject.Notify(4);
+  EXPECT_EQ(first.sum_, 3);
+  EXPECT_EQ(second.sum_, 7);
+
+  subject.DetachAll();
+  ASSERT_EQ(subject.ObserverCount(), 0);
+  ASSERT_FALSE(second.IsAttached(subject));
+
+  // The observer detaches itself when it is destroyed.
+  {
+    CountingObserver transient;
+    transient.Observe(subject);
+    ASSERT_EQ(subject.ObserverCount(), 1);
+  }
+  ASSERT_EQ(subject.ObserverCount(), 0);
+}
+
+TEST(RcuSubjectTest, observerDetachesItself) {
+  RcuSubject<int> subject;
+  SelfDetachingObserver observer;
+  CountingObserver other;
+  observer.Observe(subject);
+  other.Observe(subject);
+  subject.Notify(1);
+  subject.Notify(2);
+  EXPECT_EQ(observer.count_, 1);
+  EXPECT_EQ(other.count_, 2);
+  EXPECT_EQ(subject.ObserverCount(), 1);
+}
+
+TEST(RcuSubjectTest, slowObserverDoesNotBlockAttach) {
+  RcuSubject<int> subject;
+  CountingObserver slow;
+  slow.sleep_us_ = 200000;
+  slow.Observe(subject);
+  std::thread notifier([&subject] { subject.Notify(1); });
+  while (!slow.inside_) {
+    std::this_thread::yield();
+  }
+
+  int64_t start_ns = Deadline::Now();
+  CountingObserver other;
+  other.Observe(subject);
+  int64_t elapsed_ns = Deadline::Now() - start_ns;
+  EXPECT_TRUE(slow.inside_);
+  EXPECT_LT(elapsed_ns, 50 * 1000000LL);
+
+  // Detaching waits for the notification that may still call it.
+  subject.Detach(slow);
+  EXPECT_FALSE(slow.inside_);
+  notifier.join();
+}
+
+TEST(RcuSubjectTest, detachWaitsForNotifications) {
+  RcuSubject<int> subject;
+  std::unique_ptr<CountingObserver> observer(new CountingObserver);
+  observer->sleep_us_ = 1000;
+  observer->Observe(subject);
+  std::atomic<bool> stop(false);
+  std::thread notifier([&] {
+    while (!stop) {
+      subject.Notify(1);
+    }
+  });
+  while (observer->count_ < 10) {
+    std::this_thread::yield();
+  }
+  // The observer must not be called once it is destroyed.
+  observer.reset();
+  EXPECT_EQ(subject.ObserverCount(), 0);
+  stop = true;
+  notifier.join();
+}
+
+/**
+ * Detaches itself the first time it is notified, once the given number of
+ * observers are in their notification.
+ */
+class RendezvousObserver : public Observer<int> {
+ public:
+  RendezvousObserver(std::atomic<int> &arrived, int expected)
+      : arrived_(arrived), expected_(expected), notified_(false) {}
+
+ protected:
+  void OnSubjectNotify(Subject<int> &subject, int value) override {
+    if (notified_.exchange(true)) {
+      return;
+    }
+    ++arrived_;
+    while (arrived_ < expected_) {
+      std::this_thread::yield();
+    }
+    subject.Detach(*this);
+  }
+
+ private:
+  std::atomic<int> &arrived_;
+  const int expected_;
+  std::atomic<bool> notified_;
+};
+
+TEST(RcuSubjectTest, observersDetachThemselvesFromTwoThreads) {
+  // Leaked if the threads are deadlocked, they still use it.
+  struct Shared {
+    Shared() : arrived(0), first(arrived, 2), second(arrived, 2), done(0) {}
+    std::atomic<int> arrived;
+    RcuSubject<int> subject;
+    RendezvousObserver first, second;
+    std::atomic<int> done;
+  };
+  std::unique_ptr<Shared> shared(new Shared);
+  shared->first.Observe(shared->subject);
+  shared->second.Observe(shared->subject);
+
+  // Each thread detaches an observer while the other one is notifying.
+  std::vector<std::thread> notifiers;
+  for (int i = 0; i < 2; ++i) {
+    Shared *state = shared.get();
+    notifiers.emplace_back([state] {
+      state->subject.Notify(1);
+      ++state->done;
+    });
+  }
+  int64_t deadline_ns = Deadline::Now() + 5000 * 1000000LL;
+  while (shared->done < 2 && Deadline::Now() < deadline_ns) {
+    usleep(1000);
+  }
+  if (shared->done < 2) {
+    for (std::thread &notifier : notifiers) {
+      notifier.detach();
+    }
+    shared.release();
+    FAIL() << "The notifications are deadlocked.";
+  }
+  for (std::thread &notifier : notifiers) {
+    notifier.join();
+  }
+  EXPECT_EQ(shared->subject.ObserverCount(), 0);
+}
+
+/**
+ * Several threads notify the observers of the same subject, with one of
+ * them taking 1 ms. Another thread attaches and detaches an observer
+ * meanwhile.
+ */
+template <typename Subject_>
+void RunContentionBenchmark(const char *name) {
+  const size_t notifier_count = 4;
+  const size_t observer_count = 8;
+  const int64_t duration_ns = 300 * 1000000LL;
+
+  Subject_ subject;
+  std::vector<std::unique_ptr<CountingObserver>> observers;
+  for (size_t i = 0; i < observer_count; ++i) {
+    observers.emplace_back(new CountingObserver);
+    observers.back()->Observe(subject);
+  }
+  observers.front()->sleep_us_ = 1000;
+
+  std::atomic<bool> stop(false);
+  std::atomic<uint64_t> notify_count(0);
+  std::vector<std::thread> notifiers;
+  for (size_t i = 0; i < notifier_count; ++i) {
+    notifiers.emplace_back([&] {
+      while (!stop) {
+        subject.Notify(1);
+        ++notify_count;
+      }
+    });
+  }
+  LatencyHistogram attach_latency;
+  int64_t start_ns = Deadline::Now();
+  while (Deadline::Now() - start_ns < duration_ns) {
+    CountingObserver churn;
+    int64_t attach_ns = Deadline::Now();
+    subject.Attach(churn);
+    attach_latency.Record(Deadline::Now() - attach_ns);
+    usleep(1000);
+    subject.Detach(churn);
+  }
+  stop = true;
+  for (std::thread &notifier : notifiers) {
+    notifier.join();
+  }
+  double seconds = static_cast<double>(Deadline::Now() - start_ns) /
+                   Deadline::kNanosecondsPerSecond;
+
+  for (size_t i = 1; i < observer_count; ++i) {
+    EXPECT_EQ(observers[i]->count_, notify_count);
+  }
+  std::cout << "[ BENCH    ] " << name << ", " << notifier_count
+            << " notifiers, " << observer_count
+            << " observers: " << notify_count / seconds
+            << " notifications/s" << std::endl;
+  std::cout << "[ BENCH    ] " << name
+            << " attach: " << attach_latency.Report() << std::endl;
+}
+
+TEST(RcuSubjectTest, DISABLED_contentionBenchmark) {
+  RunContentionBenchmark<Subject<int>>("Subject");
+  RunContentionBenchmark<RcuSubject<int>>("RcuSubject");
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,262 @@
+/**
+ * \file	serial_reactor_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/serial_reactor.h>
+#include <lib_atlas/pattern/observer.h>
+#include <lib_atlas/sys/timer.h>
+
+#if defined(OS_LINUX)
+#include <pty.h>
+#else
+#include <util.h>
+#endif
+
+using namespace atlas;
+
+namespace {
+
+class DataObserver : public Observer<const uint8_t *, size_t> {
+ public:
+  std::string data_;
+
+ protected:
+  void OnSubjectNotify(Subject<const uint8_t *, size_t> &subject,
+                       const uint8_t *data, size_t size) override {
+    data_.append(reinterpret_cast<const char *>(data), size);
+  }
+};
+
+class SerialReactorTests : public ::testing::Test {
+ protected:
+  static const size_t kPortCount = 4;
+
+  virtual void SetUp() {
+    for (size_t i = 0; i < kPortCount; ++i) {
+      char name[100];
+      ASSERT_NE(openpty(&master_fds[i], &slave_fds[i], name, NULL, NULL), -1);
+      ports[i] = new Serial(std::string(name), 115200,
+                            Timeout::SimpleTimeout(250));
+    }
+  }
+
+  virtual void TearDown() {
+    for (size_t i = 0; i < kPortCount; ++i) {
+      delete ports[i];
+      close(slave_fds[i]);
+      if (master_fds[i] != -1) {
+        close(master_fds[i]);
+      }
+    }
+  }
+
+  Serial *ports[kPortCount];
+  int master_fds[kPortCount];
+  int slave_fds[kPortCount];
+};
+
+TEST_F(SerialReactorTests, dispatchReadEvents) {
+  SerialReactor reactor;
+  std::string received[2];
+  reactor.AddPort(*ports[0], [&](const uint8_t *data, size_t size) {
+    received[0].append(reinterpret_cast<const char *>(data), size);
+  });
+  DataObserver observer;
+  observer.Observe(reactor.AddPort(*ports[1]));
+  ASSERT_EQ(reactor.PortCount(), 2);
+  ASSERT_THROW(reactor.AddPort(*ports[0]), std::invalid_argument);
+
+  write(master_fds[0], "abc", 3);
+  write(master_fds[1], "def", 3);
+  for (int i = 0; i < 10 && (received[0].size() < 3 ||
+                             observer.data_.size() < 3); ++i) {
+    reactor.Poll(100);
+  }
+  EXPECT_EQ(received[0], std::string("abc"));
+  EXPECT_EQ(observer.data_, std::string("def"));
+
+  reactor.RemovePort(*ports[0]);
+  ASSERT_EQ(reactor.PortCount(), 1);
+  write(master_fds[0], "ghi", 3);
+  reactor.Poll(50);
+  EXPECT_EQ(received[0], std::string("abc"));
+  // The data is still there for a direct read.
+  EXPECT_EQ(ports[0]->Read(3), std::string("ghi"));
+}
+
+TEST_F(SerialReactorTests, dispatchWriteEvents) {
+  SerialReactor reactor;
+  int writable = 0;
+  reactor.AddPort(*ports[0], SerialReactor::ReadCallback(),
+                  [&] { ++writable; });
+  reactor.Poll(0);
+  EXPECT_EQ(writable, 0);
+
+  reactor.SetWriteInterest(*ports[0], true);
+  reactor.Poll(100);
+  EXPECT_EQ(writable, 1);
+
+  reactor.SetWriteInterest(*ports[0], false);
+  reactor.Poll(0);
+  EXPECT_EQ(writable, 1);
+}
+
+TEST_F(SerialReactorTests, removePortOnHangup) {
+  SerialReactor reactor;
+  bool hangup = false;
+  reactor.AddPort(*ports[0], SerialReactor::ReadCallback(),
+                  SerialReactor::WriteCallback(), [&] { hangup = true; });
+  close(master_fds[0]);
+  master_fds[0] = -1;
+  reactor.Poll(100);
+  EXPECT_TRUE(hangup);
+  EXPECT_EQ(reactor.PortCount(), 0);
+}
+
+/** \return The last epoll instance opened by the process, -1 if none. */
+int FindEpollDescriptor() {
+  int found = -1;
+  DIR *directory = opendir("/proc/self/fd");
+  if (directory == nullptr) {
+    return found;
+  }
+  while (dirent *entry = readdir(directory)) {
+    char target[64] = "";
+    std::string path = std::string("/proc/self/fd/") + entry->d_name;
+    if (readlink(path.c_str(), target, sizeof(target) - 1) > 0 &&
+        std::string(target) == "anon_inode:[eventpoll]") {
+      found = std::max(found, atoi(entry->d_name));
+    }
+  }
+  closedir(directory);
+  return found;
+}
+
+TEST_F(SerialReactorTests, epollErrorStopsTheThread) {
+  SerialReactor reactor;
+  int epoll_fd = FindEpollDescriptor();
+  ASSERT_NE(epoll_fd, -1);
+  // epoll_wait fails on a descriptor that is not an epoll instance, the
+  // reactor closes the copy when it is destroyed.
+  int null_fd = open("/dev/null", O_RDONLY);
+  ASSERT_NE(dup2(null_fd, epoll_fd), -1);
+  close(null_fd);
+
+  reactor.Start();
+  for (int i = 0; i < 100 && reactor.GetRunError().empty(); ++i) {
+    usleep(10000);
+  }
+  EXPECT_FALSE(reactor.GetRunError().empty());
+  reactor.Stop();
+}
+
+/**
+ * All the ports are served by the thread of a single reactor while one
+ * thread per device is writing fixed size messages that carry their
+ * emission time.
+ */
+TEST_F(SerialReactorTests, DISABLED_multiPortBenchmark) {
+  const size_t message_count = 2000;
+  const size_t message_size = 32;
+
+  SerialReactor reactor;
+  std::vector<std::string> pending(kPortCount);
+  std::vector<int64_t> latencies;
+  latencies.reserve(message_count * kPortCount);
+  std::atomic<size_t> received(0);
+  for (size_t i = 0; i < kPortCount; ++i) {
+    std::string &buffer = pending[i];
+    reactor.AddPort(*ports[i], [&](const uint8_t *data, size_t size) {
+      int64_t now = NanoTimer::Now();
+      buffer.append(reinterpret_cast<const char *>(data), size);
+      size_t offset = 0;
+      for (; offset + message_size <= buffer.size(); offset += message_size) {
+        int64_t sent;
+        memcpy(&sent, buffer.data() + offset, sizeof(sent));
+        latencies.push_back(now - sent);
+        ++received;
+      }
+      buffer.erase(0, offset);
+    });
+  }
+
+  NanoTimer timer;
+  timer.Start();
+  reactor.Start();
+  std::vector<std::thread> writers;
+  for (size_t i = 0; i < kPortCount; ++i) {
+    int fd = master_fds[i];
+    writers.emplace_back([fd, message_count, message_size] {
+      char message[message_size] = {};
+      for (size_t n = 0; n < message_count; ++n) {
+        int64_t now = NanoTimer::Now();
+        memcpy(message, &now, sizeof(now));
+        if (write(fd, message, message_size) != message_size) {
+          return;
+        }
+        if (n % 64 == 0) {
+          usleep(100);
+        }
+      }
+    });
+  }
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  for (int i = 0; i < 200 && received < message_count * kPortCount; ++i) {
+    usleep(10000);
+  }
+  double seconds = timer.Time<std::chrono::nanoseconds>();
+  reactor.Stop();
+
+  ASSERT_EQ(received, message_count * kPortCount);
+  std::sort(latencies.begin(), latencies.end());
+  double megabytes = static_cast<double>(received * message_size) / 1e6;
+  std::cout << "[ BENCH    ] " << kPortCount << " ports on 1 thread: "
+            << received / seconds << " msg/s, " << megabytes / seconds
+            << " MB/s" << std::endl;
+  std::cout << "[ BENCH    ] latency p50: "
+            << latencies[latencies.size() / 2] / 1e3 << " us, p99: "
+            << latencies[latencies.size() * 99 / 100] / 1e3 << " us"
+            << std::endl;
+  std::cout << "[ BENCH    ] dispatch latency: "
+            << reactor.GetDispatchLatency().Report() << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,194 @@
+/**
+ * \file	serial_recorder_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/details/deadline.h>
+#include <lib_atlas/io/serial_recorder.h>
+#include <lib_atlas/io/serial_replay.h>
+
+#if defined(OS_LINUX)
+#include <pty.h>
+#else
+#include <util.h>
+#endif
+
+using namespace atlas;
+
+namespace {
+
+class SerialRecorderTests : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    char name[100];
+    ASSERT_NE(openpty(&master_fd, &slave_fd, name, NULL, NULL), -1);
+    port = new Serial(std::string(name), 115200, Timeout::SimpleTimeout(250));
+    char path[] = "/tmp/serial_recorder_testXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    log_path = path;
+  }
+
+  virtual void TearDown() {
+    delete port;
+    close(slave_fd);
+    close(master_fd);
+    unlink(log_path.c_str());
+  }
+
+  // Write a log of line_count sentences received every period_ns.
+  void WriteLog(size_t line_count, int64_t period_ns,
+                const std::string &sentence) {
+    SerialRecorder recorder(log_path);
+    for (size_t i = 0; i < line_count; ++i) {
+      recorder.Record(direction_rx,
+                      reinterpret_cast<const uint8_t *>(sentence.data()),
+                      sentence.size(), static_cast<int64_t>(i) * period_ns);
+    }
+  }
+
+  Serial *port;
+  int master_fd;
+  int slave_fd;
+  std::string log_path;
+};
+
+TEST_F(SerialRecorderTests, recordTraffic) {
+  {
+    SerialRecorder recorder(log_path, 64);
+    recorder.Attach(*port);
+    write(master_fd, "abc\ndef\n", 8);
+    // The pseudo terminal may deliver the bytes in several times, the reads
+    // would then record several chunks.
+    Deadline deadline = Deadline::FromMilliseconds(1000);
+    while (port->Available() < 8 && !deadline.IsExpired()) {
+      usleep(1000);
+    }
+    ASSERT_EQ(port->Available(), 8);
+    EXPECT_EQ(port->ReadLine(), std::string("abc\n"));
+    EXPECT_EQ(port->ReadLine(), std::string("def\n"));
+    port->Write("ok\n");
+    // Bigger than the buffer of the recorder.
+    port->Write(std::string(100, 'x'));
+    recorder.Detach();
+    port->Write("not recorded");
+    EXPECT_EQ(recorder.GetRecordCount(), 3);
+    EXPECT_EQ(recorder.GetByteCount(), 111);
+    EXPECT_EQ(recorder.GetErrorCount(), 0);
+  }
+
+  SerialLogReader reader(log_path);
+  EXPECT_GT(reader.GetHeader().start_realtime_ns, 0);
+  SerialLogRecord record;
+  ASSERT_TRUE(reader.Next(record));
+  // Both lines were pulled from the driver in a single chunk.
+  EXPECT_EQ(record.direction, direction_rx);
+  EXPECT_EQ(std::string(reinterpret_cast<const char *>(record.data),
+                        record.size),
+            std::string("abc\ndef\n"));
+  int64_t previous = record.timestamp_ns;
+  EXPECT_GE(previous, reader.GetHeader().start_monotonic_ns);
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(record.direction, direction_tx);
+  EXPECT_EQ(record.size, 3);
+  EXPECT_GE(record.timestamp_ns, previous);
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(record.size, 100);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(record.data) % 8, 0);
+  EXPECT_FALSE(reader.Next(record));
+
+  reader.Rewind();
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(record.size, 8);
+}
+
+TEST_F(SerialRecorderTests, rejectInvalidLog) {
+  ASSERT_THROW(SerialLogReader("/nonexistent/log"), IOException);
+  FILE *file = fopen(log_path.c_str(), "w");
+  fputs("this is not a serial traffic log at all", file);
+  fclose(file);
+  ASSERT_THROW(SerialLogReader reader(log_path), CorruptedDataException);
+}
+
+TEST_F(SerialRecorderTests, replayInScaledTime) {
+  const std::string sentence("$DVL,1.0,2.0,3.0\n");
+  const int64_t period_ns = 20 * Deadline::kNanosecondsPerMillisecond;
+  WriteLog(10, period_ns, sentence);
+
+  // Twice faster, the 9 periods of the log take 90 ms.
+  SerialReplay replay(log_path, 2.0);
+  Serial replayed(replay.GetPortName(), 115200, Timeout::SimpleTimeout(500));
+  replay.Start();
+  int64_t start = Deadline::Now();
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(replayed.ReadLine(), sentence);
+  }
+  int64_t elapsed = Deadline::Now() - start;
+  EXPECT_GE(elapsed, 85 * Deadline::kNanosecondsPerMillisecond);
+  EXPECT_LT(elapsed, 300 * Deadline::kNanosecondsPerMillisecond);
+  EXPECT_TRUE(replay.WaitFinished(500));
+  EXPECT_EQ(replay.GetRecordCount(), 10);
+  EXPECT_EQ(replay.GetByteCount(), 10 * sentence.size());
+}
+
+/**
+ * A log of one hour of a 20 Hz sensor is replayed as fast as possible to a
+ * line parser reading a regular atlas::Serial.
+ */
+TEST_F(SerialRecorderTests, DISABLED_replayBenchmark) {
+  const size_t line_count = 72000;
+  const int64_t period_ns = 50 * Deadline::kNanosecondsPerMillisecond;
+  const std::string sentence(
+      "$VNYMR,+010.071,-002.363,-000.769,-00.0256,+00.4210,+00.2110*5E\r\n");
+  WriteLog(line_count, period_ns, sentence);
+
+  SerialReplay replay(log_path, SerialReplay::kAsFastAsPossible);
+  Serial replayed(replay.GetPortName(), 115200, Timeout::SimpleTimeout(500));
+  int64_t start = Deadline::Now();
+  replay.Start();
+  for (size_t i = 0; i < line_count; ++i) {
+    ASSERT_EQ(replayed.ReadLine(), sentence);
+  }
+  double seconds = static_cast<double>(Deadline::Now() - start) /
+                   Deadline::kNanosecondsPerSecond;
+  ASSERT_TRUE(replay.WaitFinished(1000));
+
+  double recorded_seconds = static_cast<double>(line_count * period_ns) /
+                            Deadline::kNanosecondsPerSecond;
+  std::cout << "[ BENCH    ] replay: " << line_count / seconds << " lines/s, "
+            << line_count * sentence.size() / seconds / 1e6 << " MB/s, "
+            << recorded_seconds / seconds << " times real time" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -33,10 +33,17 @@
  * This provides a cross platform interface for interacting with Serial Ports.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <new>
 #include <string>
+#include <thread>
+#include <fstream>
 #include "gtest/gtest.h"
 #include <boost/bind.hpp>
+#include <lib_atlas/io/details/deadline.h>
 #include <lib_atlas/io/serial.h>
+#include <lib_atlas/sys/timer.h>
 
 #if defined(OS_LINUX)
 #include <pty.h>
@@ -46,8 +53,108 @@
 
 using namespace atlas;
 
+// Count the heap allocations of the process to check that the read paths
+// do not allocate. Every form of the global allocation functions is
+// replaced so they all go through malloc and free.
+std::atomic<size_t> g_allocation_count(0);
+
+// Not inlined, GCC would otherwise see a free of memory that it knows comes
+// from operator new and warn about a mismatch.
+__attribute__((__noinline__)) static void Deallocate(void *p) { free(p); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  ++g_allocation_count;
+  return malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return operator new(size, std::nothrow);
+}
+
+void *operator new(std::size_t size) {
+  void *p = operator new(size, std::nothrow);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void *p) noexcept { Deallocate(p); }
+
+void operator delete[](void *p) noexcept { Deallocate(p); }
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+  Deallocate(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+  Deallocate(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept { Deallocate(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { Deallocate(p); }
+
 namespace {
 
+// Number of read system calls done by the process so far, as reported by
+// /proc/self/io. Returns 0 if the information is not available.
+uint64_t ReadSyscallCount() {
+  std::ifstream io("/proc/self/io");
+  std::string key;
+  uint64_t value = 0;
+  while (io >> key >> value) {
+    if (key == "syscr:") {
+      return value;
+    }
+  }
+  return 0;
+}
+
+// Number of write system calls done by the process so far.
+uint64_t WriteSyscallCount() {
+  std::ifstream io("/proc/self/io");
+  std::string key;
+  uint64_t value = 0;
+  while (io >> key >> value) {
+    if (key == "syscw:") {
+      return value;
+    }
+  }
+  return 0;
+}
+
+// Read size bytes from the master side of the pty from another thread.
+std::thread ReadInBackground(int fd, size_t size, std::string &data) {
+  return std::thread([fd, size, &data] {
+    char buffer[4096];
+    while (data.size() < size) {
+      ssize_t n = read(fd, buffer, sizeof(buffer));
+      if (n <= 0) {
+        return;
+      }
+      data.append(buffer, n);
+    }
+  });
+}
+
+// Write the given data to the master side of the pty from another thread,
+// the pty buffer being too small to hold a whole benchmark run.
+std::thread WriteInBackground(int fd, const std::string &data) {
+  return std::thread([fd, data] {
+    size_t written = 0;
+    while (written < data.size()) {
+      ssize_t n = write(fd, data.data() + written, data.size() - written);
+      if (n <= 0) {
+        return;
+      }
+      written += n;
+    }
+  });
+}
+
 class SerialTests : public ::testing::Test {
 protected:
   virtual void SetUp() {
@@ -112,6 +219,575 @@ TEST_F(SerialTests, partialRead) {
   EXPECT_EQ(r, std::string("abc\n"));
 }
 
+TEST_F(SerialTests, readLineKeepsLeftover) {
+  write(master_fd, "abc\ndef\ngh", 10);
+
+  EXPECT_EQ(port1->ReadLine(), std::string("abc\n"));
+  EXPECT_EQ(port1->ReadLine(), std::string("def\n"));
+
+  // The bytes received after the last EOL are still served by Read.
+  write(master_fd, "i", 1);
+  EXPECT_EQ(port1->Read(3), std::string("ghi"));
+}
+
+TEST_F(SerialTests, readLineMultiByteEol) {
+  write(master_fd, "abc\r", 4);
+  std::thread writer([this] {
+    usleep(20000);
+    write(master_fd, "\ndef\r\n", 6);
+  });
+  EXPECT_EQ(port1->ReadLine(65536, "\r\n"), std::string("abc\r\n"));
+  EXPECT_EQ(port1->ReadLine(65536, "\r\n"), std::string("def\r\n"));
+  writer.join();
+}
+
+TEST_F(SerialTests, readLineMaxLength) {
+  write(master_fd, "abcdef\n", 7);
+  EXPECT_EQ(port1->ReadLine(4), std::string("abcd"));
+  EXPECT_EQ(port1->ReadLine(), std::string("ef\n"));
+}
+
+TEST_F(SerialTests, readLineTimeout) {
+  write(master_fd, "abc", 3);
+  EXPECT_EQ(port1->ReadLine(), std::string("abc"));
+  EXPECT_EQ(port1->ReadLine(), std::string(""));
+}
+
+TEST_F(SerialTests, readLinesWorks) {
+  write(master_fd, "abc\ndef\ngh", 10);
+  std::vector<std::string> lines = port1->ReadLines();
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_EQ(lines[0], std::string("abc\n"));
+  EXPECT_EQ(lines[1], std::string("def\n"));
+  EXPECT_EQ(lines[2], std::string("gh"));
+}
+
+TEST_F(SerialTests, readSomeWorks) {
+  uint8_t buf[16];
+  // Nothing to read, returns after the timeout.
+  EXPECT_EQ(port1->ReadSome(buf, sizeof(buf), 10), 0);
+
+  write(master_fd, "abc\n", 4);
+  size_t bytes_read = port1->ReadSome(buf, sizeof(buf), 250);
+  EXPECT_EQ(std::string(reinterpret_cast<char *>(buf), bytes_read),
+            std::string("abc\n"));
+
+  // Returns what is there without waiting for the requested size.
+  std::thread writer([this] {
+    usleep(20000);
+    write(master_fd, "de", 2);
+  });
+  bytes_read = port1->ReadSome(buf, sizeof(buf), 250);
+  writer.join();
+  EXPECT_EQ(std::string(reinterpret_cast<char *>(buf), bytes_read),
+            std::string("de"));
+}
+
+TEST_F(SerialTests, readAppendsToContainers) {
+  std::vector<uint8_t> vector_buffer = {'x'};
+  write(master_fd, "abc\n", 4);
+  EXPECT_EQ(port1->Read(vector_buffer, 4), 4);
+  EXPECT_EQ(std::string(vector_buffer.begin(), vector_buffer.end()),
+            std::string("xabc\n"));
+
+  std::string string_buffer = "x";
+  write(master_fd, "ab", 2);
+  // Partial read, the string is shrinked to what was received.
+  EXPECT_EQ(port1->Read(string_buffer, 4), 2);
+  EXPECT_EQ(string_buffer, std::string("xab"));
+}
+
+TEST_F(SerialTests, readDoesNotAllocate) {
+  std::vector<uint8_t> vector_buffer;
+  vector_buffer.reserve(64);
+  std::string string_buffer;
+  string_buffer.reserve(64);
+  uint8_t raw_buffer[64];
+
+  for (int i = 0; i < 100; ++i) {
+    write(master_fd, "abcdefgh", 8);
+    write(master_fd, "abcdefgh", 8);
+    write(master_fd, "abcdefgh", 8);
+    vector_buffer.clear();
+    string_buffer.clear();
+
+    size_t allocations = g_allocation_count;
+    ASSERT_EQ(port1->Read(vector_buffer, 8), 8);
+    ASSERT_EQ(port1->Read(string_buffer, 8), 8);
+    ASSERT_EQ(port1->ReadSome(raw_buffer, sizeof(raw_buffer), 100), 8);
+    ASSERT_EQ(g_allocation_count, allocations);
+  }
+}
+
+/**
+ * Compare the buffered ReadLine against the previous strategy of reading the
+ * port one byte at a time, with a stream of IMU-like ASCII sentences.
+ */
+TEST_F(SerialTests, DISABLED_readLineBenchmark) {
+  const size_t line_count = 2000;
+  const std::string sentence =
+      "$VNYMR,+010.071,-002.363,-000.769,-00.0256,+00.4210,+00.2110*5E\r\n";
+  std::string stream;
+  for (size_t i = 0; i < line_count; ++i) {
+    stream += sentence;
+  }
+
+  // Baseline: one Read per byte, as ReadLine used to do.
+  std::thread writer = WriteInBackground(master_fd, stream);
+  uint64_t syscalls = ReadSyscallCount();
+  atlas::NanoTimer timer;
+  timer.Start();
+  for (size_t i = 0; i < line_count; ++i) {
+    std::string line;
+    uint8_t c = 0;
+    while (c != '\n' && port1->Read(&c, 1) == 1) {
+      line += static_cast<char>(c);
+    }
+    ASSERT_EQ(line, sentence);
+  }
+  double baseline_seconds = timer.Time<std::chrono::nanoseconds>();
+  uint64_t baseline_syscalls = ReadSyscallCount() - syscalls;
+  writer.join();
+
+  writer = WriteInBackground(master_fd, stream);
+  syscalls = ReadSyscallCount();
+  timer.Start();
+  for (size_t i = 0; i < line_count; ++i) {
+    ASSERT_EQ(port1->ReadLine(), sentence);
+  }
+  double buffered_seconds = timer.Time<std::chrono::nanoseconds>();
+  uint64_t buffered_syscalls = ReadSyscallCount() - syscalls;
+  writer.join();
+
+  std::cout << "[ BENCH    ] per byte: "
+            << static_cast<double>(baseline_syscalls) / line_count
+            << " read syscalls/line, " << line_count / baseline_seconds
+            << " lines/s" << std::endl;
+  std::cout << "[ BENCH    ] buffered: "
+            << static_cast<double>(buffered_syscalls) / line_count
+            << " read syscalls/line, " << line_count / buffered_seconds
+            << " lines/s" << std::endl;
+  if (baseline_syscalls != 0) {
+    EXPECT_LT(buffered_syscalls, baseline_syscalls);
+  }
+}
+
+/**
+ * A device answers each one byte request with a 16 bytes response, the
+ * first byte of which comes a bit before the others, like on a real line.
+ */
+TEST_F(SerialTests, DISABLED_latencyProfileBenchmark) {
+  const int iterations = 200;
+  const size_t response_size = 16;
+  std::thread device([this, response_size] {
+    uint8_t request = 0;
+    std::vector<uint8_t> response(response_size, 'r');
+    while (read(master_fd, &request, 1) == 1 && request != 'q') {
+      write(master_fd, response.data(), 1);
+      usleep(200);
+      write(master_fd, response.data() + 1, response_size - 1);
+    }
+  });
+
+  ASSERT_EQ(port1->GetLatency(), latency_default);
+  const latency_t profiles[] = {latency_default, latency_low};
+  const char *names[] = {"default", "low"};
+  int64_t medians[2];
+  for (int p = 0; p < 2; ++p) {
+    port1->SetLatency(profiles[p]);
+    ASSERT_EQ(port1->GetLatency(), profiles[p]);
+    LatencyHistogram round_trips;
+    uint8_t response[response_size];
+    for (int i = 0; i < iterations; ++i) {
+      int64_t start = Deadline::Now();
+      ASSERT_EQ(port1->Write(std::string("?")), 1);
+      ASSERT_EQ(port1->Read(response, response_size), response_size);
+      round_trips.Record(Deadline::Now() - start);
+    }
+    medians[p] = round_trips.Percentile(50);
+    std::cout << "[ BENCH    ] " << names[p]
+              << " latency round trip: " << round_trips.Report() << std::endl;
+  }
+  port1->Write(std::string("q"));
+  device.join();
+  // The default profile sleeps for the 15 byte times at 115200 bauds.
+  EXPECT_LT(medians[1], medians[0]);
+}
+
+TEST_F(SerialTests, tryApiReportsErrors) {
+  write(master_fd, "abc", 3);
+  uint8_t buffer[8];
+  EXPECT_EQ(port1->TryWaitReadable().status, status_ok);
+  // The pseudo terminal may deliver the bytes in several times.
+  IOResult result = port1->TryAvailable();
+  Deadline deadline = Deadline::FromMilliseconds(1000);
+  while (result.status == status_ok && result.bytes < 3 &&
+         !deadline.IsExpired()) {
+    usleep(1000);
+    result = port1->TryAvailable();
+  }
+  EXPECT_EQ(result.status, status_ok);
+  EXPECT_EQ(result.bytes, 3);
+  result = port1->TryRead(buffer, 3);
+  EXPECT_EQ(result.status, status_ok);
+  EXPECT_EQ(result.bytes, 3);
+  EXPECT_EQ(std::string(reinterpret_cast<char *>(buffer), 3), "abc");
+
+  port1->SetTimeout(Timeout::SimpleTimeout(10));
+  write(master_fd, "d", 1);
+  result = port1->TryRead(buffer, 2);
+  EXPECT_EQ(result.status, status_timeout);
+  EXPECT_EQ(result.bytes, 1);
+  EXPECT_EQ(port1->TryWaitReadable().status, status_timeout);
+
+  result = port1->TryWrite(reinterpret_cast<const uint8_t *>("ef"), 2);
+  EXPECT_EQ(result.status, status_ok);
+  EXPECT_EQ(result.bytes, 2);
+
+  // The pseudo terminal hangs up when its master is closed.
+  close(master_fd);
+  result = port1->TryRead(buffer, 1);
+  EXPECT_EQ(result.status, status_disconnected);
+  EXPECT_EQ(result.bytes, 0);
+  EXPECT_THROW(port1->Read(buffer, 1), SerialException);
+
+  port1->Close();
+  EXPECT_EQ(port1->TryRead(buffer, 1).status, status_not_open);
+  EXPECT_EQ(port1->TryWrite(buffer, 1).status, status_not_open);
+  EXPECT_EQ(port1->TryAvailable().status, status_not_open);
+  EXPECT_EQ(port1->TryWaitReadable().status, status_not_open);
+  EXPECT_THROW(port1->Read(buffer, 1), PortNotOpenedException);
+}
+
+/**
+ * The cost of a call that fails, with and without exceptions.
+ */
+TEST_F(SerialTests, DISABLED_tryApiBenchmark) {
+  const int iterations = 2000;
+  uint8_t buffer[8];
+  port1->SetTimeout(Timeout::SimpleTimeout(0));
+  int64_t start = Deadline::Now();
+  for (int i = 0; i < iterations; ++i) {
+    ASSERT_EQ(port1->Read(buffer, sizeof(buffer)), 0);
+  }
+  double throwing_timeout = (Deadline::Now() - start) /
+      static_cast<double>(iterations);
+  start = Deadline::Now();
+  for (int i = 0; i < iterations; ++i) {
+    ASSERT_EQ(port1->TryRead(buffer, sizeof(buffer)).status, status_timeout);
+  }
+  double try_timeout = (Deadline::Now() - start) /
+      static_cast<double>(iterations);
+
+  close(master_fd);
+  port1->SetTimeout(Timeout::SimpleTimeout(250));
+  start = Deadline::Now();
+  for (int i = 0; i < iterations; ++i) {
+    try {
+      port1->Read(buffer, sizeof(buffer));
+      FAIL();
+    } catch (const SerialException &) {
+    }
+  }
+  double throwing_error = (Deadline::Now() - start) /
+      static_cast<double>(iterations);
+  start = Deadline::Now();
+  for (int i = 0; i < iterations; ++i) {
+    ASSERT_EQ(port1->TryRead(buffer, sizeof(buffer)).status,
+              status_disconnected);
+  }
+  double try_error = (Deadline::Now() - start) /
+      static_cast<double>(iterations);
+
+  std::cout << "[ BENCH    ] timeout: Read " << throwing_timeout
+            << " ns/call, TryRead " << try_timeout << " ns/call" << std::endl;
+  std::cout << "[ BENCH    ] disconnected: Read " << throwing_error
+            << " ns/call, TryRead " << try_error << " ns/call" << std::endl;
+  EXPECT_LT(try_error, throwing_error);
+}
+
+TEST(DeadlineTest, remainingTime) {
+  Deadline deadline = Deadline::FromMilliseconds(50);
+  int64_t remaining = deadline.RemainingNs();
+  EXPECT_GT(remaining, 40 * Deadline::kNanosecondsPerMillisecond);
+  EXPECT_LE(remaining, 50 * Deadline::kNanosecondsPerMillisecond);
+  EXPECT_FALSE(deadline.IsExpired());
+  EXPECT_TRUE(Deadline(-1).IsExpired());
+  EXPECT_EQ(Deadline(-1).RemainingNs(), 0);
+
+  timespec time = Deadline::ToTimeSpec(2500000001);
+  EXPECT_EQ(time.tv_sec, 2);
+  EXPECT_EQ(time.tv_nsec, 500000001);
+}
+
+/**
+ * Read on a silent port so every call ends with its timeout, and measure by
+ * how much the timeout is overshot.
+ */
+TEST_F(SerialTests, timeoutAccuracy) {
+  const int iterations = 100;
+  const uint32_t timeout_ms = 5;
+  const int64_t timeout_ns = timeout_ms * Deadline::kNanosecondsPerMillisecond;
+  port1->SetTimeout(Timeout::SimpleTimeout(timeout_ms));
+  std::vector<int64_t> read_overshoots;
+  std::vector<int64_t> read_some_overshoots;
+  uint8_t buffer[16];
+  for (int i = 0; i < iterations; ++i) {
+    int64_t start = Deadline::Now();
+    ASSERT_EQ(port1->Read(buffer, sizeof(buffer)), 0);
+    int64_t elapsed = Deadline::Now() - start;
+    // The timeout must never expire early.
+    ASSERT_GE(elapsed, timeout_ns);
+    read_overshoots.push_back(elapsed - timeout_ns);
+
+    start = Deadline::Now();
+    ASSERT_EQ(port1->ReadSome(buffer, sizeof(buffer), timeout_ms), 0);
+    elapsed = Deadline::Now() - start;
+    ASSERT_GE(elapsed, timeout_ns);
+    read_some_overshoots.push_back(elapsed - timeout_ns);
+  }
+  std::sort(read_overshoots.begin(), read_overshoots.end());
+  std::sort(read_some_overshoots.begin(), read_some_overshoots.end());
+  std::cout << "[ BENCH    ] Read " << timeout_ms
+            << " ms timeout overshoot: p50 "
+            << read_overshoots[iterations / 2] / 1e3 << " us, p99 "
+            << read_overshoots[iterations * 99 / 100] / 1e3 << " us"
+            << std::endl;
+  std::cout << "[ BENCH    ] ReadSome " << timeout_ms
+            << " ms timeout overshoot: p50 "
+            << read_some_overshoots[iterations / 2] / 1e3 << " us, p99 "
+            << read_some_overshoots[iterations * 99 / 100] / 1e3 << " us"
+            << std::endl;
+}
+
+TEST_F(SerialTests, readTimestamps) {
+  write(master_fd, "a\n", 2);
+  ASSERT_EQ(port1->ReadLine(), std::string("a\n"));
+  EXPECT_EQ(port1->GetLastReadTimestamp(), 0);
+
+  port1->SetTimestamping(true);
+  ASSERT_TRUE(port1->IsTimestamping());
+  const int64_t gap_ns = 20 * Deadline::kNanosecondsPerMillisecond;
+  std::atomic<int64_t> sent(0);
+  std::thread writer([&] {
+    usleep(10000);
+    sent = Deadline::Now();
+    write(master_fd, "bc", 2);
+    usleep(20000);
+    write(master_fd, "d\ne\n", 4);
+  });
+  // The line is stamped with the arrival of its first byte, not the last.
+  ASSERT_EQ(port1->ReadLine(), std::string("bcd\n"));
+  int64_t returned = Deadline::Now();
+  writer.join();
+  int64_t timestamp = port1->GetLastReadTimestamp();
+  EXPECT_GE(timestamp, sent);
+  EXPECT_LT(timestamp - sent, gap_ns / 4);
+  EXPECT_GE(returned - timestamp, gap_ns * 3 / 4);
+
+  // The leftover keeps the time of the chunk it came with.
+  uint8_t buffer[2];
+  ASSERT_EQ(port1->Read(buffer, 2), 2);
+  int64_t second_chunk = port1->GetLastReadTimestamp();
+  EXPECT_GT(second_chunk, timestamp);
+  EXPECT_LT(second_chunk, returned);
+
+  // Data already there are stamped when they are read.
+  write(master_fd, "f", 1);
+  usleep(1000);
+  int64_t before = Deadline::Now();
+  ASSERT_EQ(port1->ReadSome(buffer, 1, 100), 1);
+  EXPECT_GE(port1->GetLastReadTimestamp(), before);
+
+  EXPECT_EQ(port1->GetReadLatency().Count(), 3);
+  std::cout << "[ BENCH    ] read latency: "
+            << port1->GetReadLatency().Report() << std::endl;
+  ASSERT_EQ(port1->ReadSome(buffer, 1, 0), 0);
+  EXPECT_EQ(port1->GetLastReadTimestamp(), 0);
+}
+
+TEST_F(SerialTests, writesDoNotStampReads) {
+  port1->SetTimestamping(true);
+  std::atomic<bool> stop(false);
+  // The writes wait for the port with the same poll as the reads.
+  std::thread writer([&] {
+    while (!stop) {
+      port1->Write("x");
+      usleep(100);
+    }
+  });
+  std::thread drainer([&] {
+    char buffer[64];
+    while (!stop) {
+      read(master_fd, buffer, sizeof(buffer));
+    }
+  });
+  for (int i = 0; i < 5; ++i) {
+    // The read waits for the data.
+    std::atomic<int64_t> sent(0);
+    std::thread sender([&] {
+      usleep(10000);
+      sent = Deadline::Now();
+      write(master_fd, "ab\n", 3);
+    });
+    std::string line = port1->Read(3);
+    int64_t returned = Deadline::Now();
+    sender.join();
+    ASSERT_EQ(line, std::string("ab\n"));
+    int64_t timestamp = port1->GetLastReadTimestamp();
+    EXPECT_GE(timestamp, sent);
+    EXPECT_LE(timestamp, returned);
+  }
+  stop = true;
+  writer.join();
+  // The writer is stopped, this unblocks the drainer.
+  write(slave_fd, "x", 1);
+  drainer.join();
+}
+
+TEST_F(SerialTests, writeAsyncWorks) {
+  ASSERT_THROW(port1->WriteAsync("abc"), std::logic_error);
+  port1->EnableAsyncWrite(16);
+  ASSERT_TRUE(port1->IsAsyncWriteEnabled());
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    std::string command = "cmd" + std::to_string(i) + "\n";
+    ASSERT_TRUE(port1->WriteAsync(command));
+    expected += command;
+  }
+  std::string received;
+  std::thread reader = ReadInBackground(master_fd, expected.size(), received);
+  EXPECT_TRUE(port1->WaitAsyncWrite(1000));
+  reader.join();
+  EXPECT_EQ(received, expected);
+  EXPECT_EQ(port1->GetAsyncQueueDepth(), 0);
+  EXPECT_EQ(port1->GetAsyncDropCount(), 0);
+  EXPECT_EQ(port1->GetAsyncErrorCount(), 0);
+  // The buffers are gathered, there is less calls than buffers.
+  EXPECT_LT(port1->GetAsyncWriteCallCount(), 100);
+  port1->DisableAsyncWrite();
+  EXPECT_FALSE(port1->IsAsyncWriteEnabled());
+}
+
+TEST_F(SerialTests, replaceTrafficCallbackWhileWriting) {
+  std::atomic<size_t> tapped(0);
+  std::atomic<bool> done(false);
+  std::thread writer([this, &done] {
+    for (int i = 0; i < 1000; ++i) {
+      port1->Write("ab");
+    }
+    done = true;
+  });
+  std::string received;
+  std::thread reader = ReadInBackground(master_fd, 2000, received);
+  while (!done) {
+    port1->SetTrafficCallback(
+        [&tapped](direction_t, const uint8_t *, size_t size) {
+          tapped += size;
+        });
+    port1->SetTrafficCallback(Serial::TrafficCallback());
+  }
+  writer.join();
+  reader.join();
+  EXPECT_EQ(received.size(), 2000);
+  EXPECT_LE(tapped, 2000);
+}
+
+TEST_F(SerialTests, writeAsyncReusesBuffers) {
+  const uint8_t command[] = "$THR,+0.125\n";
+  uint8_t received[64];
+  port1->EnableAsyncWrite(16);
+  // The first write allocates the buffer that the next ones reuse.
+  ASSERT_TRUE(port1->WriteAsync(command, sizeof(command)));
+  ASSERT_TRUE(port1->WaitAsyncWrite(1000));
+  ASSERT_EQ(read(master_fd, received, sizeof(received)), sizeof(command));
+  for (int i = 0; i < 100; ++i) {
+    size_t allocations = g_allocation_count;
+    ASSERT_TRUE(port1->WriteAsync(command, sizeof(command)));
+    ASSERT_TRUE(port1->WaitAsyncWrite(1000));
+    ASSERT_EQ(g_allocation_count, allocations);
+    ASSERT_EQ(read(master_fd, received, sizeof(received)), sizeof(command));
+  }
+  port1->DisableAsyncWrite();
+}
+
+TEST_F(SerialTests, writeAsyncPolicies) {
+  // The pty is not read, so a large buffer keeps the writer busy until
+  // the write timeout expires, the other buffers stay in the queue.
+  const std::string stall(1 << 20, 'x');
+  for (QueuePolicy policy : {QueuePolicy::FAIL, QueuePolicy::DROP_OLDEST}) {
+    port1->EnableAsyncWrite(4, policy);
+    ASSERT_TRUE(port1->WriteAsync(stall));
+    for (int i = 0; i < 100 && port1->GetAsyncQueueDepth() != 0; ++i) {
+      usleep(1000);
+    }
+    for (int i = 0; i < 4; ++i) {
+      ASSERT_TRUE(port1->WriteAsync(std::to_string(i)));
+    }
+    EXPECT_EQ(port1->GetAsyncQueueDepth(), 4);
+    EXPECT_EQ(port1->WriteAsync("4"), policy != QueuePolicy::FAIL);
+    EXPECT_EQ(port1->GetAsyncDropCount(), 1);
+    EXPECT_EQ(port1->GetAsyncQueueDepth(), 4);
+    EXPECT_TRUE(port1->WaitAsyncWrite(2000));
+    EXPECT_GE(port1->GetAsyncErrorCount(), 1);
+
+    // Only the end of the stall buffer went out, then the small ones.
+    tcflush(master_fd, TCIFLUSH);
+    port1->DisableAsyncWrite();
+  }
+}
+
+/**
+ * Many small commands sent by a control loop, either with the blocking Write
+ * or queued with WriteAsync. The time spent by the caller and the number of
+ * write system calls are compared.
+ */
+TEST_F(SerialTests, DISABLED_writeAsyncBenchmark) {
+  const size_t command_count = 20000;
+  const std::string command("$THR,+0.125,-0.250\n");
+  std::vector<int64_t> latencies(command_count);
+
+  std::string received;
+  std::thread reader =
+      ReadInBackground(master_fd, command_count * command.size(), received);
+  uint64_t syscalls = WriteSyscallCount();
+  for (size_t i = 0; i < command_count; ++i) {
+    int64_t start = NanoTimer::Now();
+    port1->Write(command);
+    latencies[i] = NanoTimer::Now() - start;
+  }
+  uint64_t sync_syscalls = WriteSyscallCount() - syscalls;
+  reader.join();
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "[ BENCH    ] Write: p50 " << latencies[command_count / 2]
+            << " ns, p99 " << latencies[command_count * 99 / 100]
+            << " ns per call, "
+            << static_cast<double>(sync_syscalls) / command_count
+            << " syscalls/command" << std::endl;
+
+  received.clear();
+  reader =
+      ReadInBackground(master_fd, command_count * command.size(), received);
+  port1->EnableAsyncWrite(1024, QueuePolicy::BLOCK);
+  syscalls = WriteSyscallCount();
+  for (size_t i = 0; i < command_count; ++i) {
+    int64_t start = NanoTimer::Now();
+    port1->WriteAsync(command);
+    latencies[i] = NanoTimer::Now() - start;
+  }
+  ASSERT_TRUE(port1->WaitAsyncWrite(5000));
+  uint64_t async_syscalls = WriteSyscallCount() - syscalls;
+  reader.join();
+  ASSERT_EQ(received.size(), command_count * command.size());
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "[ BENCH    ] WriteAsync: p50 " << latencies[command_count / 2]
+            << " ns, p99 " << latencies[command_count * 99 / 100]
+            << " ns per call, "
+            << static_cast<double>(async_syscalls) / command_count
+            << " syscalls/command, drops " << port1->GetAsyncDropCount()
+            << std::endl;
+}
+
 }  // namespace
 
 int main(int argc, char **argv) {
@@ -0,0 +1,230 @@
+/**
+ * \file	thread_pool_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/io/details/deadline.h>
+#include <lib_atlas/pattern/thread_pool.h>
+
+using namespace atlas;
+
+namespace {
+
+/** Spins until the counter reaches a value, the tasks cannot be joined. */
+void WaitFor(const std::atomic<int> &counter, int value) {
+  const int64_t deadline_ns = Deadline::Now() + 10000000000LL;
+  while (counter < value && Deadline::Now() < deadline_ns) {
+    std::this_thread::yield();
+  }
+}
+
+TEST(ThreadPoolTest, futuresGetTheResults) {
+  ThreadPool pool(2);
+  EXPECT_EQ(pool.ThreadCount(), 2);
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(
+        pool.Enqueue([](int value) { return value * value; }, i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(results[i].get(), i * i);
+  }
+  std::future<void> failed =
+      pool.Enqueue([] { throw std::runtime_error("failed"); });
+  EXPECT_THROW(failed.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, tasksEnqueueTasks) {
+  ThreadPool pool(3);
+  std::atomic<int> count(0);
+  for (int i = 0; i < 10; ++i) {
+    pool.Enqueue([&pool, &count] {
+      for (int j = 0; j < 100; ++j) {
+        pool.Enqueue([&count] { ++count; });
+      }
+      ++count;
+    });
+  }
+  WaitFor(count, 1010);
+  EXPECT_EQ(count, 1010);
+}
+
+TEST(ThreadPoolTest, manyProducers) {
+  // More tasks than the shared queue holds, some go to the overflow queue.
+  const int producer_count = 4;
+  const int task_count = 5000;
+  std::atomic<int> count(0);
+  std::atomic<long long> sum(0);
+  {
+    ThreadPool pool(2);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producer_count; ++p) {
+      producers.emplace_back([&, p] {
+        for (int i = p; i < task_count * producer_count; i += producer_count) {
+          pool.Enqueue([&sum, &count, i] {
+            sum += i;
+            ++count;
+          });
+        }
+      });
+    }
+    for (std::thread &producer : producers) {
+      producer.join();
+    }
+  }
+  // The destruction runs the pending tasks.
+  const long long total = static_cast<long long>(task_count) * producer_count;
+  EXPECT_EQ(count, total);
+  EXPECT_EQ(sum, total * (total - 1) / 2);
+}
+
+/** The previous pool, a single queue behind a mutex, as a reference. */
+class LockedThreadPool {
+ public:
+  explicit LockedThreadPool(size_t thread_count) : is_stoped_(false) {
+    for (size_t i = 0; i < thread_count; ++i) {
+      workers_.emplace_back([this] {
+        for (;;) {
+          std::function<void()> task;
+          {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock,
+                            [this] { return is_stoped_ || !tasks_.empty(); });
+            if (is_stoped_ && tasks_.empty()) {
+              return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+          }
+          task();
+        }
+      });
+    }
+  }
+
+  ~LockedThreadPool() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      is_stoped_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  std::future<void> Enqueue(std::function<void()> function) {
+    auto task = std::make_shared<std::packaged_task<void()>>(function);
+    std::future<void> result = task->get_future();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      tasks_.emplace([task] { (*task)(); });
+    }
+    condition_.notify_one();
+    return result;
+  }
+
+ private:
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool is_stoped_;
+};
+
+/** Burns about the given number of nanoseconds of CPU. */
+void Work(int64_t duration_ns) {
+  const int64_t end_ns = Deadline::Now() + duration_ns;
+  while (Deadline::Now() < end_ns) {
+  }
+}
+
+/**
+ * Runs tasks that each enqueue a batch of tasks, as a vision task would for
+ * its blobs, and measures the tasks run per second.
+ */
+template <typename Pool_>
+double RunTasks(size_t thread_count, int64_t task_ns, int task_count) {
+  const int batch_size = 100;
+  std::atomic<int> count(0);
+  int64_t start_ns = Deadline::Now();
+  {
+    Pool_ pool(thread_count);
+    for (int i = 0; i < task_count / batch_size; ++i) {
+      pool.Enqueue([&pool, &count, task_ns] {
+        for (int j = 1; j < batch_size; ++j) {
+          pool.Enqueue([&count, task_ns] {
+            Work(task_ns);
+            ++count;
+          });
+        }
+        Work(task_ns);
+        ++count;
+      });
+    }
+    WaitFor(count, task_count);
+  }
+  EXPECT_EQ(count, task_count);
+  return task_count / (static_cast<double>(Deadline::Now() - start_ns) /
+                       Deadline::kNanosecondsPerSecond);
+}
+
+TEST(ThreadPoolTest, DISABLED_scalabilityBenchmark) {
+  const size_t max_thread_count =
+      std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  std::vector<size_t> thread_counts;
+  for (size_t threads = 1; threads < max_thread_count; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  thread_counts.push_back(max_thread_count);
+  for (size_t threads : thread_counts) {
+    for (int64_t task_ns : {int64_t(0), int64_t(20000)}) {
+      const int task_count = task_ns == 0 ? 200000 : 20000;
+      double locked = RunTasks<LockedThreadPool>(threads, task_ns, task_count);
+      double stealing = RunTasks<ThreadPool>(threads, task_ns, task_count);
+      std::cout << "[ BENCH    ] " << threads << " threads, "
+                << (task_ns == 0 ? "tiny" : "20 us") << " tasks: locked "
+                << locked << " tasks/s, work stealing " << stealing
+                << " tasks/s" << std::endl;
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
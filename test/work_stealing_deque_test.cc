@@ -0,0 +1,110 @@
+/**
+ * \file	work_stealing_deque_test.cc
+ * \author	Thibaut Mattio <thibaut.mattio@gmail.com>
+ * \date	16/10/2026
+ *
+ * \copyright Copyright (c) 2026 S.O.N.I.A. All rights reserved.
+ *
+ * \section LICENSE
+ *
+ * This file is part of S.O.N.I.A. software.
+ *
+ * S.O.N.I.A. software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * S.O.N.I.A. software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with S.O.N.I.A. software. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include <lib_atlas/pattern/work_stealing_deque.h>
+
+using namespace atlas;
+
+namespace {
+
+TEST(WorkStealingDequeTest, ownerIsLifoAndThievesAreFifo) {
+  WorkStealingDeque<int> deque(3);
+  ASSERT_TRUE(deque.IsEmpty());
+  // Past the initial capacity, the deque grows.
+  for (int i = 0; i < 10; ++i) {
+    deque.Push(i);
+  }
+  ASSERT_EQ(deque.Size(), 10);
+  int element = -1;
+  ASSERT_TRUE(deque.Pop(element));
+  EXPECT_EQ(element, 9);
+  ASSERT_TRUE(deque.Steal(element));
+  EXPECT_EQ(element, 0);
+  for (int i = 8; i > 0; --i) {
+    ASSERT_TRUE(deque.Pop(element));
+    EXPECT_EQ(element, i);
+  }
+  ASSERT_FALSE(deque.Pop(element));
+  ASSERT_FALSE(deque.Steal(element));
+  ASSERT_TRUE(deque.IsEmpty());
+  ASSERT_THROW(WorkStealingDeque<int>(0), std::invalid_argument);
+}
+
+TEST(WorkStealingDequeTest, eachElementIsTakenOnce) {
+  const int thief_count = 3;
+  const int element_count = 200000;
+  WorkStealingDeque<int> deque(16);
+  std::vector<std::atomic<int>> taken(element_count);
+  for (std::atomic<int> &count : taken) {
+    count = 0;
+  }
+  std::atomic<int> taken_count(0);
+
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < thief_count; ++t) {
+    thieves.emplace_back([&] {
+      int element;
+      while (taken_count < element_count) {
+        if (deque.Steal(element)) {
+          ++taken[element];
+          ++taken_count;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  // The owner pushes in bursts and pops some back, as a worker would.
+  int element;
+  for (int i = 0; i < element_count; ++i) {
+    deque.Push(i);
+    if (i % 3 == 0 && deque.Pop(element)) {
+      ++taken[element];
+      ++taken_count;
+    }
+  }
+  while (deque.Pop(element)) {
+    ++taken[element];
+    ++taken_count;
+  }
+  for (std::thread &thief : thieves) {
+    thief.join();
+  }
+  EXPECT_EQ(taken_count, element_count);
+  for (int i = 0; i < element_count; ++i) {
+    ASSERT_EQ(taken[i], 1) << i;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}